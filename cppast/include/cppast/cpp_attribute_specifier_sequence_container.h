@@ -18,6 +18,9 @@ using CppAttributeSpecifierSequence = std::vector<std::unique_ptr<CppExpression>
 /**
  * @brief A mixin class to allow objects to have attribute specifier sequence
  * as described at https://en.cppreference.com/w/cpp/language/attributes.
+ *
+ * Most objects have no attribute, so, the sequence is allocated only when there is one and costs just a pointer
+ * otherwise.
  */
 class CppAttributeSpecifierSequenceContainer
 {
@@ -60,7 +63,7 @@ public:
   bool visit(const std::function<bool(CppExpression& attributeSpecifier)>& callback);
 
 private:
-  CppAttributeSpecifierSequence attribSpecifierSequence_;
+  std::unique_ptr<CppAttributeSpecifierSequence> attribSpecifierSequence_;
 };
 
 } // namespace cppast
@@ -0,0 +1,43 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Compact binary serialization of AST that lets a parsed tree be stored and loaded without parsing again.
+ */
+
+#ifndef F1FB33A4_32C3_4BE9_9CA4_4CC9EE9C11B6
+#define F1FB33A4_32C3_4BE9_9CA4_4CC9EE9C11B6
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+namespace cppast {
+
+class CppCompound;
+
+/**
+ * Version of binary AST format, it is bumped whenever the format or the AST model changes.
+ */
+constexpr std::uint32_t kBinaryAstVersion = 1;
+
+/**
+ * @brief Serializes the whole tree of the given compound.
+ *
+ * Lazily parsed definitions get parsed so that the binary AST has them all.
+ * @throw std::invalid_argument if the tree has an entity that the format cannot represent.
+ */
+std::string WriteBinaryAst(const CppCompound& ast);
+
+/**
+ * @brief Reconstructs a tree from data written by WriteBinaryAst().
+ * @return nullptr if the data is not a binary AST of current version or if it is corrupt.
+ * @note Texts are owned by the returned entities, so, @a data need not outlive the tree.
+ * Entities are allocated from CppEntityArena::current() if there is one, just like when they are parsed.
+ */
+std::unique_ptr<CppCompound> ReadBinaryAst(std::string_view data);
+
+} // namespace cppast
+
+#endif /* F1FB33A4_32C3_4BE9_9CA4_4CC9EE9C11B6 */
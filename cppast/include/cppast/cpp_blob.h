@@ -5,7 +5,10 @@
 #define C5550546_B6DB_4E84_BDAF_2F464ECB56A2
 
 #include "cppast/cpp_entity.h"
+#include "cppast/cpp_text.h"
+
 #include <string>
+#include <string_view>
 
 namespace cppast {
 
@@ -21,16 +24,26 @@ public:
   }
 
 public:
-  CppBlob(std::string blob);
+  CppBlob(CppText blob);
 
 public:
-  const std::string& blob() const
+  /**
+   * @return Copy of the text, blobView() avoids the copy.
+   */
+  std::string blob() const
+  {
+    return std::string(blob_.str());
+  }
+  /**
+   * @return The text, which can be a view into the source buffer, see CppText.
+   */
+  std::string_view blobView() const
   {
-    return blob_;
+    return blob_.str();
   }
 
 private:
-  std::string blob_;
+  CppText blob_;
 };
 
 } // namespace cppast
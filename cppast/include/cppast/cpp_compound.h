@@ -7,13 +7,16 @@
 #include "cppast/cpp_access_type.h"
 #include "cppast/cpp_blob.h"
 #include "cppast/cpp_entity.h"
+#include "cppast/cpp_entity_arena.h"
+#include "cppast/cpp_symbol.h"
 #include "cppast/cpp_templatable_entity.h"
 #include "cppast/defs.h"
+#include "cppast/helper/cpp_out_of_line.h"
+#include "cppast/helper/cpp_small_vector.h"
 
 #include <cassert>
 #include <cstdint>
 #include <functional>
-#include <list>
 #include <memory>
 #include <type_traits>
 #include <vector>
@@ -39,6 +42,11 @@ struct CppInheritanceInfo
   bool                         isVirtual {false};
 };
 
+/**
+ * Base classes of a compound, most have at most two.
+ */
+using CppInheritanceList = helper::CppSmallVector<CppInheritanceInfo, 2>;
+
 /**
  * @brief A compound C++ entity.
 
@@ -89,14 +97,53 @@ public:
     entities_.front()->owner(*this);
   }
 
+  /**
+   * @brief Moves all entities of \a other to the end of this compound.
+   */
+  void adoptEntitiesOf(CppCompound& other);
+
+  /**
+   * @brief Makes this compound own the arena from which its entities are allocated.
+   */
+  void arena(std::unique_ptr<CppEntityArena> arenaArg)
+  {
+    rootData().arena = std::move(arenaArg);
+  }
+  /**
+   * @return Arena owned by this compound from which its entities are allocated, nullptr if none.
+   */
+  const CppEntityArena* arena() const
+  {
+    return rootData_ ? rootData_->arena.get() : nullptr;
+  }
+
+  /**
+   * @brief Keeps alive the source buffer that texts of entities of this compound are views into.
+   */
+  void sourceBuffer(std::shared_ptr<const void> sourceBufferArg)
+  {
+    rootData().sourceBuffer = std::move(sourceBufferArg);
+  }
+
+  /**
+   * @brief Keeps alive the table in which names of entities of this compound are interned.
+   */
+  void symbolTable(std::shared_ptr<const CppSymbolTable> symbolTableArg)
+  {
+    rootData().symbolTable = std::move(symbolTableArg);
+  }
+
   bool visitAll(const Visitor<const CppEntity&>& callback) const;
 
   template <typename _EntityClass>
   bool visit(const Visitor<const _EntityClass&>& callback) const
   {
-    return visitAll([&callback](const CppEntity& entity) {
-      return (entity.entityType() != _EntityClass::EntityType()) || callback(static_cast<const _EntityClass&>(entity));
-    });
+    for (const auto& entity : entities_)
+    {
+      if ((entity->entityType() == _EntityClass::EntityType()) && !callback(static_cast<const _EntityClass&>(*entity)))
+        return false;
+    }
+    return true;
   }
 
   bool visitAll(const Visitor<CppEntity&>& callback);
@@ -104,38 +151,59 @@ public:
   template <typename _EntityClass>
   bool visit(const Visitor<_EntityClass&>& callback)
   {
-    return visitAll([&callback](CppEntity& entity) {
-      return (entity.entityType() != _EntityClass::EntityType()) || callback(static_cast<_EntityClass&>(entity));
-    });
+    for (auto& entity : entities_)
+    {
+      if ((entity->entityType() == _EntityClass::EntityType()) && !callback(static_cast<_EntityClass&>(*entity)))
+        return false;
+    }
+    return true;
+  }
+
+  size_t numMembers() const
+  {
+    return entities_.size();
+  }
+
+  const CppEntity& member(size_t idx) const
+  {
+    return *entities_[idx];
   }
 
   const std::string& name() const
   {
     return name_;
   }
-  void name(std::string nameArg)
+  const CppSymbol& nameSymbol() const
+  {
+    return name_;
+  }
+  void name(const std::string& nameArg)
   {
-    name_ = std::move(nameArg);
+    name_ = CppSymbol(nameArg);
   }
 
   const std::string& apidecor() const
   {
-    return apidecor_;
+    return apidecor_.get();
   }
   void apidecor(std::string apidecor)
   {
-    apidecor_ = std::move(apidecor);
+    apidecor_.set(std::move(apidecor));
   }
 
-  const std::list<CppInheritanceInfo>& inheritanceList() const
+  const CppInheritanceList& inheritanceList() const
   {
-    return inheritanceList_;
+    return inheritanceList_.get();
   }
-  void inheritanceList(std::list<CppInheritanceInfo> inheritanceListArg)
+  void inheritanceList(CppInheritanceList inheritanceListArg)
   {
-    inheritanceList_ = std::move(inheritanceListArg);
+    inheritanceList_.set(std::move(inheritanceListArg));
   }
 
+  std::uint32_t attr() const
+  {
+    return attr_;
+  }
   void addAttr(std::uint32_t attrArg)
   {
     attr_ |= attrArg;
@@ -147,12 +215,34 @@ public:
   }
 
 private:
-  std::vector<std::unique_ptr<CppEntity>> entities_;
-  std::string                             name_;
-  CppCompoundType                         compoundType_;
-  std::list<CppInheritanceInfo>           inheritanceList_;
-  std::string                             apidecor_;
-  std::uint32_t                           attr_ {0}; // e.g. final
+  /**
+   * Data that only compounds at the root of a parse, i.e. files and lazily parsed bodies, have.
+   * It is kept out of line so that rest of the compounds, e.g. blocks of statements, do not pay for it.
+   */
+  struct RootData
+  {
+    std::unique_ptr<CppEntityArena>       arena;
+    std::shared_ptr<const void>           sourceBuffer;
+    std::shared_ptr<const CppSymbolTable> symbolTable;
+  };
+
+  RootData& rootData()
+  {
+    if (!rootData_)
+      rootData_ = std::make_unique<RootData>();
+    return *rootData_;
+  }
+
+private:
+  // Must be declared before entities_ so that the arena, the source buffer, and the symbol table are destroyed after
+  // the entities.
+  std::unique_ptr<RootData>                rootData_;
+  std::vector<std::unique_ptr<CppEntity>>  entities_;
+  CppSymbol                                name_;
+  helper::CppOutOfLine<CppInheritanceList> inheritanceList_;
+  helper::CppOutOfLine<std::string>        apidecor_;
+  std::uint32_t                            attr_ {0}; // e.g. final
+  CppCompoundType                          compoundType_;
 };
 
 } // namespace cppast
@@ -5,6 +5,10 @@
 #define E6097D4F_30B2_4DBB_BD3D_0FAE0F8AD156
 
 #include "cppast/cpp_entity.h"
+#include "cppast/cpp_text.h"
+
+#include <string>
+#include <string_view>
 
 namespace cppast {
 
@@ -20,20 +24,30 @@ public:
   }
 
 public:
-  CppDocumentationComment(std::string doc)
+  CppDocumentationComment(CppText doc)
     : CppEntity(EntityType())
     , doc_(std::move(doc))
   {
   }
 
 public:
-  const std::string& str() const
+  /**
+   * @return Copy of the comment, strView() avoids the copy.
+   */
+  std::string str() const
+  {
+    return std::string(doc_.str());
+  }
+  /**
+   * @return The comment, which can be a view into the source buffer, see CppText.
+   */
+  std::string_view strView() const
   {
-    return doc_;
+    return doc_.str();
   }
 
 private:
-  std::string doc_; ///< Entire comment text
+  CppText doc_; ///< Entire comment text
 };
 
 } // namespace cppast
@@ -8,6 +8,7 @@
 #include "cppast/cpp_entity_type.h"
 #include "cppast/defs.h"
 
+#include <cstddef>
 #include <functional>
 #include <memory>
 
@@ -24,6 +25,12 @@ public:
 public:
   virtual ~CppEntity() = default;
 
+  /**
+   * Entities are allocated from CppEntityArena::current() when there is one, otherwise from heap.
+   */
+  static void* operator new(std::size_t size);
+  static void  operator delete(void* ptr);
+
 public:
   CppEntityType entityType() const
   {
@@ -50,8 +57,9 @@ private:
   friend class CppCompound;
 
 private:
+  const CppCompound* owner_ {nullptr};
+  // Kept last so that small fields of derived classes are laid out in the padding after it.
   const CppEntityType entityType_;
-  const CppCompound*  owner_ {nullptr};
 };
 
 } // namespace cppast
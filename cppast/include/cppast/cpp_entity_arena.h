@@ -0,0 +1,76 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef B1B5D217_3B27_48BE_9617_AE091DA319D5
+#define B1B5D217_3B27_48BE_9617_AE091DA319D5
+
+#include <cstddef>
+#include <memory_resource>
+
+namespace cppast {
+
+/**
+ * @brief Monotonic memory from which entities can be allocated.
+ *
+ * While an arena is made current on a thread using CppEntityArena::Scope,
+ * all entities created on that thread are carved out of the arena.
+ * Deleting such an entity runs its destructor but does not release its memory,
+ * the whole memory is released at once when the arena is destroyed.
+ * So, the arena must outlive all entities allocated from it.
+ */
+class CppEntityArena
+{
+public:
+  /**
+   * @brief Makes an arena current on the calling thread for the lifetime of the scope object.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(CppEntityArena& arena);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    CppEntityArena* prevArena_;
+  };
+
+public:
+  CppEntityArena();
+  /**
+   * @param initialSize Size of the first block of memory, it is allocated only when the first entity is.
+   */
+  explicit CppEntityArena(std::size_t initialSize);
+
+  CppEntityArena(const CppEntityArena&)            = delete;
+  CppEntityArena& operator=(const CppEntityArena&) = delete;
+
+public:
+  /**
+   * @return Arena that is current on the calling thread, nullptr if there is none.
+   */
+  static CppEntityArena* current();
+
+  void* allocate(std::size_t size, std::size_t alignment);
+
+  std::size_t numAllocations() const
+  {
+    return numAllocations_;
+  }
+
+  std::size_t bytesAllocated() const
+  {
+    return bytesAllocated_;
+  }
+
+private:
+  std::pmr::monotonic_buffer_resource memory_;
+  std::size_t                         numAllocations_ {0};
+  std::size_t                         bytesAllocated_ {0};
+};
+
+} // namespace cppast
+
+#endif /* B1B5D217_3B27_48BE_9617_AE091DA319D5 */
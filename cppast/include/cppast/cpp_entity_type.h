@@ -4,9 +4,11 @@
 #ifndef C9EFCA65_C9EF_406A_8025_AFF92923890D
 #define C9EFCA65_C9EF_406A_8025_AFF92923890D
 
+#include <cstdint>
+
 namespace cppast {
 
-enum class CppEntityType
+enum class CppEntityType : std::uint8_t
 {
   DOCUMENTATION_COMMENT,
 
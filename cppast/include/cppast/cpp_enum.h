@@ -6,8 +6,8 @@
 
 #include "cppast/cpp_entity.h"
 #include "cppast/cpp_expression.h"
+#include "cppast/helper/cpp_small_vector.h"
 
-#include <list>
 #include <memory>
 #include <string>
 
@@ -68,6 +68,12 @@ private:
   std::unique_ptr<CppEntity> nonConstEntity_;
 };
 
+/**
+ * Items of an enum, they are kept contiguous because some enums have thousands of them.
+ * Items are too big to keep any inline in every enum.
+ */
+using CppEnumItemList = helper::CppSmallVector<CppEnumItem, 0>;
+
 class CppEnum : public CppEntity
 {
 public:
@@ -77,10 +83,10 @@ public:
   }
 
 public:
-  CppEnum(std::string            name,
-          std::list<CppEnumItem> itemList,
-          bool                   isClass        = false,
-          std::string            underlyingType = std::string())
+  CppEnum(std::string     name,
+          CppEnumItemList itemList,
+          bool            isClass        = false,
+          std::string     underlyingType = std::string())
     : CppEntity(EntityType())
     , name_(std::move(name))
     , itemList_(std::move(itemList))
@@ -95,7 +101,7 @@ public:
     return name_;
   }
 
-  const std::list<CppEnumItem>& itemList() const
+  const CppEnumItemList& itemList() const
   {
     return itemList_;
   }
@@ -111,10 +117,10 @@ public:
   }
 
 private:
-  std::string            name_;     // Can be empty for anonymous enum.
-  std::list<CppEnumItem> itemList_; // Can be nullptr for forward declared enum.
-  bool                   isClass_;
-  std::string            underlyingType_;
+  std::string     name_;     // Can be empty for anonymous enum.
+  CppEnumItemList itemList_; // Can be nullptr for forward declared enum.
+  bool            isClass_;
+  std::string     underlyingType_;
 };
 
 } // namespace cppast
@@ -7,6 +7,7 @@
 #include "cppast/cpp_entity.h"
 #include "cppast/cpp_expression_operators.h"
 #include "cppast/cpp_expression_type.h"
+#include "cppast/cpp_symbol.h"
 #include "cppast/cpp_typecast_type.h"
 #include "cppast/cpp_var_type.h"
 
@@ -48,7 +49,7 @@ private:
   const CppExpressionType expressionType_;
 };
 
-enum class CppAtomicExprType
+enum class CppAtomicExprType : std::uint8_t
 {
   STRING_LITERAL,
   CHAR_LITERAL,
@@ -101,7 +102,10 @@ protected:
   CppAtomicExprImplBase() {}
 };
 
-template <CppAtomicExprType _AtomicExprType>
+/**
+ * @tparam _Atom Storage of the atom, a CppSymbol for atoms that repeat a lot, e.g. names.
+ */
+template <CppAtomicExprType _AtomicExprType, typename _Atom = std::string>
 class CppCommonAtomicExprImplBase : public CppAtomicExprImplBase<_AtomicExprType>
 {
 public:
@@ -116,8 +120,13 @@ protected:
   {
   }
 
+  const _Atom& atom() const
+  {
+    return atom_;
+  }
+
 private:
-  std::string atom_;
+  _Atom atom_;
 };
 
 class CppStringLiteralExpr : public CppAtomicExpr, public CppCommonAtomicExprImplBase<CppAtomicExprType::STRING_LITERAL>
@@ -155,7 +164,7 @@ public:
   }
 };
 
-class CppNameExpr : public CppAtomicExpr, public CppCommonAtomicExprImplBase<CppAtomicExprType::NAME>
+class CppNameExpr : public CppAtomicExpr, public CppCommonAtomicExprImplBase<CppAtomicExprType::NAME, CppSymbol>
 {
 public:
   CppNameExpr(std::string atom)
@@ -164,9 +173,14 @@ public:
   {
   }
 
+  const CppSymbol& valueSymbol() const
+  {
+    return atom();
+  }
+
   friend bool operator==(const CppNameExpr& lhs, const CppNameExpr& rhs)
   {
-    return lhs.value() == rhs.value();
+    return lhs.valueSymbol() == rhs.valueSymbol();
   }
 };
 
@@ -378,7 +392,7 @@ public:
 public:
   CppUniformInitializerExpr(std::string name, std::vector<std::unique_ptr<CppExpression>> args)
     : CppExpression(ExpressionType())
-    , name_(std::move(name))
+    , name_(name)
     , arguments_(std::move(args))
   {
   }
@@ -400,7 +414,7 @@ public:
   }
 
 private:
-  std::string                                       name_;
+  CppSymbol                                   name_;
   std::vector<std::unique_ptr<CppExpression>> arguments_;
 };
 
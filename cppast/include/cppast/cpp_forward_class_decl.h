@@ -6,7 +6,9 @@
 
 #include "cppast/cpp_compound.h"
 #include "cppast/cpp_entity.h"
+#include "cppast/cpp_symbol.h"
 #include "cppast/cpp_templatable_entity.h"
+#include "cppast/helper/cpp_out_of_line.h"
 
 namespace cppast {
 
@@ -21,11 +23,10 @@ public:
 public:
   CppForwardClassDecl(std::string name, std::string apidecor, CppCompoundType cmpType = CppCompoundType::UNKNOWN)
     : CppEntity(EntityType())
+    , name_(name)
     , compoundType_(cmpType)
-    , name_(std::move(name))
-    , apidecor_(std::move(apidecor))
-    , attr_(0)
   {
+    apidecor_.set(std::move(apidecor));
   }
 
   CppForwardClassDecl(std::string name, CppCompoundType cmpType = CppCompoundType::UNKNOWN)
@@ -43,10 +44,14 @@ public:
   {
     return name_;
   }
+  const CppSymbol& nameSymbol() const
+  {
+    return name_;
+  }
 
   const std::string& apidecor() const
   {
-    return apidecor_;
+    return apidecor_.get();
   }
 
   std::uint32_t attr() const
@@ -59,10 +64,10 @@ public:
   }
 
 private:
-  CppCompoundType compoundType_;
-  std::string     name_;
-  std::string     apidecor_;
-  std::uint32_t         attr_ {0};
+  CppSymbol                         name_;
+  helper::CppOutOfLine<std::string> apidecor_;
+  std::uint32_t                     attr_ {0};
+  CppCompoundType                   compoundType_;
 };
 
 } // namespace cppast
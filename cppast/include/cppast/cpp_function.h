@@ -7,12 +7,15 @@
 #include "cppast/cpp_compound.h"
 #include "cppast/cpp_entity.h"
 #include "cppast/cpp_expression.h"
+#include "cppast/cpp_lazy_compound.h"
+#include "cppast/cpp_symbol.h"
 #include "cppast/cpp_template_param.h"
 #include "cppast/cpp_var_decl.h"
+#include "cppast/helper/cpp_out_of_line.h"
+#include "cppast/helper/cpp_small_vector.h"
 #include "cppast/cpp_var_type.h"
 
 #include <functional>
-#include <list>
 
 namespace cppast {
 
@@ -24,25 +27,37 @@ class CppFuncLike
 public:
   const std::vector<std::string>& throwSpec() const
   {
-    return throwSpec_;
+    return throwSpec_.get();
   }
   void throwSpec(std::vector<std::string> throwSpecArg)
   {
-    throwSpec_ = std::move(throwSpecArg);
+    throwSpec_.set(std::move(throwSpecArg));
   }
 
+  /**
+   * @return Definition, nullptr if this object is just for declaration.
+   * @note A lazily parsed definition is parsed by the first call.
+   */
   const CppCompound* defn() const
   {
     return defn_.get();
   }
-  void defn(std::unique_ptr<CppCompound> defnArg)
+  void defn(CppLazyCompound defnArg)
   {
     defn_ = std::move(defnArg);
   }
 
+  /**
+   * @return true if there is a definition, without parsing it if it is lazily parsed.
+   */
+  bool hasDefn() const
+  {
+    return defn_.has();
+  }
+
 private:
-  std::unique_ptr<CppCompound> defn_; // If it is nullptr then this object is just for declaration.
-  std::vector<std::string>     throwSpec_;
+  CppLazyCompound                                defn_;
+  helper::CppOutOfLine<std::vector<std::string>> throwSpec_;
 };
 
 /**
@@ -55,6 +70,10 @@ public:
   {
     return name_;
   }
+  const CppSymbol& nameSymbol() const
+  {
+    return name_;
+  }
 
   std::uint32_t attr() const
   {
@@ -71,34 +90,34 @@ public:
 
   const std::string& decor1() const
   {
-    return decor1_;
+    return decor1_.get();
   }
   void decor1(std::string decorArg)
   {
-    decor1_ = std::move(decorArg);
+    decor1_.set(std::move(decorArg));
   }
 
   const std::string& decor2() const
   {
-    return decor2_;
+    return decor2_.get();
   }
   void decor2(std::string decorArg)
   {
-    decor2_ = std::move(decorArg);
+    decor2_.set(std::move(decorArg));
   }
 
 protected:
   CppFunctionCommon(std::string name, std::uint32_t attr)
-    : name_(std::move(name))
+    : name_(name)
     , attr_(attr)
   {
   }
 
 private:
-  std::string name_;
-  std::uint32_t     attr_;   // e.g.: const, static, virtual, inline, constexpr, etc.
-  std::string       decor1_; // e.g. __declspec(dllexport)
-  std::string       decor2_; // e.g. __stdcall
+  CppSymbol                         name_;
+  std::uint32_t                     attr_;   // e.g.: const, static, virtual, inline, constexpr, etc.
+  helper::CppOutOfLine<std::string> decor1_; // e.g. __declspec(dllexport)
+  helper::CppOutOfLine<std::string> decor2_; // e.g. __stdcall
 };
 
 class CppFuncOrCtorCommon : public CppFunctionCommon
@@ -109,6 +128,11 @@ public:
     return !params_.empty();
   }
 
+  const std::vector<std::unique_ptr<CppEntity>>& params() const
+  {
+    return params_;
+  }
+
   bool visitParams(const std::function<bool(const CppEntity& param)>& callback) const
   {
     for (const auto& param : params_)
@@ -196,7 +220,7 @@ public:
 public:
   CppLambda(std::unique_ptr<CppExpression>          captures,
             std::vector<std::unique_ptr<CppEntity>> params,
-            std::unique_ptr<CppCompound>            defn,
+            CppLazyCompound                         defn,
             std::unique_ptr<CppVarType>             retType = nullptr);
 
 public:
@@ -224,7 +248,7 @@ private:
   std::unique_ptr<CppExpression>          captures_;
   std::vector<std::unique_ptr<CppEntity>> params_;
   std::unique_ptr<CppVarType>             retType_;
-  std::unique_ptr<CppCompound>            defn_;
+  CppLazyCompound                         defn_;
 };
 
 /**
@@ -275,7 +299,7 @@ struct CppMemberInit
 /**
  * Entire member initialization list.
  */
-using CppMemberInits = std::list<CppMemberInit>;
+using CppMemberInits = helper::CppSmallVector<CppMemberInit, 0>;
 
 class CppConstructor : public CppEntity, public CppFuncOrCtorCommon
 {
@@ -0,0 +1,56 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef E2EEB95C_81F3_4699_967B_ED8D4AC783DE
+#define E2EEB95C_81F3_4699_967B_ED8D4AC783DE
+
+#include "cppast/cpp_symbol.h"
+#include "cppast/cpp_type_modifier.h"
+
+#include <cstddef>
+#include <cstdint>
+
+namespace cppast {
+
+/**
+ * @brief Immutable description of a type that all equal types interned in the same CppSymbolTable share.
+ *
+ * Two interned types of same table are equal only when they are the same object.
+ * @see CppVarType, CppSymbolTable::intern().
+ */
+struct CppInternedType
+{
+  CppSymbol       baseType;
+  CppTypeModifier typeModifier;
+  std::uint32_t   typeAttr;
+  bool            paramPack;
+  /// True for a description of no table, which the only CppVarType that has it owns, it is neither hashed nor compared.
+  bool ofNoTable {false};
+
+  std::size_t hash() const
+  {
+    const auto combine = [](std::size_t seed, std::size_t value) {
+      return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+    };
+    const auto shape = std::size_t(typeModifier.refType_) | (std::size_t(typeModifier.ptrLevel_) << 8)
+                       | (std::size_t(paramPack) << 16);
+    return combine(combine(combine(baseType.hash(), shape), typeModifier.constBits_), typeAttr);
+  }
+
+  friend bool operator==(const CppInternedType& lhs, const CppInternedType& rhs)
+  {
+    return (lhs.typeModifier.refType_ == rhs.typeModifier.refType_)
+           && (lhs.typeModifier.ptrLevel_ == rhs.typeModifier.ptrLevel_)
+           && (lhs.typeModifier.constBits_ == rhs.typeModifier.constBits_) && (lhs.typeAttr == rhs.typeAttr)
+           && (lhs.paramPack == rhs.paramPack) && (lhs.baseType == rhs.baseType);
+  }
+
+  friend bool operator!=(const CppInternedType& lhs, const CppInternedType& rhs)
+  {
+    return !(lhs == rhs);
+  }
+};
+
+} // namespace cppast
+
+#endif /* E2EEB95C_81F3_4699_967B_ED8D4AC783DE */
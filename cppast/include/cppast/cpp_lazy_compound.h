@@ -0,0 +1,66 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef BC974E0F_621D_46E5_9F2B_DAE9BE3055B4
+#define BC974E0F_621D_46E5_9F2B_DAE9BE3055B4
+
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace cppast {
+
+class CppCompound;
+
+/**
+ * @brief A compound that is either available right away or is parsed when it is accessed for the first time.
+ *
+ * It lets parser record just the text of a function body and leave the parsing of it to whoever needs it.
+ * Accessing it from different threads at the same time is safe and the parsing happens only once.
+ */
+class CppLazyCompound
+{
+public:
+  using Parser = std::function<std::unique_ptr<CppCompound>()>;
+
+public:
+  CppLazyCompound();
+  CppLazyCompound(std::unique_ptr<CppCompound> compound);
+  CppLazyCompound(Parser parser);
+  CppLazyCompound(CppLazyCompound&& other) noexcept;
+  ~CppLazyCompound();
+
+  CppLazyCompound& operator=(CppLazyCompound&& other) noexcept;
+
+public:
+  /**
+   * @return The compound, parsing it first if it is not yet parsed, nullptr if there is none.
+   */
+  const CppCompound* get() const;
+
+  /**
+   * @return true if there is a compound, parsed or not.
+   * @note It never parses the compound and so it never races with get().
+   */
+  bool has() const
+  {
+    return pending_ || compound_;
+  }
+
+private:
+  /**
+   * State needed till the compound is parsed.
+   */
+  struct Pending
+  {
+    std::once_flag once;
+    Parser         parser;
+  };
+
+  mutable std::unique_ptr<CppCompound> compound_;
+  std::unique_ptr<Pending>             pending_;
+};
+
+} // namespace cppast
+
+#endif /* BC974E0F_621D_46E5_9F2B_DAE9BE3055B4 */
@@ -0,0 +1,282 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file AST layout that is traversed right where it is memory mapped, without creating any entity.
+ *
+ * The layout is:
+ *  - A header with magic bytes, version, and the number of nodes.
+ *  - Fixed size node records in breadth first order, so, children of a node are a contiguous range of nodes.
+ *  - A string table that names of nodes are offsets into.
+ * Integers are stored in native byte order, so, the data is meant for machines of same endianness.
+ */
+
+#ifndef A1020BA1_481D_4079_AC2F_E633BFE8D423
+#define A1020BA1_481D_4079_AC2F_E633BFE8D423
+
+#include "cppast/cpp_access_type.h"
+#include "cppast/cpp_entity_type.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppast {
+
+class CppCompound;
+class CppMappedAst;
+
+enum class CppCompoundType : std::uint8_t;
+
+/**
+ * Version of mapped AST layout, it is bumped whenever the layout changes.
+ */
+constexpr std::uint32_t kMappedAstVersion = 1;
+
+/**
+ * @brief Serializes the tree of the given compound in the layout that CppMappedAst reads.
+ *
+ * Children of a compound are its members and those of a function like entity are its parameters.
+ * Lazily parsed definitions get parsed so that the mapped AST has them all.
+ */
+std::string WriteMappedAst(const CppCompound& ast);
+
+/**
+ * @brief Read only view of an entity of a mapped AST.
+ *
+ * It is as cheap to copy as a pointer and is valid as long as the CppMappedAst it belongs to.
+ */
+class CppEntityView
+{
+public:
+  CppEntityType entityType() const
+  {
+    return static_cast<CppEntityType>(node_->entityType);
+  }
+
+  /**
+   * @return Name of the entity, e.g. name of compound, function, variable, or macro, and empty if it has none.
+   */
+  std::string_view name() const;
+
+  /**
+   * @return Compound type of a compound or of a forward class declaration.
+   */
+  CppCompoundType compoundType() const
+  {
+    return static_cast<CppCompoundType>(node_->subType);
+  }
+
+  /**
+   * @return Access type of an entity access specifier.
+   */
+  CppAccessType accessType() const
+  {
+    return static_cast<CppAccessType>(node_->subType);
+  }
+
+  /**
+   * @return Attributes of a compound, forward class declaration, or a function like entity.
+   */
+  std::uint32_t attr() const
+  {
+    return node_->attr;
+  }
+
+  /**
+   * @return The compound this entity is a member or a parameter of, std::nullopt for the root.
+   */
+  std::optional<CppEntityView> owner() const;
+
+  /**
+   * @return Definition of a function like entity, std::nullopt if it has none.
+   */
+  std::optional<CppEntityView> defn() const;
+
+  size_t numChildren() const
+  {
+    return node_->numChildren;
+  }
+
+  CppEntityView child(size_t idx) const;
+
+  /**
+   * @brief Calls @a callback for each child, stopping at the first one for which it returns false.
+   * @return false if the visit was stopped by @a callback.
+   */
+  template <typename Callback>
+  bool visitAll(Callback&& callback) const
+  {
+    for (size_t i = 0; i < numChildren(); ++i)
+    {
+      if (!callback(child(i)))
+        return false;
+    }
+    return true;
+  }
+
+  template <typename _EntityClass, typename Callback>
+  bool visit(Callback&& callback) const
+  {
+    return visitAll([&callback](const CppEntityView& entity) {
+      return (entity.entityType() != _EntityClass::EntityType()) || callback(entity);
+    });
+  }
+
+private:
+  friend class CppMappedAst;
+  friend std::string WriteMappedAst(const CppCompound& ast);
+
+  /**
+   * Record of an entity as it is laid out in the mapped data.
+   */
+  struct Node
+  {
+    static constexpr std::uint32_t kNone = ~std::uint32_t(0);
+
+    std::uint8_t  entityType;
+    std::uint8_t  subType;
+    std::uint16_t reserved;
+    std::uint32_t attr;
+    std::uint32_t nameOffset;
+    std::uint32_t nameSize;
+    std::uint32_t parent;
+    std::uint32_t firstChild;
+    std::uint32_t numChildren;
+    std::uint32_t defn;
+  };
+
+  CppEntityView(const CppMappedAst& ast, const Node& node)
+    : ast_(&ast)
+    , node_(&node)
+  {
+  }
+
+private:
+  const CppMappedAst* ast_;
+  const Node*         node_;
+};
+
+/**
+ * @brief AST written by WriteMappedAst() that is accessed in place through CppEntityView.
+ *
+ * Opening it validates the layout once, so, traversing it never reads out of bounds even if the data was corrupt.
+ */
+class CppMappedAst
+{
+public:
+  /**
+   * @brief Memory maps the given file where supported and reads it otherwise.
+   * @return nullptr if the file cannot be read or it is not a valid mapped AST of current version.
+   */
+  static std::unique_ptr<CppMappedAst> open(const std::string& filename);
+
+  /**
+   * @brief Views the given data without copying it.
+   * @return nullptr if @a data is not a valid mapped AST of current version.
+   * @warning @a data must outlive the returned object and must be aligned at least to 4 bytes.
+   */
+  static std::unique_ptr<CppMappedAst> fromBuffer(std::string_view data);
+
+  ~CppMappedAst();
+
+  CppMappedAst(const CppMappedAst&)            = delete;
+  CppMappedAst& operator=(const CppMappedAst&) = delete;
+
+public:
+  /**
+   * @return The file level compound.
+   */
+  CppEntityView root() const
+  {
+    return CppEntityView(*this, nodes_[0]);
+  }
+
+  size_t numEntities() const
+  {
+    return numNodes_;
+  }
+
+private:
+  friend class CppEntityView;
+
+  CppMappedAst() = default;
+
+  bool validate(std::string_view data);
+
+private:
+  const CppEntityView::Node* nodes_ {nullptr};
+  std::uint32_t              numNodes_ {0};
+  const char*                strings_ {nullptr};
+
+  void*                   mapped_ {nullptr};
+  size_t                  mappedSize_ {0};
+  std::unique_ptr<char[]> contents_;
+};
+
+inline std::string_view CppEntityView::name() const
+{
+  return std::string_view(ast_->strings_ + node_->nameOffset, node_->nameSize);
+}
+
+inline std::optional<CppEntityView> CppEntityView::owner() const
+{
+  if (node_->parent == Node::kNone)
+    return std::nullopt;
+  return CppEntityView(*ast_, ast_->nodes_[node_->parent]);
+}
+
+inline std::optional<CppEntityView> CppEntityView::defn() const
+{
+  if (node_->defn == Node::kNone)
+    return std::nullopt;
+  return CppEntityView(*ast_, ast_->nodes_[node_->defn]);
+}
+
+inline CppEntityView CppEntityView::child(size_t idx) const
+{
+  return CppEntityView(*ast_, ast_->nodes_[node_->firstChild + idx]);
+}
+
+/**
+ * @brief Get the vector of specific type of owned entities of a mapped entity.
+ *
+ * @tparam _EntityClass Class type of owned entities, e.g. CppFunction.
+ * @return std::vector of views of owned entities.
+ */
+template <typename _EntityClass>
+inline std::vector<CppEntityView> GetOwnedEntities(const CppEntityView& owner)
+{
+  std::vector<CppEntityView> result;
+  owner.visit<_EntityClass>([&result](const CppEntityView& entity) {
+    result.push_back(entity);
+    return true;
+  });
+
+  return result;
+}
+
+/**
+ * @brief Get all the owned entities of a mapped entity.
+ *
+ * @return std::vector of views of owned entities.
+ */
+inline std::vector<CppEntityView> GetAllOwnedEntities(const CppEntityView& owner)
+{
+  std::vector<CppEntityView> result;
+  result.reserve(owner.numChildren());
+  owner.visitAll([&result](const CppEntityView& entity) {
+    result.push_back(entity);
+    return true;
+  });
+
+  return result;
+}
+
+} // namespace cppast
+
+#endif /* A1020BA1_481D_4079_AC2F_E633BFE8D423 */
@@ -8,7 +8,7 @@
 
 namespace cppast {
 
-enum class CppPreprocessorType
+enum class CppPreprocessorType : std::uint8_t
 {
   DEFINE,
   UNDEF,
@@ -8,7 +8,7 @@
 
 namespace cppast {
 
-enum class PreprocessorConditionalType
+enum class PreprocessorConditionalType : std::uint8_t
 {
   IF,
   IFDEF,
@@ -26,9 +26,15 @@ enum class PreprocessorConditionalType
  */
 class CppPreprocessorConditional : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::CONDITIONAL;
+  }
+
 public:
   CppPreprocessorConditional(PreprocessorConditionalType condType, std::string cond = std::string())
-    : CppPreprocessor(CppPreprocessorType::CONDITIONAL)
+    : CppPreprocessor(PreprocessorType())
     , condType_(condType)
     , cond_(std::move(cond))
   {
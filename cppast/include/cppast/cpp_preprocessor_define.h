@@ -5,12 +5,14 @@
 #define BE744AC2_52B3_46C4_A40D_9DB23E75A1F2
 
 #include "cppast/cpp_preprocessor.h"
+#include "cppast/cpp_text.h"
 
 #include <string>
+#include <string_view>
 
 namespace cppast {
 
-enum class CppPreprocessorDefineType
+enum class CppPreprocessorDefineType : std::uint8_t
 {
   RENAME,
   NUMBER,
@@ -25,8 +27,14 @@ enum class CppPreprocessorDefineType
 class CppPreprocessorDefine : public CppPreprocessor
 {
 public:
-  CppPreprocessorDefine(CppPreprocessorDefineType defType, std::string name, std::string defn = std::string())
-    : CppPreprocessor(CppPreprocessorType::DEFINE)
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::DEFINE;
+  }
+
+public:
+  CppPreprocessorDefine(CppPreprocessorDefineType defType, std::string name, CppText defn = CppText())
+    : CppPreprocessor(PreprocessorType())
     , defType_(defType)
     , name_(std::move(name))
     , defn_(std::move(defn))
@@ -43,15 +51,25 @@ public:
     return name_;
   }
 
-  const std::string& definition() const
+  /**
+   * @return Copy of the definition, definitionView() avoids the copy.
+   */
+  std::string definition() const
+  {
+    return std::string(defn_.str());
+  }
+  /**
+   * @return The definition, which can be a view into the source buffer, see CppText.
+   */
+  std::string_view definitionView() const
   {
-    return defn_;
+    return defn_.str();
   }
 
 private:
   CppPreprocessorDefineType defType_;
   std::string               name_;
-  std::string               defn_; ///< This will contain everything after name.
+  CppText                   defn_; ///< This will contain everything after name.
 };
 
 } // namespace cppast
@@ -10,9 +10,15 @@ namespace cppast {
 
 class CppPreprocessorImport : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::IMPORT;
+  }
+
 public:
   CppPreprocessorImport(std::string name)
-    : CppPreprocessor(CppPreprocessorType::IMPORT)
+    : CppPreprocessor(PreprocessorType())
     , name_(std::move(name))
   {
   }
@@ -10,9 +10,15 @@ namespace cppast {
 
 class CppPreprocessorInclude : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::INCLUDE;
+  }
+
 public:
   CppPreprocessorInclude(std::string name)
-    : CppPreprocessor(CppPreprocessorType::INCLUDE)
+    : CppPreprocessor(PreprocessorType())
     , name_(std::move(name))
   {
   }
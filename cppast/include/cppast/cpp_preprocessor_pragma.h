@@ -10,9 +10,15 @@ namespace cppast {
 
 class CppPreprocessorPragma : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::PRAGMA;
+  }
+
 public:
   CppPreprocessorPragma(std::string defn)
-    : CppPreprocessor(CppPreprocessorType::PRAGMA)
+    : CppPreprocessor(PreprocessorType())
     , defn_(std::move(defn))
   {
   }
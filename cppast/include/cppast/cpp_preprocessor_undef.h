@@ -10,9 +10,15 @@ namespace cppast {
 
 class CppPreprocessorUndef : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::UNDEF;
+  }
+
 public:
   CppPreprocessorUndef(std::string name)
-    : CppPreprocessor(CppPreprocessorType::UNDEF)
+    : CppPreprocessor(PreprocessorType())
     , name_(std::move(name))
   {
   }
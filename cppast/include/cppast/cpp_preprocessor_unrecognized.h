@@ -14,9 +14,15 @@ namespace cppast {
  */
 class CppPreprocessorUnrecognized : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::UNRECOGNIZED;
+  }
+
 public:
   CppPreprocessorUnrecognized(std::string name, std::string defn)
-    : CppPreprocessor(CppPreprocessorType::UNRECOGNIZED)
+    : CppPreprocessor(PreprocessorType())
     , name_(std::move(name))
     , defn_(std::move(defn))
   {
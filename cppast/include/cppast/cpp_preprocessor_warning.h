@@ -10,9 +10,15 @@ namespace cppast {
 
 class CppPreprocessorWarning : public CppPreprocessor
 {
+public:
+  static constexpr auto PreprocessorType()
+  {
+    return CppPreprocessorType::WARNING;
+  }
+
 public:
   CppPreprocessorWarning(std::string warningStr)
-    : CppPreprocessor(CppPreprocessorType::WARNING)
+    : CppPreprocessor(PreprocessorType())
     , warning_(std::move(warningStr))
   {
   }
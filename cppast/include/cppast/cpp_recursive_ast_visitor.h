@@ -0,0 +1,548 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef BAB70F82_5CE4_4CD0_9D8A_5A6DA5039E81
+#define BAB70F82_5CE4_4CD0_9D8A_5A6DA5039E81
+
+#include "cppast/cpp_entities.h"
+
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <variant>
+
+namespace cppast {
+
+/**
+ * @brief What CppRecursiveAstVisitor does after an entity is visited and before its children are traversed.
+ */
+enum class CppVisitAction : std::uint8_t
+{
+  CONTINUE,      ///< Traverse children of the entity.
+  SKIP_CHILDREN, ///< Prune the subtree of the entity and carry on with the rest of the AST.
+  STOP,          ///< End the traversal.
+};
+
+namespace helper {
+
+template <typename Visitor, typename T, typename = void>
+struct HasPreVisitHook : std::false_type
+{
+};
+template <typename Visitor, typename T>
+struct HasPreVisitHook<Visitor, T, std::void_t<decltype(std::declval<Visitor&>().preVisit(std::declval<const T&>()))>>
+  : std::true_type
+{
+};
+
+template <typename Visitor, typename T, typename = void>
+struct HasPostVisitHook : std::false_type
+{
+};
+template <typename Visitor, typename T>
+struct HasPostVisitHook<Visitor, T, std::void_t<decltype(std::declval<Visitor&>().postVisit(std::declval<const T&>()))>>
+  : std::true_type
+{
+};
+
+} // namespace helper
+
+/**
+ * @brief Walks an AST depth first in the order of source and calls hooks of Derived for every entity it reaches.
+ *
+ * Derived can have, for any entity classes it is interested in:
+ *  - CppVisitAction preVisit(const X&) that is called before children of an entity are traversed.
+ *  - bool postVisit(const X&) that is called after children of an entity are traversed, false ends the traversal.
+ * Hooks are called with the most derived class of an entity, so, a hook of a base class, e.g. CppExpression or
+ * CppEntity, is called for all the classes derived from it that do not have a hook of their own.
+ * Entities of classes that have no hook are just traversed. Hooks must be accessible to this class.
+ *
+ * Dispatch is a switch on type tags of entities and hooks are called directly, there is no std::function or virtual
+ * call involved.
+ *
+ * Children of an entity are members of a compound, parameters, return type, and definition of a function like entity,
+ * parts of control blocks and statements, initializers of variables, and operands of expressions.
+ * A type that defines a compound, an enum, or a function pointer in place, e.g. struct {int i;} s;, leads to the
+ * entity that it defines.
+ * @note Lazily parsed definitions are parsed when they are reached, pruning the function avoids that.
+ */
+template <typename Derived>
+class CppRecursiveAstVisitor
+{
+public:
+  /**
+   * @brief Traverses @a entity and all of its descendants.
+   * @return false if the traversal was ended by a hook.
+   */
+  bool traverse(const CppEntity& entity)
+  {
+    switch (entity.entityType())
+    {
+      case CppEntityType::DOCUMENTATION_COMMENT:
+        return traverseEntity(static_cast<const CppDocumentationComment&>(entity));
+      case CppEntityType::PREPROCESSOR:
+        return traversePreprocessor(static_cast<const CppPreprocessor&>(entity));
+      case CppEntityType::ENTITY_ACCESS_SPECIFIER:
+        return traverseEntity(static_cast<const CppEntityAccessSpecifier&>(entity));
+      case CppEntityType::COMPOUND:
+        return traverseEntity(static_cast<const CppCompound&>(entity));
+      case CppEntityType::VAR:
+        return traverseEntity(static_cast<const CppVar&>(entity));
+      case CppEntityType::VAR_LIST:
+        return traverseEntity(static_cast<const CppVarList&>(entity));
+      case CppEntityType::TYPEDEF_DECL:
+        return traverseEntity(static_cast<const CppTypedefName&>(entity));
+      case CppEntityType::TYPEDEF_DECL_LIST:
+        return traverseEntity(static_cast<const CppTypedefList&>(entity));
+      case CppEntityType::NAMESPACE_ALIAS:
+        return traverseEntity(static_cast<const CppNamespaceAlias&>(entity));
+      case CppEntityType::USING_NAMESPACE:
+        return traverseEntity(static_cast<const CppUsingNamespaceDecl&>(entity));
+      case CppEntityType::USING_DECL:
+        return traverseEntity(static_cast<const CppUsingDecl&>(entity));
+      case CppEntityType::ENUM:
+        return traverseEntity(static_cast<const CppEnum&>(entity));
+      case CppEntityType::FORWARD_CLASS_DECL:
+        return traverseEntity(static_cast<const CppForwardClassDecl&>(entity));
+      case CppEntityType::FUNCTION:
+        return traverseEntity(static_cast<const CppFunction&>(entity));
+      case CppEntityType::LAMBDA:
+        return traverseEntity(static_cast<const CppLambda&>(entity));
+      case CppEntityType::CONSTRUCTOR:
+        return traverseEntity(static_cast<const CppConstructor&>(entity));
+      case CppEntityType::DESTRUCTOR:
+        return traverseEntity(static_cast<const CppDestructor&>(entity));
+      case CppEntityType::TYPE_CONVERTER:
+        return traverseEntity(static_cast<const CppTypeConverter&>(entity));
+      case CppEntityType::FUNCTION_PTR:
+        return traverseEntity(static_cast<const CppFunctionPointer&>(entity));
+      case CppEntityType::EXPRESSION:
+        return traverseExpression(static_cast<const CppExpression&>(entity));
+      case CppEntityType::GOTO_STATEMENT:
+        return traverseEntity(static_cast<const CppGotoStatement&>(entity));
+      case CppEntityType::RETURN_STATEMENT:
+        return traverseEntity(static_cast<const CppReturnStatement&>(entity));
+      case CppEntityType::THROW_STATEMENT:
+        return traverseEntity(static_cast<const CppThrowStatement&>(entity));
+      case CppEntityType::MACRO_CALL:
+        return traverseEntity(static_cast<const CppMacroCall&>(entity));
+      case CppEntityType::ASM_BLOCK:
+        return traverseEntity(static_cast<const CppAsmBlock&>(entity));
+      case CppEntityType::LABEL:
+        return traverseEntity(static_cast<const CppLabel&>(entity));
+      case CppEntityType::IF_BLOCK:
+        return traverseEntity(static_cast<const CppIfBlock&>(entity));
+      case CppEntityType::FOR_BLOCK:
+        return traverseEntity(static_cast<const CppForBlock&>(entity));
+      case CppEntityType::RANGE_FOR_BLOCK:
+        return traverseEntity(static_cast<const CppRangeForBlock&>(entity));
+      case CppEntityType::WHILE_BLOCK:
+        return traverseEntity(static_cast<const CppWhileBlock&>(entity));
+      case CppEntityType::DO_WHILE_BLOCK:
+        return traverseEntity(static_cast<const CppDoWhileBlock&>(entity));
+      case CppEntityType::SWITCH_BLOCK:
+        return traverseEntity(static_cast<const CppSwitchBlock&>(entity));
+      case CppEntityType::TRY_BLOCK:
+        return traverseEntity(static_cast<const CppTryBlock&>(entity));
+      case CppEntityType::BLOB:
+        return traverseEntity(static_cast<const CppBlob&>(entity));
+    }
+
+    return traverseEntity(entity);
+  }
+
+protected:
+  Derived& derived()
+  {
+    return static_cast<Derived&>(*this);
+  }
+
+private:
+  template <typename T>
+  bool traverseEntity(const T& entity)
+  {
+    CppVisitAction action = CppVisitAction::CONTINUE;
+    if constexpr (helper::HasPreVisitHook<Derived, T>::value)
+      action = derived().preVisit(entity);
+
+    if (action == CppVisitAction::STOP)
+      return false;
+    if ((action == CppVisitAction::CONTINUE) && !traverseChildren(entity))
+      return false;
+
+    if constexpr (helper::HasPostVisitHook<Derived, T>::value)
+      return derived().postVisit(entity);
+    else
+      return true;
+  }
+
+  bool traversePreprocessor(const CppPreprocessor& preprocessor)
+  {
+    switch (preprocessor.preprocessorType())
+    {
+      case CppPreprocessorType::DEFINE:
+        return traverseEntity(static_cast<const CppPreprocessorDefine&>(preprocessor));
+      case CppPreprocessorType::UNDEF:
+        return traverseEntity(static_cast<const CppPreprocessorUndef&>(preprocessor));
+      case CppPreprocessorType::CONDITIONAL:
+        return traverseEntity(static_cast<const CppPreprocessorConditional&>(preprocessor));
+      case CppPreprocessorType::INCLUDE:
+        return traverseEntity(static_cast<const CppPreprocessorInclude&>(preprocessor));
+      case CppPreprocessorType::IMPORT:
+        return traverseEntity(static_cast<const CppPreprocessorImport&>(preprocessor));
+      case CppPreprocessorType::WARNING:
+        return traverseEntity(static_cast<const CppPreprocessorWarning&>(preprocessor));
+      case CppPreprocessorType::ERROR:
+        return traverseEntity(static_cast<const CppPreprocessorError&>(preprocessor));
+      case CppPreprocessorType::PRAGMA:
+        return traverseEntity(static_cast<const CppPreprocessorPragma&>(preprocessor));
+      case CppPreprocessorType::UNRECOGNIZED:
+        return traverseEntity(static_cast<const CppPreprocessorUnrecognized&>(preprocessor));
+      case CppPreprocessorType::LINE:
+        break;
+    }
+
+    return traverseEntity(preprocessor);
+  }
+
+  bool traverseExpression(const CppExpression& expr)
+  {
+    switch (expr.expressionType())
+    {
+      case CppExpressionType::ATOMIC:
+        return traverseAtomicExpr(static_cast<const CppAtomicExpr&>(expr));
+      case CppExpressionType::MONOMIAL:
+        return traverseEntity(static_cast<const CppMonomialExpr&>(expr));
+      case CppExpressionType::BINOMIAL:
+        return traverseEntity(static_cast<const CppBinomialExpr&>(expr));
+      case CppExpressionType::TRINOMIAL:
+        return traverseEntity(static_cast<const CppTrinomialExpr&>(expr));
+      case CppExpressionType::FUNCTION_CALL:
+        return traverseEntity(static_cast<const CppFunctionCallExpr&>(expr));
+      case CppExpressionType::UNIFORM_INITIALIZER:
+        return traverseEntity(static_cast<const CppUniformInitializerExpr&>(expr));
+      case CppExpressionType::INITIALIZER_LIST:
+        return traverseEntity(static_cast<const CppInitializerListExpr&>(expr));
+      case CppExpressionType::TYPECAST:
+        return traverseTypecastExpr(static_cast<const CppTypecastExpr&>(expr));
+    }
+
+    return traverseEntity(expr);
+  }
+
+  bool traverseAtomicExpr(const CppAtomicExpr& expr)
+  {
+    switch (expr.atomicExpressionType())
+    {
+      case CppAtomicExprType::STRING_LITERAL:
+        return traverseEntity(static_cast<const CppStringLiteralExpr&>(expr));
+      case CppAtomicExprType::CHAR_LITERAL:
+        return traverseEntity(static_cast<const CppCharLiteralExpr&>(expr));
+      case CppAtomicExprType::NUMBER_LITEREL:
+        return traverseEntity(static_cast<const CppNumberLiteralExpr&>(expr));
+      case CppAtomicExprType::NAME:
+        return traverseEntity(static_cast<const CppNameExpr&>(expr));
+      case CppAtomicExprType::VARTYPE:
+        return traverseEntity(static_cast<const CppVartypeExpr&>(expr));
+      case CppAtomicExprType::LAMBDA:
+        return traverseEntity(static_cast<const CppLambdaExpr&>(expr));
+    }
+
+    return traverseEntity(expr);
+  }
+
+  bool traverseTypecastExpr(const CppTypecastExpr& expr)
+  {
+    switch (expr.castType())
+    {
+      case CppTypecastType::C_STYLE:
+        return traverseEntity(static_cast<const CppCStyleTypecastExpr&>(expr));
+      case CppTypecastType::FUNCTION_STYLE:
+        return traverseEntity(static_cast<const CppFunctionStyleTypecastExpr&>(expr));
+      case CppTypecastType::STATIC:
+        return traverseEntity(static_cast<const CppStaticCastExpr&>(expr));
+      case CppTypecastType::CONST:
+        return traverseEntity(static_cast<const CppConstCastExpr&>(expr));
+      case CppTypecastType::DYNAMIC:
+        return traverseEntity(static_cast<const CppDynamiCastExpr&>(expr));
+      case CppTypecastType::REINTERPRET:
+        return traverseEntity(static_cast<const CppReinterpretCastExpr&>(expr));
+    }
+
+    return traverseEntity(expr);
+  }
+
+  bool traverseIfAny(const CppEntity* entity)
+  {
+    return !entity || traverse(*entity);
+  }
+
+  template <typename EntityPtrs>
+  bool traverseAll(const EntityPtrs& entities)
+  {
+    for (const auto& entity : entities)
+    {
+      if (!traverseIfAny(entity.get()))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseVarType(const CppVarType* varType)
+  {
+    return !varType || traverseIfAny(varType->compound());
+  }
+
+  bool traverseVarDecl(const CppVarDecl& varDecl)
+  {
+    if (varDecl.initializeType() == CppVarInitializeType::DIRECT_CONSTRUCTOR_CALL)
+    {
+      if (!traverseAll(varDecl.constructorCallArgs()))
+        return false;
+    }
+    else if (!traverseIfAny(varDecl.assignValue()))
+    {
+      return false;
+    }
+
+    return traverseIfAny(varDecl.bitField()) && traverseAll(varDecl.arraySizes());
+  }
+
+  // Children of entities of classes that have none.
+  bool traverseChildren(const CppEntity&)
+  {
+    return true;
+  }
+
+  bool traverseChildren(const CppCompound& compound)
+  {
+    for (size_t i = 0; i < compound.numMembers(); ++i)
+    {
+      if (!traverse(compound.member(i)))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppVar& var)
+  {
+    return traverseVarType(&var.varType()) && traverseVarDecl(var.varDecl());
+  }
+
+  bool traverseChildren(const CppVarList& varList)
+  {
+    if (!traverseIfAny(varList.firstVar().get()))
+      return false;
+    for (const auto& varDecl : varList.varDeclList())
+    {
+      if (!traverseVarDecl(varDecl))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppTypedefName& typedefName)
+  {
+    return traverseIfAny(typedefName.var());
+  }
+
+  bool traverseChildren(const CppTypedefList& typedefList)
+  {
+    return traverse(typedefList.varList());
+  }
+
+  bool traverseChildren(const CppUsingDecl& usingDecl)
+  {
+    return std::visit(
+      [this](const auto& decl) {
+        if constexpr (std::is_same_v<std::decay_t<decltype(decl)>, std::unique_ptr<CppVarType>>)
+          return traverseVarType(decl.get());
+        else
+          return traverseIfAny(decl.get());
+      },
+      usingDecl.definition());
+  }
+
+  bool traverseChildren(const CppEnum& enumObj)
+  {
+    for (const auto& item : enumObj.itemList())
+    {
+      if (!traverseIfAny(item.val()) || !traverseIfAny(item.nonConstEntity()))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppFunction& func)
+  {
+    return traverseVarType(func.returnType()) && traverseAll(func.params()) && traverseIfAny(func.defn());
+  }
+
+  bool traverseChildren(const CppLambda& lambda)
+  {
+    return traverseIfAny(lambda.captures()) && traverseAll(lambda.params()) && traverseVarType(lambda.returnType())
+           && traverseIfAny(lambda.defn());
+  }
+
+  bool traverseChildren(const CppConstructor& ctor)
+  {
+    if (!traverseAll(ctor.params()))
+      return false;
+    if (ctor.hasMemberInitList())
+    {
+      for (const auto& memberInit : ctor.memberInits())
+      {
+        if (!traverseAll(memberInit.memberInitInfo.args))
+          return false;
+      }
+    }
+    return traverseIfAny(ctor.defn());
+  }
+
+  bool traverseChildren(const CppDestructor& dtor)
+  {
+    return traverseIfAny(dtor.defn());
+  }
+
+  bool traverseChildren(const CppTypeConverter& typeConverter)
+  {
+    return traverseVarType(typeConverter.targetType()) && traverseIfAny(typeConverter.defn());
+  }
+
+  bool traverseChildren(const CppFunctionPointer& funcPtr)
+  {
+    return traverseVarType(funcPtr.returnType()) && traverseAll(funcPtr.params());
+  }
+
+  bool traverseChildren(const CppVartypeExpr& expr)
+  {
+    return traverseVarType(&expr.value());
+  }
+
+  bool traverseChildren(const CppLambdaExpr& expr)
+  {
+    return traverse(expr.lamda());
+  }
+
+  bool traverseChildren(const CppMonomialExpr& expr)
+  {
+    return traverse(expr.term());
+  }
+
+  bool traverseChildren(const CppBinomialExpr& expr)
+  {
+    return traverse(expr.term1()) && traverse(expr.term2());
+  }
+
+  bool traverseChildren(const CppTrinomialExpr& expr)
+  {
+    return traverse(expr.term1()) && traverse(expr.term2()) && traverse(expr.term3());
+  }
+
+  bool traverseChildren(const CppFunctionCallExpr& expr)
+  {
+    if (!traverse(expr.function()))
+      return false;
+    for (size_t i = 0; i < expr.numArgs(); ++i)
+    {
+      if (!traverse(expr.arg(i)))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppUniformInitializerExpr& expr)
+  {
+    for (size_t i = 0; i < expr.numArgs(); ++i)
+    {
+      if (!traverse(expr.arg(i)))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppInitializerListExpr& expr)
+  {
+    for (size_t i = 0; i < expr.numArgs(); ++i)
+    {
+      if (!traverse(expr.arg(i)))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppTypecastExpr& expr)
+  {
+    return traverseVarType(&expr.targetType()) && traverse(expr.inputExpresion());
+  }
+
+  bool traverseChildren(const CppGotoStatement& gotoStmt)
+  {
+    return traverse(gotoStmt.label());
+  }
+
+  bool traverseChildren(const CppReturnStatement& returnStmt)
+  {
+    return !returnStmt.hasReturnValue() || traverse(returnStmt.returnValue());
+  }
+
+  bool traverseChildren(const CppThrowStatement& throwStmt)
+  {
+    return !throwStmt.hasException() || traverse(throwStmt.exception());
+  }
+
+  bool traverseChildren(const CppIfBlock& ifBlock)
+  {
+    return traverseIfAny(ifBlock.condition()) && traverseIfAny(ifBlock.body()) && traverseIfAny(ifBlock.elsePart());
+  }
+
+  bool traverseChildren(const CppWhileBlock& whileBlock)
+  {
+    return traverseIfAny(whileBlock.condition()) && traverseIfAny(whileBlock.body());
+  }
+
+  bool traverseChildren(const CppDoWhileBlock& doWhileBlock)
+  {
+    return traverseIfAny(doWhileBlock.body()) && traverseIfAny(doWhileBlock.condition());
+  }
+
+  bool traverseChildren(const CppForBlock& forBlock)
+  {
+    return traverseIfAny(forBlock.start()) && traverseIfAny(forBlock.stop()) && traverseIfAny(forBlock.step())
+           && traverseIfAny(forBlock.body());
+  }
+
+  bool traverseChildren(const CppRangeForBlock& rangeForBlock)
+  {
+    return traverseIfAny(rangeForBlock.var()) && traverseIfAny(rangeForBlock.expr())
+           && traverseIfAny(rangeForBlock.body());
+  }
+
+  bool traverseChildren(const CppSwitchBlock& switchBlock)
+  {
+    if (!traverseIfAny(switchBlock.condition()))
+      return false;
+    for (const auto& switchCase : switchBlock.body())
+    {
+      if (!traverseIfAny(switchCase.caseExpr()) || !traverseIfAny(switchCase.body()))
+        return false;
+    }
+    return true;
+  }
+
+  bool traverseChildren(const CppTryBlock& tryBlock)
+  {
+    if (!traverseIfAny(tryBlock.tryStmt()))
+      return false;
+    for (const auto& catchBlock : tryBlock.catchBlocks())
+    {
+      if (!traverseVarType(catchBlock->exceptionType_.get()) || !traverseIfAny(catchBlock->catchStmt_.get()))
+        return false;
+    }
+    return true;
+  }
+};
+
+} // namespace cppast
+
+#endif /* BAB70F82_5CE4_4CD0_9D8A_5A6DA5039E81 */
@@ -0,0 +1,231 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef E5107283_FCE0_4FCC_AA19_073B7006E5DE
+#define E5107283_FCE0_4FCC_AA19_073B7006E5DE
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace cppast {
+
+class CppSymbolTable;
+struct CppInternedType;
+
+/**
+ * @brief An interned string, e.g. name of an entity or a type.
+ *
+ * It is just a pointer to the only copy of the string in a CppSymbolTable.
+ * So, symbols of same table are equal only when they point to the same string and hash of a symbol is computed once.
+ * Symbols of different tables are compared by their strings.
+ * A symbol created while no table is current belongs to no table, it and its copies own the string instead.
+ * @warning A copy of a symbol points to the same string, so, it is valid only as long as the table of the original.
+ * Use CppSymbolTable::intern() with str() of a symbol that needs to outlive its table.
+ */
+class CppSymbol
+{
+public:
+  /**
+   * @brief Interned string, its address never changes as long as its table is alive.
+   */
+  struct Entry
+  {
+    Entry(const CppSymbolTable* tableArg, std::size_t hashArg, std::string strArg, std::size_t numSymbolsArg = 0)
+      : table(tableArg)
+      , hash(hashArg)
+      , str(std::move(strArg))
+      , numSymbols(numSymbolsArg)
+    {
+    }
+
+    const CppSymbolTable* table;
+    std::size_t           hash;
+    std::string           str;
+    /// Number of symbols that own an entry of no table, it is released with the last of them.
+    mutable std::atomic<std::size_t> numSymbols;
+  };
+
+public:
+  /**
+   * @brief Empty symbol, it does not need any table.
+   */
+  CppSymbol();
+  /**
+   * @brief Interns @a str in the table that is current on the calling thread.
+   * @note Without a current table the symbol keeps a copy of @a str that only it and its copies share.
+   */
+  CppSymbol(std::string_view str);
+
+  CppSymbol(const CppSymbol& other)
+    : entry_(other.entry_)
+  {
+    retain();
+  }
+
+  CppSymbol& operator=(const CppSymbol& other)
+  {
+    other.retain();
+    release();
+    entry_ = other.entry_;
+    return *this;
+  }
+
+  ~CppSymbol()
+  {
+    release();
+  }
+
+public:
+  const std::string& str() const
+  {
+    return entry_->str;
+  }
+
+  operator const std::string&() const
+  {
+    return entry_->str;
+  }
+
+  bool empty() const
+  {
+    return entry_->str.empty();
+  }
+
+  std::size_t hash() const
+  {
+    return entry_->hash;
+  }
+
+  friend bool operator==(const CppSymbol& lhs, const CppSymbol& rhs)
+  {
+    if (lhs.entry_ == rhs.entry_)
+      return true;
+    // A table has only one entry for a string.
+    if (lhs.entry_->table && (lhs.entry_->table == rhs.entry_->table))
+      return false;
+    return (lhs.entry_->hash == rhs.entry_->hash) && (lhs.entry_->str == rhs.entry_->str);
+  }
+
+  friend bool operator!=(const CppSymbol& lhs, const CppSymbol& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  friend class CppSymbolTable;
+
+  explicit CppSymbol(const Entry* entry)
+    : entry_(entry)
+  {
+  }
+
+  // Empty entry too belongs to no table but it is never released, and, entries of a table are never counted.
+  bool ownsEntry() const
+  {
+    return !entry_->table && !entry_->str.empty();
+  }
+
+  void retain() const
+  {
+    if (ownsEntry())
+      entry_->numSymbols.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  void release()
+  {
+    if (ownsEntry() && (entry_->numSymbols.fetch_sub(1, std::memory_order_acq_rel) == 1))
+      delete entry_;
+  }
+
+private:
+  const Entry* entry_;
+};
+
+/**
+ * @brief Thread safe table of interned strings and types.
+ *
+ * While a table is made current on a thread using CppSymbolTable::Scope,
+ * all names and types of entities created on that thread are interned in it.
+ * So, each distinct name or type is stored only once however many entities have it.
+ * Nothing is ever removed from a table, everything is released at once when the table is destroyed.
+ * So, the table must outlive all entities whose names are interned in it.
+ * Names and types of entities created while no table is current are owned by the entities themselves.
+ * @see CppCompound::symbolTable().
+ */
+class CppSymbolTable
+{
+public:
+  /**
+   * @brief Makes a table current on the calling thread for the lifetime of the scope object.
+   */
+  class Scope
+  {
+  public:
+    explicit Scope(CppSymbolTable& symbolTable);
+    ~Scope();
+
+    Scope(const Scope&)            = delete;
+    Scope& operator=(const Scope&) = delete;
+
+  private:
+    CppSymbolTable* prevSymbolTable_;
+  };
+
+  struct Stats
+  {
+    std::size_t numSymbols {0};       ///< Number of distinct strings.
+    std::size_t numInterned {0};      ///< Number of times strings were interned.
+    std::size_t bytesOfSymbols {0};   ///< Total size of distinct strings.
+    std::size_t bytesInterned {0};    ///< Total size of strings that were interned.
+    std::size_t numTypes {0};         ///< Number of distinct types.
+    std::size_t numTypesInterned {0}; ///< Number of times types were interned.
+  };
+
+public:
+  CppSymbolTable();
+  ~CppSymbolTable();
+
+  CppSymbolTable(const CppSymbolTable&)            = delete;
+  CppSymbolTable& operator=(const CppSymbolTable&) = delete;
+
+public:
+  /**
+   * @return Table that is current on the calling thread, nullptr if there is none.
+   */
+  static CppSymbolTable* current();
+  CppSymbol intern(std::string_view str);
+  /**
+   * @return The only type of this table that is equal to @a type.
+   * @note Base type of @a type is interned in this table too when it belongs to another table.
+   */
+  const CppInternedType* intern(const CppInternedType& type);
+
+  Stats stats() const;
+
+private:
+  struct Shard;
+
+  std::unique_ptr<Shard[]> shards_;
+};
+
+} // namespace cppast
+
+namespace std {
+
+template <>
+struct hash<cppast::CppSymbol>
+{
+  std::size_t operator()(const cppast::CppSymbol& symbol) const
+  {
+    return symbol.hash();
+  }
+};
+
+} // namespace std
+
+#endif /* E5107283_FCE0_4FCC_AA19_073B7006E5DE */
@@ -4,6 +4,8 @@
 #ifndef D94591D6_2473_4804_A403_3EF86D03DD28
 #define D94591D6_2473_4804_A403_3EF86D03DD28
 
+#include "cppast/helper/cpp_out_of_line.h"
+
 #include <optional>
 #include <vector>
 
@@ -27,7 +29,7 @@ public:
   void                                    templateSpecification(CppTemplateParams templateSpec);
 
 private:
-  std::optional<CppTemplateParams> templateSpec_;
+  helper::CppOutOfLine<std::optional<CppTemplateParams>> templateSpec_;
 };
 
 } // namespace cppast
@@ -0,0 +1,63 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef E37FD746_A0A5_4FBF_8F15_BD92D5B61ABC
+#define E37FD746_A0A5_4FBF_8F15_BD92D5B61ABC
+
+#include <string>
+#include <string_view>
+#include <variant>
+
+namespace cppast {
+
+/**
+ * @brief Text of an entity that is either owned by it or is a view into the source buffer.
+ *
+ * A view avoids copying big texts, like blobs, out of the source buffer.
+ * The source buffer is then kept alive by the file level compound, see CppCompound::sourceBuffer().
+ */
+class CppText
+{
+public:
+  CppText() = default;
+
+  CppText(std::string text)
+    : text_(std::move(text))
+  {
+  }
+
+  /**
+   * @warning The viewed text must outlive this object.
+   */
+  explicit CppText(std::string_view textView)
+    : text_(textView)
+  {
+  }
+
+public:
+  std::string_view str() const
+  {
+    return std::visit([](const auto& text) { return std::string_view(text); }, text_);
+  }
+
+  bool isView() const
+  {
+    return std::holds_alternative<std::string_view>(text_);
+  }
+
+  /**
+   * @return Part of the text which is owned if this text is owned, or a view otherwise.
+   */
+  CppText substr(size_t pos, size_t count = std::string_view::npos) const
+  {
+    const auto part = str().substr(pos, count);
+    return isView() ? CppText(part) : CppText(std::string(part));
+  }
+
+private:
+  std::variant<std::string, std::string_view> text_;
+};
+
+} // namespace cppast
+
+#endif /* E37FD746_A0A5_4FBF_8F15_BD92D5B61ABC */
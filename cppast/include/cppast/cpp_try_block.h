@@ -39,6 +39,16 @@ public:
   }
 
 public:
+  const CppCompound* tryStmt() const
+  {
+    return tryStmt_.get();
+  }
+
+  const CppCatchBlocks& catchBlocks() const
+  {
+    return catchBlocks_;
+  }
+
   void addCatchBlock(std::unique_ptr<CppCatchBlock> catchBlock)
   {
     catchBlocks_.emplace_back(std::move(catchBlock));
@@ -6,5 +6,6 @@
 
 #include "cppast/cpp_attribute_specifier_sequence_utility.h"
 #include "cppast/cpp_compound_utility.h"
+#include "cppast/cpp_recursive_ast_visitor.h"
 
 #endif /* DC8DD300_1A7D_4E6C_869C_F45415A07A05 */
@@ -7,6 +7,7 @@
 #include "cppast/cpp_entity.h"
 #include "cppast/cpp_templatable_entity.h"
 #include "cppast/cpp_var_decl.h"
+#include "cppast/helper/cpp_out_of_line.h"
 
 namespace cppast {
 
@@ -115,17 +116,17 @@ public:
 
   const std::string& apidecor() const
   {
-    return apidecor_;
+    return apidecor_.get();
   }
   void apidecor(std::string apidecorArg)
   {
-    apidecor_ = std::move(apidecorArg);
+    apidecor_.set(std::move(apidecorArg));
   }
 
 private:
-  std::unique_ptr<CppVarType> varType_;
-  CppVarDecl                  varDecl_;
-  std::string                 apidecor_; // It holds things like WINAPI, __declspec(dllexport), etc.
+  std::unique_ptr<CppVarType>       varType_;
+  CppVarDecl                        varDecl_;
+  helper::CppOutOfLine<std::string> apidecor_; // It holds things like WINAPI, __declspec(dllexport), etc.
 };
 
 } // namespace cppast
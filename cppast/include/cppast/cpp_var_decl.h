@@ -5,6 +5,8 @@
 #define FD128B15_4F2F_4742_A4B5_D3C91033195C
 
 #include "cppast/cpp_entity.h"
+#include "cppast/cpp_symbol.h"
+#include "cppast/helper/cpp_out_of_line.h"
 
 #include <cassert>
 #include <variant>
@@ -44,12 +46,12 @@ class CppVarDecl
 {
 public:
   CppVarDecl(std::string name)
-    : name_(std::move(name))
+    : name_(name)
   {
   }
 
   CppVarDecl(std::string name, CppVarInitInfo initInfo)
-    : name_(std::move(name))
+    : name_(name)
     , initInfo_(std::move(initInfo))
   {
   }
@@ -73,6 +75,10 @@ public:
   {
     return name_;
   }
+  const CppSymbol& nameSymbol() const
+  {
+    return name_;
+  }
 
   bool isInitialized() const
   {
@@ -122,19 +128,19 @@ public:
 
   const CppArraySizes& arraySizes() const
   {
-    return arraySizes_;
+    return arraySizes_.get();
   }
   void addArraySize(CppExpression* arraySize)
   {
-    arraySizes_.emplace_back(arraySize);
+    arraySizes_.getOrCreate().emplace_back(arraySize);
   }
 
 private:
-  std::string                   name_;
+  CppSymbol                     name_;
   std::optional<CppVarInitInfo> initInfo_;
 
-  std::unique_ptr<CppExpression> bitField_;
-  CppArraySizes                        arraySizes_;
+  std::unique_ptr<CppExpression>      bitField_;
+  helper::CppOutOfLine<CppArraySizes> arraySizes_;
 };
 
 } // namespace cppast
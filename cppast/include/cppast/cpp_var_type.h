@@ -6,6 +6,8 @@
 
 #include "cppast/cpp_enum.h"
 #include "cppast/cpp_function.h"
+#include "cppast/cpp_interned_type.h"
+#include "cppast/cpp_symbol.h"
 #include "cppast/cpp_type_modifier.h"
 #include "cppast/cpp_var_type.h"
 #include "cppast/cppconst.h"
@@ -21,74 +23,132 @@ class CppEnum;
  * @brief Models variable type in C++.
  *
  * It can be used to define a variable or function parameter.
+ * Base type, modifier, and attributes are kept in a CppInternedType that all equal types share.
+ * So, a CppVarType is just a few pointers and comparing two types is a pointer comparison.
+ * Modifying a type interns the modified type instead of changing the shared one.
  * @see CppVar.
  */
 class CppVarType : public CppAttributeSpecifierSequenceContainer
 {
+public:
+  /**
+   * @brief Modifier of a type that can be changed in place, e.g. `varType.typeModifier().ptrLevel_ = 1;`.
+   *
+   * Changed modifier is interned when this object is destroyed, i.e. at the end of the full expression,
+   * or at the end of the scope when it is bound to a reference, the shared type itself is never changed.
+   */
+  class ModifierRef
+  {
+  public:
+    explicit ModifierRef(CppVarType& varType);
+    ~ModifierRef();
+
+    ModifierRef(const ModifierRef&)            = delete;
+    ModifierRef& operator=(const ModifierRef&) = delete;
+
+    operator const CppTypeModifier&() const
+    {
+      return modifier_;
+    }
+
+  private:
+    CppVarType&     varType_;
+    CppTypeModifier modifier_;
+
+  public:
+    // Members are references so that they can be assigned even when this object is a temporary.
+    CppRefType&    refType_;
+    std::uint8_t&  ptrLevel_;
+    std::uint32_t& constBits_;
+  };
+
 public:
   CppVarType(std::string baseType, CppTypeModifier modifier);
   CppVarType(CppCompound* compound, CppTypeModifier modifier);
   CppVarType(CppFunctionPointer* fptr, CppTypeModifier modifier);
   CppVarType(CppEnum* enumObj, CppTypeModifier modifier);
+  /**
+   * @brief Copies base type, modifier, and attributes but not the type defined in place.
+   *
+   * The copy is interned in the table that is current on the calling thread, or owns its description when there
+   * is none. So, it does not depend on the table of @a varType and can outlive it.
+   */
   CppVarType(const CppVarType& varType);
+  ~CppVarType();
 
   const std::string& baseType() const
   {
-    return baseType_;
+    return type_->baseType;
   }
-  void baseType(std::string baseTypeArg)
+  const CppSymbol& baseTypeSymbol() const
   {
-    baseType_ = std::move(baseTypeArg);
+    return type_->baseType;
   }
+  void baseType(const std::string& baseTypeArg);
   const CppEntity* compound() const
   {
     return compound_.get();
   }
   std::uint32_t typeAttr() const
   {
-    return typeAttr_;
+    return type_->typeAttr;
   }
-  void typeAttr(std::uint32_t attr)
+  void typeAttr(std::uint32_t attr);
+  void addAttr(std::uint32_t attr);
+
+  const CppTypeModifier& typeModifier() const
   {
-    typeAttr_ = attr;
+    return type_->typeModifier;
   }
-  void addAttr(std::uint32_t attr)
+  /**
+   * @return Modifier that can be changed in place, the type is re-interned only when it is changed.
+   */
+  ModifierRef typeModifier()
   {
-    if ((attr & CppIdentifierAttrib::CONST) == 0)
-      typeAttr_ |= attr;
-    else
-      typeModifier_.constBits_ |= 1;
+    return ModifierRef(*this);
   }
+  void typeModifier(CppTypeModifier modifier);
 
-  const CppTypeModifier& typeModifier() const
+  void parameterPack(bool paramPack);
+
+  bool parameterPack() const
   {
-    return typeModifier_;
+    return type_->paramPack;
   }
 
-  CppTypeModifier& typeModifier()
+  /**
+   * @return Interned description of this type, equal types interned in the same table have the same object.
+   */
+  const CppInternedType& internedType() const
   {
-    return typeModifier_;
+    return *type_;
   }
 
-  void parameterPack(bool paramPack)
+  /**
+   * @brief Compares base types, modifiers, and attributes, which is just a pointer comparison for types of same table.
+   * @note A type defined in place, i.e. one that has compound(), is only equal to itself.
+   * Attribute specifier sequences are not compared.
+   */
+  friend bool operator==(const CppVarType& lhs, const CppVarType& rhs)
   {
-    paramPack_ = paramPack;
+    if (lhs.compound_ || rhs.compound_)
+      return &lhs == &rhs;
+    return (lhs.type_ == rhs.type_) || (*lhs.type_ == *rhs.type_);
   }
 
-  bool parameterPack() const
+  friend bool operator!=(const CppVarType& lhs, const CppVarType& rhs)
   {
-    return paramPack_;
+    return !(lhs == rhs);
   }
 
 private:
-  CppVarType(std::string baseType, std::uint32_t typeAttr, CppTypeModifier modifier);
+  CppVarType(CppInternedType type, CppEntity* compound);
+
+  void intern(const CppInternedType& type);
 
 private:
-  std::string baseType_; // This is the basic data type of var e.g. for 'const int*& pi' base-type is int.
+  const CppInternedType*     type_ {nullptr};
   std::unique_ptr<CppEntity> compound_;
-  CppTypeModifier            typeModifier_;
-  std::uint32_t              typeAttr_ {0};
-  bool                       paramPack_ {false};
 };
 
 } // namespace cppast
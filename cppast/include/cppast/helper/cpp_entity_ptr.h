@@ -4,10 +4,118 @@
 #ifndef B3AB0DD0_7FBB_4455_8B74_3DB850581596
 #define B3AB0DD0_7FBB_4455_8B74_3DB850581596
 
+#include "cppast/cpp_expression.h"
+#include "cppast/cpp_preprocessor.h"
+
 #include <type_traits>
 
 namespace cppast::helper {
 
+template <typename T, typename = void>
+struct HasEntityTag : std::false_type
+{
+};
+template <typename T>
+struct HasEntityTag<T, std::void_t<decltype(T::EntityType())>> : std::is_base_of<CppEntity, T>
+{
+};
+
+template <typename T, typename = void>
+struct HasExpressionTag : std::false_type
+{
+};
+template <typename T>
+struct HasExpressionTag<T, std::void_t<decltype(T::ExpressionType())>> : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct HasAtomicExprTag : std::false_type
+{
+};
+template <typename T>
+struct HasAtomicExprTag<T, std::void_t<decltype(T::AtomicExprType())>> : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct HasTypecastTag : std::false_type
+{
+};
+template <typename T>
+struct HasTypecastTag<T, std::void_t<decltype(T::TypecastType())>> : std::true_type
+{
+};
+
+template <typename T, typename = void>
+struct HasPreprocessorTag : std::false_type
+{
+};
+template <typename T>
+struct HasPreprocessorTag<T, std::void_t<decltype(T::PreprocessorType())>> : std::true_type
+{
+};
+
+/**
+ * @brief Checks type tags that entities already carry instead of asking RTTI.
+ *
+ * Entity type identifies the class of an entity, except for expressions and preprocessors whose classes are further
+ * identified by expression type, and then by atomic expression type or typecast type, and by preprocessor type.
+ * A class matches the tags of all of its derived classes because it inherits the static tag functions of its bases
+ * and has no tag of its own at the levels below it.
+ *
+ * @return true if @a entity is an instance of T.
+ */
+template <typename T>
+bool IsEntityOf(const CppEntity& entity)
+{
+  using Class = std::remove_const_t<T>;
+
+  if constexpr (std::is_same_v<Class, CppEntity>)
+  {
+    return true;
+  }
+  else
+  {
+    static_assert(HasEntityTag<Class>::value, "Class must have type tag");
+
+    if (entity.entityType() != Class::EntityType())
+      return false;
+
+    if constexpr (HasExpressionTag<Class>::value)
+    {
+      const auto& expr = static_cast<const CppExpression&>(entity);
+      if (expr.expressionType() != Class::ExpressionType())
+        return false;
+      if constexpr (HasAtomicExprTag<Class>::value)
+        return static_cast<const CppAtomicExpr&>(expr).atomicExpressionType() == Class::AtomicExprType();
+      if constexpr (HasTypecastTag<Class>::value)
+        return static_cast<const CppTypecastExpr&>(expr).castType() == Class::TypecastType();
+    }
+    if constexpr (HasPreprocessorTag<Class>::value)
+      return static_cast<const CppPreprocessor&>(entity).preprocessorType() == Class::PreprocessorType();
+
+    return true;
+  }
+}
+
+/**
+ * @brief Casts @a entityPtr to T* if it points to an instance of T, and returns nullptr otherwise.
+ *
+ * It costs a few comparisons of type tags for classes that have them.
+ * Rest of the classes, e.g. CppVarType which is not an entity, fall back to dynamic_cast.
+ */
+template <typename T, typename EntityT>
+T* EntityCast(EntityT* entityPtr)
+{
+  static_assert(std::is_same_v<std::remove_const_t<EntityT>, CppEntity>);
+
+  if constexpr (HasEntityTag<std::remove_const_t<T>>::value || std::is_same_v<std::remove_const_t<T>, CppEntity>)
+    return (entityPtr && IsEntityOf<T>(*entityPtr)) ? static_cast<T*>(entityPtr) : nullptr;
+  else
+    return dynamic_cast<T*>(entityPtr);
+}
+
 /**
  * @brief A convinient class to work with CppEntity derived classes.
  *
@@ -25,13 +133,15 @@ public:
   }
 
   CppEntityPtr(CppEntity* entityPtr)
-    : ptr_(dynamic_cast<T*>(entityPtr))
+    : ptr_(EntityCast<T>(entityPtr))
   {
   }
 
   CppEntityPtr(const CppEntity* entityPtr)
-    : ptr_(std::is_const_v<T> ? dynamic_cast<T*>(entityPtr) : nullptr)
+    : ptr_(nullptr)
   {
+    if constexpr (std::is_const_v<T>)
+      ptr_ = EntityCast<T>(entityPtr);
   }
 
   template <typename U>
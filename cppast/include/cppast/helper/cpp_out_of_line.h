@@ -0,0 +1,74 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef B2190B67_6AF9_4C38_A89D_0B5114681E3C
+#define B2190B67_6AF9_4C38_A89D_0B5114681E3C
+
+#include <memory>
+#include <type_traits>
+#include <utility>
+
+namespace cppast::helper {
+
+template <typename T, typename = void>
+struct HasEmpty : std::false_type
+{
+};
+template <typename T>
+struct HasEmpty<T, std::void_t<decltype(std::declval<const T&>().empty())>> : std::true_type
+{
+};
+
+/**
+ * @brief Keeps a field that most entities do not have out of line, so that it costs just a pointer when absent.
+ *
+ * An absent field reads as a default constructed T.
+ */
+template <typename T>
+class CppOutOfLine
+{
+public:
+  bool has() const
+  {
+    return value_ != nullptr;
+  }
+
+  const T& get() const
+  {
+    static const T kAbsent {};
+    return value_ ? *value_ : kAbsent;
+  }
+
+  /**
+   * @return The field, it is allocated if it is absent.
+   */
+  T& getOrCreate()
+  {
+    if (!value_)
+      value_ = std::make_unique<T>();
+    return *value_;
+  }
+
+  /**
+   * @brief Stores @a value, an empty string or container is not allocated for.
+   */
+  void set(T value)
+  {
+    if constexpr (HasEmpty<T>::value)
+    {
+      if (value.empty())
+      {
+        value_.reset();
+        return;
+      }
+    }
+    value_ = std::make_unique<T>(std::move(value));
+  }
+
+private:
+  std::unique_ptr<T> value_;
+};
+
+} // namespace cppast::helper
+
+#endif /* B2190B67_6AF9_4C38_A89D_0B5114681E3C */
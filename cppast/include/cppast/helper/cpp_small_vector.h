@@ -0,0 +1,323 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef BE85D345_B950_4DB5_A8F8_984408909B9D
+#define BE85D345_B950_4DB5_A8F8_984408909B9D
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
+#include <utility>
+
+namespace cppast::helper {
+
+template <typename T, std::size_t N>
+struct CppSmallVectorStorage
+{
+  T* inlineData() const
+  {
+    return reinterpret_cast<T*>(const_cast<unsigned char*>(buffer_));
+  }
+
+  alignas(T) unsigned char buffer_[N * sizeof(T)];
+};
+
+// Without inline capacity the storage is empty and costs nothing.
+template <typename T>
+struct CppSmallVectorStorage<T, 0>
+{
+  T* inlineData() const
+  {
+    return nullptr;
+  }
+};
+
+/**
+ * @brief Contiguous container that keeps up to N elements inline and moves to heap only when it outgrows them.
+ *
+ * It is meant for short lists of AST, e.g. base classes, which mostly have just a few elements.
+ * So, a list of up to N elements costs no allocation and its elements are next to each other.
+ * Iteration is same as that of standard containers, iterators are just pointers.
+ * @warning Unlike std::list, adding an element can move the existing ones, and so invalidate iterators to them.
+ */
+template <typename T, std::size_t N>
+class CppSmallVector : private CppSmallVectorStorage<T, N>
+{
+  using Storage = CppSmallVectorStorage<T, N>;
+
+public:
+  using value_type             = T;
+  using size_type              = std::size_t;
+  using difference_type        = std::ptrdiff_t;
+  using reference              = T&;
+  using const_reference        = const T&;
+  using pointer                = T*;
+  using const_pointer          = const T*;
+  using iterator               = T*;
+  using const_iterator         = const T*;
+  using reverse_iterator       = std::reverse_iterator<iterator>;
+  using const_reverse_iterator = std::reverse_iterator<const_iterator>;
+
+public:
+  CppSmallVector()
+    : data_(Storage::inlineData())
+  {
+  }
+
+  CppSmallVector(std::initializer_list<T> items)
+    : CppSmallVector()
+  {
+    reserve(items.size());
+    for (const auto& item : items)
+      push_back(item);
+  }
+
+  CppSmallVector(const CppSmallVector& other)
+    : CppSmallVector()
+  {
+    reserve(other.size());
+    for (const auto& item : other)
+      push_back(item);
+  }
+
+  CppSmallVector(CppSmallVector&& other) noexcept
+    : CppSmallVector()
+  {
+    takeFrom(other);
+  }
+
+  ~CppSmallVector()
+  {
+    clear();
+    release();
+  }
+
+  CppSmallVector& operator=(const CppSmallVector& other)
+  {
+    if (this != &other)
+    {
+      CppSmallVector copy(other);
+      *this = std::move(copy);
+    }
+    return *this;
+  }
+
+  CppSmallVector& operator=(CppSmallVector&& other) noexcept
+  {
+    if (this != &other)
+    {
+      clear();
+      release();
+      data_     = Storage::inlineData();
+      capacity_ = N;
+      takeFrom(other);
+    }
+    return *this;
+  }
+
+public:
+  iterator begin()
+  {
+    return data_;
+  }
+  iterator end()
+  {
+    return data_ + size_;
+  }
+  const_iterator begin() const
+  {
+    return data_;
+  }
+  const_iterator end() const
+  {
+    return data_ + size_;
+  }
+  const_iterator cbegin() const
+  {
+    return begin();
+  }
+  const_iterator cend() const
+  {
+    return end();
+  }
+  reverse_iterator rbegin()
+  {
+    return reverse_iterator(end());
+  }
+  reverse_iterator rend()
+  {
+    return reverse_iterator(begin());
+  }
+  const_reverse_iterator rbegin() const
+  {
+    return const_reverse_iterator(end());
+  }
+  const_reverse_iterator rend() const
+  {
+    return const_reverse_iterator(begin());
+  }
+
+  size_type size() const
+  {
+    return size_;
+  }
+  bool empty() const
+  {
+    return size_ == 0;
+  }
+  size_type capacity() const
+  {
+    return capacity_;
+  }
+  /**
+   * @return true if elements are in the inline storage.
+   */
+  bool isInline() const
+  {
+    return data_ == Storage::inlineData();
+  }
+
+  T* data()
+  {
+    return data_;
+  }
+  const T* data() const
+  {
+    return data_;
+  }
+
+  T& operator[](size_type idx)
+  {
+    return data_[idx];
+  }
+  const T& operator[](size_type idx) const
+  {
+    return data_[idx];
+  }
+  T& front()
+  {
+    return data_[0];
+  }
+  const T& front() const
+  {
+    return data_[0];
+  }
+  T& back()
+  {
+    return data_[size_ - 1];
+  }
+  const T& back() const
+  {
+    return data_[size_ - 1];
+  }
+
+  void reserve(size_type newCapacity)
+  {
+    if (newCapacity > capacity_)
+      reallocate(newCapacity);
+  }
+
+  template <typename... Args>
+  T& emplace_back(Args&&... args)
+  {
+    if (size_ < capacity_)
+    {
+      auto* item = ::new (static_cast<void*>(data_ + size_)) T(std::forward<Args>(args)...);
+      ++size_;
+      return *item;
+    }
+
+    // New element is constructed before existing ones are moved because args can refer to one of them.
+    const auto newCapacity = std::max<size_type>(size_type(capacity_) * 2, 4);
+    auto*      newData     = std::allocator<T>().allocate(newCapacity);
+    auto*      item        = ::new (static_cast<void*>(newData + size_)) T(std::forward<Args>(args)...);
+    moveTo(newData, newCapacity);
+    ++size_;
+    return *item;
+  }
+
+  void push_back(const T& item)
+  {
+    emplace_back(item);
+  }
+  void push_back(T&& item)
+  {
+    emplace_back(std::move(item));
+  }
+
+  void pop_back()
+  {
+    --size_;
+    data_[size_].~T();
+  }
+
+  void clear()
+  {
+    std::destroy(begin(), end());
+    size_ = 0;
+  }
+
+  friend bool operator==(const CppSmallVector& lhs, const CppSmallVector& rhs)
+  {
+    return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+  }
+  friend bool operator!=(const CppSmallVector& lhs, const CppSmallVector& rhs)
+  {
+    return !(lhs == rhs);
+  }
+
+private:
+  void reallocate(size_type newCapacity)
+  {
+    moveTo(std::allocator<T>().allocate(newCapacity), newCapacity);
+  }
+
+  // Moves elements to newData, which must not have any element yet, and releases the current heap storage.
+  void moveTo(T* newData, size_type newCapacity)
+  {
+    std::uninitialized_move(begin(), end(), newData);
+    std::destroy(begin(), end());
+    release();
+    data_     = newData;
+    capacity_ = static_cast<std::uint32_t>(newCapacity);
+  }
+
+  void release()
+  {
+    if (!isInline())
+      std::allocator<T>().deallocate(data_, capacity_);
+  }
+
+  // Takes elements of other, which must be empty afterwards, this must be empty and inline.
+  void takeFrom(CppSmallVector& other)
+  {
+    if (other.isInline())
+    {
+      std::uninitialized_move(other.begin(), other.end(), data_);
+      size_ = other.size_;
+      other.clear();
+    }
+    else
+    {
+      data_           = other.data_;
+      size_           = other.size_;
+      capacity_       = other.capacity_;
+      other.data_     = other.inlineData();
+      other.size_     = 0;
+      other.capacity_ = N;
+    }
+  }
+
+private:
+  T*            data_;
+  std::uint32_t size_ {0};
+  std::uint32_t capacity_ {N};
+};
+
+} // namespace cppast::helper
+
+#endif /* BE85D345_B950_4DB5_A8F8_984408909B9D */
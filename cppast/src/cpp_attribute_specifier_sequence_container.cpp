@@ -12,7 +12,10 @@ CppAttributeSpecifierSequenceContainer::~CppAttributeSpecifierSequenceContainer(
 void CppAttributeSpecifierSequenceContainer::attribSpecifierSequence(
   CppAttributeSpecifierSequence attribSpecifierSequence)
 {
-  attribSpecifierSequence_ = std::move(attribSpecifierSequence);
+  if (attribSpecifierSequence.empty())
+    attribSpecifierSequence_.reset();
+  else
+    attribSpecifierSequence_ = std::make_unique<CppAttributeSpecifierSequence>(std::move(attribSpecifierSequence));
 }
 
 void CppAttributeSpecifierSequenceContainer::visitAll(
@@ -27,7 +30,10 @@ void CppAttributeSpecifierSequenceContainer::visitAll(
 bool CppAttributeSpecifierSequenceContainer::visit(
   const std::function<bool(const CppExpression& attributeSpecifier)>& callback) const
 {
-  for (const auto& specifier : attribSpecifierSequence_)
+  if (!attribSpecifierSequence_)
+    return true;
+
+  for (const auto& specifier : *attribSpecifierSequence_)
   {
     if (!callback(*specifier))
     {
@@ -50,7 +56,10 @@ void CppAttributeSpecifierSequenceContainer::visitAll(
 bool CppAttributeSpecifierSequenceContainer::visit(
   const std::function<bool(CppExpression& attributeSpecifier)>& callback)
 {
-  for (const auto& specifier : attribSpecifierSequence_)
+  if (!attribSpecifierSequence_)
+    return true;
+
+  for (const auto& specifier : *attribSpecifierSequence_)
   {
     if (!callback(*specifier))
     {
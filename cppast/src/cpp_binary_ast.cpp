@@ -0,0 +1,1264 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_binary_ast.h"
+#include "cppast/cppast.h"
+
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+// Layout of binary AST:
+//  - Magic bytes followed by version as varint.
+//  - The root compound.
+// Integers, including enums, are LEB128 varints and strings are length prefixed.
+// An entity, which can be null, is written as its type plus 1, 0 for null, followed by its attribute specifiers and
+// then its own data in the order its constructor takes them.
+
+namespace cppast {
+
+namespace {
+
+constexpr std::string_view kMagic("CPPAST\x1A\n", 8);
+
+class BinaryAstWriter
+{
+public:
+  std::string write(const CppCompound& ast)
+  {
+    out_.append(kMagic);
+    varint(kBinaryAstVersion);
+    entity(&ast);
+
+    return std::move(out_);
+  }
+
+private:
+  void varint(std::uint64_t value)
+  {
+    for (; value >= 0x80; value >>= 7)
+      out_.push_back(static_cast<char>((value & 0x7F) | 0x80));
+    out_.push_back(static_cast<char>(value));
+  }
+
+  template <typename EnumType>
+  void enumValue(EnumType value)
+  {
+    varint(static_cast<std::uint64_t>(value));
+  }
+
+  void flag(bool value)
+  {
+    out_.push_back(value ? 1 : 0);
+  }
+
+  void str(std::string_view value)
+  {
+    varint(value.size());
+    out_.append(value);
+  }
+
+  void attribSpecifierSequence(const CppAttributeSpecifierSequenceContainer& container)
+  {
+    std::vector<const CppExpression*> attribs;
+    container.visitAll([&attribs](const CppExpression& attrib) { attribs.push_back(&attrib); });
+    varint(attribs.size());
+    for (const auto* attrib : attribs)
+      entity(attrib);
+  }
+
+  void templateSpecification(const CppTemplatableEntity& templatable)
+  {
+    const auto& templateSpec = templatable.templateSpecification();
+    flag(templateSpec.has_value());
+    if (!templateSpec)
+      return;
+
+    varint(templateSpec->size());
+    for (const auto& param : *templateSpec)
+    {
+      const auto& paramType = param.paramType();
+      flag(paramType.has_value());
+      if (paramType)
+      {
+        varint(paramType->index());
+        if (const auto* varTypeParam = std::get_if<std::unique_ptr<CppVarType>>(&*paramType))
+          varType(varTypeParam->get());
+        else
+          entity(std::get<std::unique_ptr<CppFunctionPointer>>(*paramType).get());
+      }
+      str(param.paramName());
+      const auto& defaultArg = param.defaultArg();
+      varint(defaultArg.index());
+      if (const auto* varTypeArg = std::get_if<std::unique_ptr<CppVarType>>(&defaultArg))
+        varType(varTypeArg->get());
+      else
+        entity(std::get<std::unique_ptr<CppExpression>>(defaultArg).get());
+    }
+  }
+
+  void typeModifier(const CppTypeModifier& modifier)
+  {
+    enumValue(modifier.refType_);
+    varint(modifier.ptrLevel_);
+    varint(modifier.constBits_);
+  }
+
+  void varType(const CppVarType* type)
+  {
+    flag(type != nullptr);
+    if (!type)
+      return;
+
+    attribSpecifierSequence(*type);
+    entity(type->compound());
+    str(type->baseType());
+    typeModifier(type->typeModifier());
+    varint(type->typeAttr());
+    flag(type->parameterPack());
+  }
+
+  template <typename Container>
+  void entities(const Container& container)
+  {
+    varint(container.size());
+    for (const auto& item : container)
+      entity(item.get());
+  }
+
+  void callArgs(const CppCallArgs& args, CppConstructorCallStyle style)
+  {
+    entities(args);
+    enumValue(style);
+  }
+
+  void varDecl(const CppVarDecl& decl)
+  {
+    str(decl.name());
+    const auto initType = decl.initializeType();
+    varint(initType ? static_cast<std::uint64_t>(*initType) + 1 : 0);
+    if (initType == CppVarInitializeType::USING_EQUAL)
+      entity(decl.assignValue());
+    else if (initType == CppVarInitializeType::DIRECT_CONSTRUCTOR_CALL)
+      callArgs(decl.constructorCallArgs(), decl.directConstructorCallStyle());
+    entity(decl.bitField());
+    entities(decl.arraySizes());
+  }
+
+  void params(const CppFuncOrCtorCommon& func)
+  {
+    std::vector<const CppEntity*> allParams;
+    func.visitAllParams([&allParams](const CppEntity& param) { allParams.push_back(&param); });
+    varint(allParams.size());
+    for (const auto* param : allParams)
+      entity(param);
+  }
+
+  void functionCommon(const CppFunctionCommon& func)
+  {
+    varint(func.attr());
+    str(func.decor1());
+    str(func.decor2());
+    varint(func.throwSpec().size());
+    for (const auto& exception : func.throwSpec())
+      str(exception);
+    entity(func.defn());
+    templateSpecification(func);
+  }
+
+  void compound(const CppCompound& cmpd)
+  {
+    str(cmpd.name());
+    enumValue(cmpd.compoundType());
+    str(cmpd.apidecor());
+    varint(cmpd.inheritanceList().size());
+    for (const auto& inheritance : cmpd.inheritanceList())
+    {
+      str(inheritance.baseName);
+      flag(inheritance.inhType.has_value());
+      if (inheritance.inhType)
+        enumValue(*inheritance.inhType);
+      flag(inheritance.isVirtual);
+    }
+    varint(cmpd.attr());
+    templateSpecification(cmpd);
+
+    std::vector<const CppEntity*> members;
+    cmpd.visitAll([&members](const CppEntity& member) {
+      members.push_back(&member);
+      return true;
+    });
+    varint(members.size());
+    for (const auto* member : members)
+      entity(member);
+  }
+
+  void expression(const CppExpression& expr)
+  {
+    enumValue(expr.expressionType());
+    switch (expr.expressionType())
+    {
+      case CppExpressionType::ATOMIC:
+      {
+        const auto& atomicExpr = static_cast<const CppAtomicExpr&>(expr);
+        enumValue(atomicExpr.atomicExpressionType());
+        switch (atomicExpr.atomicExpressionType())
+        {
+          case CppAtomicExprType::STRING_LITERAL:
+            return str(static_cast<const CppStringLiteralExpr&>(expr).value());
+          case CppAtomicExprType::CHAR_LITERAL:
+            return str(static_cast<const CppCharLiteralExpr&>(expr).value());
+          case CppAtomicExprType::NUMBER_LITEREL:
+            return str(static_cast<const CppNumberLiteralExpr&>(expr).value());
+          case CppAtomicExprType::NAME:
+            return str(static_cast<const CppNameExpr&>(expr).value());
+          case CppAtomicExprType::VARTYPE:
+            return varType(&static_cast<const CppVartypeExpr&>(expr).value());
+          case CppAtomicExprType::LAMBDA:
+            return entity(&static_cast<const CppLambdaExpr&>(expr).lamda());
+        }
+        break;
+      }
+      case CppExpressionType::MONOMIAL:
+      {
+        const auto& monomial = static_cast<const CppMonomialExpr&>(expr);
+        enumValue(monomial.oper());
+        return entity(&monomial.term());
+      }
+      case CppExpressionType::BINOMIAL:
+      {
+        const auto& binomial = static_cast<const CppBinomialExpr&>(expr);
+        enumValue(binomial.oper());
+        entity(&binomial.term1());
+        return entity(&binomial.term2());
+      }
+      case CppExpressionType::TRINOMIAL:
+      {
+        const auto& trinomial = static_cast<const CppTrinomialExpr&>(expr);
+        enumValue(trinomial.oper());
+        entity(&trinomial.term1());
+        entity(&trinomial.term2());
+        return entity(&trinomial.term3());
+      }
+      case CppExpressionType::FUNCTION_CALL:
+      {
+        const auto& funcCall = static_cast<const CppFunctionCallExpr&>(expr);
+        entity(&funcCall.function());
+        varint(funcCall.numArgs());
+        for (size_t i = 0; i < funcCall.numArgs(); ++i)
+          entity(&funcCall.arg(i));
+        return;
+      }
+      case CppExpressionType::UNIFORM_INITIALIZER:
+      {
+        const auto& uniformInit = static_cast<const CppUniformInitializerExpr&>(expr);
+        str(uniformInit.name());
+        varint(uniformInit.numArgs());
+        for (size_t i = 0; i < uniformInit.numArgs(); ++i)
+          entity(&uniformInit.arg(i));
+        return;
+      }
+      case CppExpressionType::INITIALIZER_LIST:
+      {
+        const auto& initList = static_cast<const CppInitializerListExpr&>(expr);
+        varint(initList.numArgs());
+        for (size_t i = 0; i < initList.numArgs(); ++i)
+          entity(&initList.arg(i));
+        return;
+      }
+      case CppExpressionType::TYPECAST:
+      {
+        const auto& typecast = static_cast<const CppTypecastExpr&>(expr);
+        enumValue(typecast.castType());
+        varType(&typecast.targetType());
+        return entity(&typecast.inputExpresion());
+      }
+    }
+
+    throw std::invalid_argument("Binary AST cannot represent the expression");
+  }
+
+  void preprocessor(const CppPreprocessor& prepro)
+  {
+    enumValue(prepro.preprocessorType());
+    switch (prepro.preprocessorType())
+    {
+      case CppPreprocessorType::DEFINE:
+      {
+        const auto& define = static_cast<const CppPreprocessorDefine&>(prepro);
+        enumValue(define.definitionType());
+        str(define.name());
+        return str(define.definitionView());
+      }
+      case CppPreprocessorType::UNDEF:
+        return str(static_cast<const CppPreprocessorUndef&>(prepro).name());
+      case CppPreprocessorType::CONDITIONAL:
+      {
+        const auto& conditional = static_cast<const CppPreprocessorConditional&>(prepro);
+        enumValue(conditional.conditionalType());
+        return str(conditional.condition());
+      }
+      case CppPreprocessorType::INCLUDE:
+        return str(static_cast<const CppPreprocessorInclude&>(prepro).name());
+      case CppPreprocessorType::IMPORT:
+        return str(static_cast<const CppPreprocessorImport&>(prepro).name());
+      case CppPreprocessorType::WARNING:
+        return str(static_cast<const CppPreprocessorWarning&>(prepro).warning());
+      case CppPreprocessorType::ERROR:
+        return str(static_cast<const CppPreprocessorError&>(prepro).error());
+      case CppPreprocessorType::PRAGMA:
+        return str(static_cast<const CppPreprocessorPragma&>(prepro).definition());
+      case CppPreprocessorType::UNRECOGNIZED:
+      {
+        const auto& unrecognized = static_cast<const CppPreprocessorUnrecognized&>(prepro);
+        str(unrecognized.name());
+        return str(unrecognized.definition());
+      }
+      case CppPreprocessorType::LINE:
+        break;
+    }
+
+    throw std::invalid_argument("Binary AST cannot represent the preprocessor");
+  }
+
+  void entity(const CppEntity* ent)
+  {
+    varint(ent ? static_cast<std::uint64_t>(ent->entityType()) + 1 : 0);
+    if (!ent)
+      return;
+
+    attribSpecifierSequence(*ent);
+    switch (ent->entityType())
+    {
+      case CppEntityType::DOCUMENTATION_COMMENT:
+        return str(static_cast<const CppDocumentationComment*>(ent)->strView());
+      case CppEntityType::PREPROCESSOR:
+        return preprocessor(*static_cast<const CppPreprocessor*>(ent));
+      case CppEntityType::ENTITY_ACCESS_SPECIFIER:
+        return enumValue(static_cast<const CppEntityAccessSpecifier*>(ent)->type());
+      case CppEntityType::COMPOUND:
+        return compound(*static_cast<const CppCompound*>(ent));
+      case CppEntityType::VAR:
+      {
+        const auto* var = static_cast<const CppVar*>(ent);
+        varType(&var->varType());
+        varDecl(var->varDecl());
+        str(var->apidecor());
+        return templateSpecification(*var);
+      }
+      case CppEntityType::VAR_LIST:
+      {
+        const auto* varList = static_cast<const CppVarList*>(ent);
+        entity(varList->firstVar().get());
+        varint(varList->varDeclList().size());
+        for (const auto& decl : varList->varDeclList())
+        {
+          typeModifier(decl);
+          varDecl(decl);
+        }
+        return;
+      }
+      case CppEntityType::TYPEDEF_DECL:
+        return entity(static_cast<const CppTypedefName*>(ent)->var());
+      case CppEntityType::TYPEDEF_DECL_LIST:
+        return entity(&static_cast<const CppTypedefList*>(ent)->varList());
+      case CppEntityType::NAMESPACE_ALIAS:
+      {
+        const auto* alias = static_cast<const CppNamespaceAlias*>(ent);
+        str(alias->name());
+        return str(alias->alias());
+      }
+      case CppEntityType::USING_NAMESPACE:
+        return str(static_cast<const CppUsingNamespaceDecl*>(ent)->name());
+      case CppEntityType::USING_DECL:
+      {
+        const auto* usingDecl = static_cast<const CppUsingDecl*>(ent);
+        str(usingDecl->name());
+        const auto& defn = usingDecl->definition();
+        varint(defn.index());
+        if (const auto* varTypeDefn = std::get_if<std::unique_ptr<CppVarType>>(&defn))
+          varType(varTypeDefn->get());
+        else if (const auto* funcPtrDefn = std::get_if<std::unique_ptr<CppFunctionPointer>>(&defn))
+          entity(funcPtrDefn->get());
+        else
+          entity(std::get<std::unique_ptr<CppCompound>>(defn).get());
+        return templateSpecification(*usingDecl);
+      }
+      case CppEntityType::ENUM:
+      {
+        const auto* enumObj = static_cast<const CppEnum*>(ent);
+        str(enumObj->name());
+        flag(enumObj->isClass());
+        str(enumObj->underlyingType());
+        varint(enumObj->itemList().size());
+        for (const auto& item : enumObj->itemList())
+        {
+          flag(item.isNonConstEntity());
+          if (item.isNonConstEntity())
+          {
+            entity(item.nonConstEntity());
+          }
+          else
+          {
+            str(item.name());
+            entity(item.val());
+          }
+        }
+        return;
+      }
+      case CppEntityType::FORWARD_CLASS_DECL:
+      {
+        const auto* fwdDecl = static_cast<const CppForwardClassDecl*>(ent);
+        str(fwdDecl->name());
+        str(fwdDecl->apidecor());
+        enumValue(fwdDecl->compoundType());
+        varint(fwdDecl->attr());
+        return templateSpecification(*fwdDecl);
+      }
+      case CppEntityType::FUNCTION:
+      {
+        const auto* func = static_cast<const CppFunction*>(ent);
+        str(func->name());
+        varType(func->returnType());
+        params(*func);
+        return functionCommon(*func);
+      }
+      case CppEntityType::LAMBDA:
+      {
+        const auto* lambda = static_cast<const CppLambda*>(ent);
+        entity(lambda->captures());
+        entities(lambda->params());
+        varType(lambda->returnType());
+        return entity(lambda->defn());
+      }
+      case CppEntityType::CONSTRUCTOR:
+      {
+        const auto* ctor = static_cast<const CppConstructor*>(ent);
+        str(ctor->name());
+        params(*ctor);
+        flag(ctor->hasMemberInitList());
+        if (ctor->hasMemberInitList())
+        {
+          varint(ctor->memberInits().size());
+          for (const auto& memInit : ctor->memberInits())
+          {
+            str(memInit.memberName);
+            callArgs(memInit.memberInitInfo.args, memInit.memberInitInfo.style);
+          }
+        }
+        return functionCommon(*ctor);
+      }
+      case CppEntityType::DESTRUCTOR:
+      {
+        const auto* dtor = static_cast<const CppDestructor*>(ent);
+        str(dtor->name());
+        return functionCommon(*dtor);
+      }
+      case CppEntityType::TYPE_CONVERTER:
+      {
+        const auto* converter = static_cast<const CppTypeConverter*>(ent);
+        varType(converter->targetType());
+        str(converter->name());
+        return functionCommon(*converter);
+      }
+      case CppEntityType::FUNCTION_PTR:
+      {
+        const auto* funcPtr = static_cast<const CppFunctionPointer*>(ent);
+        str(funcPtr->name());
+        varType(funcPtr->returnType());
+        params(*funcPtr);
+        str(funcPtr->ownerName());
+        return functionCommon(*funcPtr);
+      }
+      case CppEntityType::EXPRESSION:
+        return expression(*static_cast<const CppExpression*>(ent));
+      case CppEntityType::GOTO_STATEMENT:
+        return entity(&static_cast<const CppGotoStatement*>(ent)->label());
+      case CppEntityType::RETURN_STATEMENT:
+      {
+        const auto* ret = static_cast<const CppReturnStatement*>(ent);
+        return entity(ret->hasReturnValue() ? &ret->returnValue() : nullptr);
+      }
+      case CppEntityType::THROW_STATEMENT:
+      {
+        const auto* throwStmt = static_cast<const CppThrowStatement*>(ent);
+        return entity(throwStmt->hasException() ? &throwStmt->exception() : nullptr);
+      }
+      case CppEntityType::MACRO_CALL:
+        return str(static_cast<const CppMacroCall*>(ent)->macroCall());
+      case CppEntityType::ASM_BLOCK:
+        return str(static_cast<const CppAsmBlock*>(ent)->code());
+      case CppEntityType::LABEL:
+        return str(static_cast<const CppLabel*>(ent)->label());
+      case CppEntityType::IF_BLOCK:
+      {
+        const auto* ifBlock = static_cast<const CppIfBlock*>(ent);
+        entity(ifBlock->condition());
+        entity(ifBlock->body());
+        return entity(ifBlock->elsePart());
+      }
+      case CppEntityType::FOR_BLOCK:
+      {
+        const auto* forBlock = static_cast<const CppForBlock*>(ent);
+        entity(forBlock->start());
+        entity(forBlock->stop());
+        entity(forBlock->step());
+        return entity(forBlock->body());
+      }
+      case CppEntityType::RANGE_FOR_BLOCK:
+      {
+        const auto* rangeFor = static_cast<const CppRangeForBlock*>(ent);
+        entity(rangeFor->var());
+        entity(rangeFor->expr());
+        return entity(rangeFor->body());
+      }
+      case CppEntityType::WHILE_BLOCK:
+      {
+        const auto* whileBlock = static_cast<const CppWhileBlock*>(ent);
+        entity(whileBlock->condition());
+        return entity(whileBlock->body());
+      }
+      case CppEntityType::DO_WHILE_BLOCK:
+      {
+        const auto* doWhileBlock = static_cast<const CppDoWhileBlock*>(ent);
+        entity(doWhileBlock->condition());
+        return entity(doWhileBlock->body());
+      }
+      case CppEntityType::SWITCH_BLOCK:
+      {
+        const auto* switchBlock = static_cast<const CppSwitchBlock*>(ent);
+        entity(switchBlock->condition());
+        varint(switchBlock->body().size());
+        for (const auto& switchCase : switchBlock->body())
+        {
+          entity(switchCase.caseExpr());
+          entity(switchCase.body());
+        }
+        return;
+      }
+      case CppEntityType::TRY_BLOCK:
+      {
+        const auto* tryBlock = static_cast<const CppTryBlock*>(ent);
+        entity(tryBlock->tryStmt());
+        varint(tryBlock->catchBlocks().size());
+        for (const auto& catchBlock : tryBlock->catchBlocks())
+        {
+          varType(catchBlock->exceptionType_.get());
+          str(catchBlock->exceptionName_);
+          entity(catchBlock->catchStmt_.get());
+        }
+        return;
+      }
+      case CppEntityType::BLOB:
+        return str(static_cast<const CppBlob*>(ent)->blobView());
+    }
+
+    throw std::invalid_argument("Binary AST cannot represent the entity");
+  }
+
+private:
+  std::string out_;
+};
+
+/**
+ * Thrown when the data being read is not a valid binary AST.
+ */
+class BinaryAstError : public std::runtime_error
+{
+public:
+  BinaryAstError()
+    : std::runtime_error("Invalid binary AST")
+  {
+  }
+};
+
+class BinaryAstReader
+{
+public:
+  explicit BinaryAstReader(std::string_view data)
+    : data_(data)
+  {
+  }
+
+  std::unique_ptr<CppCompound> read()
+  {
+    if ((data_.substr(0, kMagic.size()) != kMagic))
+      throw BinaryAstError();
+    pos_ = kMagic.size();
+    if (varint() != kBinaryAstVersion)
+      throw BinaryAstError();
+    auto ast = entityAs<CppCompound>();
+    if (!ast || (pos_ != data_.size()))
+      throw BinaryAstError();
+
+    return ast;
+  }
+
+private:
+  std::uint64_t varint()
+  {
+    std::uint64_t value = 0;
+    for (unsigned shift = 0; shift < 64; shift += 7)
+    {
+      if (pos_ >= data_.size())
+        throw BinaryAstError();
+      const auto byte = static_cast<std::uint8_t>(data_[pos_++]);
+      value |= static_cast<std::uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0)
+        return value;
+    }
+
+    throw BinaryAstError();
+  }
+
+  /**
+   * @return A count of items each of which takes at least one byte, so, it cannot exceed remaining bytes.
+   */
+  size_t count()
+  {
+    const auto value = varint();
+    if (value > data_.size() - pos_)
+      throw BinaryAstError();
+    return static_cast<size_t>(value);
+  }
+
+  template <typename IntType>
+  IntType integer()
+  {
+    const auto value = varint();
+    if (value > std::numeric_limits<IntType>::max())
+      throw BinaryAstError();
+    return static_cast<IntType>(value);
+  }
+
+  template <typename EnumType>
+  EnumType enumValue(EnumType lastValue)
+  {
+    const auto value = varint();
+    if (value > static_cast<std::uint64_t>(lastValue))
+      throw BinaryAstError();
+    return static_cast<EnumType>(value);
+  }
+
+  bool flag()
+  {
+    const auto value = varint();
+    if (value > 1)
+      throw BinaryAstError();
+    return value != 0;
+  }
+
+  std::string str()
+  {
+    const auto size = count();
+    std::string value(data_.substr(pos_, size));
+    pos_ += size;
+    return value;
+  }
+
+  CppAttributeSpecifierSequence attribSpecifierSequence()
+  {
+    CppAttributeSpecifierSequence attribs(count());
+    for (auto& attrib : attribs)
+      attrib = entityAs<CppExpression>();
+    return attribs;
+  }
+
+  void templateSpecification(CppTemplatableEntity& templatable)
+  {
+    if (!flag())
+      return;
+
+    CppTemplateParams templateSpec;
+    for (auto n = count(); n > 0; --n)
+    {
+      std::optional<CppTemplateParam::ParamType> paramType;
+      if (flag())
+      {
+        if (varint() == 0)
+          paramType = varType();
+        else
+          paramType = entityAs<CppFunctionPointer>();
+      }
+      auto                      paramName = str();
+      CppTemplateParam::ArgType defaultArg;
+      if (varint() == 0)
+        defaultArg = varType();
+      else
+        defaultArg = entityAs<CppExpression>();
+      if (paramType)
+        templateSpec.emplace_back(std::move(*paramType), std::move(paramName), std::move(defaultArg));
+      else
+        templateSpec.emplace_back(std::move(paramName), std::move(defaultArg));
+    }
+    templatable.templateSpecification(std::move(templateSpec));
+  }
+
+  CppTypeModifier typeModifier()
+  {
+    CppTypeModifier modifier;
+    modifier.refType_   = enumValue(CppRefType::RVAL_REF);
+    modifier.ptrLevel_  = integer<std::uint8_t>();
+    modifier.constBits_ = integer<std::uint32_t>();
+    return modifier;
+  }
+
+  std::unique_ptr<CppVarType> varType()
+  {
+    if (!flag())
+      return nullptr;
+
+    auto attribs  = attribSpecifierSequence();
+    auto compound = entity();
+    auto baseType = str();
+    auto modifier = typeModifier();
+
+    std::unique_ptr<CppVarType> type;
+    if (!compound)
+      type = std::make_unique<CppVarType>(std::move(baseType), modifier);
+    else if (compound->entityType() == CppEntityType::COMPOUND)
+      type = std::make_unique<CppVarType>(static_cast<CppCompound*>(compound.release()), modifier);
+    else if (compound->entityType() == CppEntityType::FUNCTION_PTR)
+      type = std::make_unique<CppVarType>(static_cast<CppFunctionPointer*>(compound.release()), modifier);
+    else if (compound->entityType() == CppEntityType::ENUM)
+      type = std::make_unique<CppVarType>(static_cast<CppEnum*>(compound.release()), modifier);
+    else
+      throw BinaryAstError();
+    if (!baseType.empty())
+      type->baseType(std::move(baseType));
+    type->typeAttr(integer<std::uint32_t>());
+    type->parameterPack(flag());
+    type->attribSpecifierSequence(std::move(attribs));
+
+    return type;
+  }
+
+  std::vector<std::unique_ptr<CppExpression>> expressions()
+  {
+    std::vector<std::unique_ptr<CppExpression>> exprs(count());
+    for (auto& expr : exprs)
+      expr = entityAs<CppExpression>();
+    return exprs;
+  }
+
+  std::vector<std::unique_ptr<CppEntity>> entities()
+  {
+    std::vector<std::unique_ptr<CppEntity>> ents(count());
+    for (auto& ent : ents)
+      ent = entity();
+    return ents;
+  }
+
+  CppConstructorCallInfo callArgs()
+  {
+    auto args = expressions();
+    return CppConstructorCallInfo {std::move(args), enumValue(CppConstructorCallStyle::USING_BRACES)};
+  }
+
+  CppVarDecl varDecl()
+  {
+    CppVarDecl decl(str());
+    switch (varint())
+    {
+      case 0:
+        break;
+      case static_cast<std::uint64_t>(CppVarInitializeType::USING_EQUAL) + 1:
+        decl.initialize(entityAs<CppExpression>());
+        break;
+      case static_cast<std::uint64_t>(CppVarInitializeType::DIRECT_CONSTRUCTOR_CALL) + 1:
+        decl.initialize(callArgs());
+        break;
+      default:
+        throw BinaryAstError();
+    }
+    decl.bitField(entityAs<CppExpression>());
+    for (auto n = count(); n > 0; --n)
+      decl.addArraySize(entityAs<CppExpression>().release());
+
+    return decl;
+  }
+
+  template <typename FuncClass>
+  std::unique_ptr<FuncClass> functionCommon(std::unique_ptr<FuncClass> func)
+  {
+    func->decor1(str());
+    func->decor2(str());
+    std::vector<std::string> throwSpec(count());
+    for (auto& exception : throwSpec)
+      exception = str();
+    func->throwSpec(std::move(throwSpec));
+    func->defn(entityAs<CppCompound>());
+    templateSpecification(*func);
+
+    return func;
+  }
+
+  std::unique_ptr<CppCompound> compound()
+  {
+    auto name         = str();
+    auto compoundType = enumValue(CppCompoundType::EXTERN_C_BLOCK);
+    auto cmpd         = std::make_unique<CppCompound>(std::move(name), compoundType);
+    cmpd->apidecor(str());
+    CppInheritanceList inheritanceList;
+    const auto         numBases = count();
+    inheritanceList.reserve(numBases);
+    for (auto n = numBases; n > 0; --n)
+    {
+      CppInheritanceInfo inheritance;
+      inheritance.baseName = str();
+      if (flag())
+        inheritance.inhType = enumValue(CppAccessType::PROTECTED);
+      inheritance.isVirtual = flag();
+      inheritanceList.push_back(std::move(inheritance));
+    }
+    cmpd->inheritanceList(std::move(inheritanceList));
+    cmpd->addAttr(integer<std::uint32_t>());
+    templateSpecification(*cmpd);
+    for (auto n = count(); n > 0; --n)
+    {
+      auto member = entity();
+      if (!member)
+        throw BinaryAstError();
+      cmpd->add(std::move(member));
+    }
+
+    return cmpd;
+  }
+
+  std::unique_ptr<CppExpression> atomicExpression()
+  {
+    switch (enumValue(CppAtomicExprType::LAMBDA))
+    {
+      case CppAtomicExprType::STRING_LITERAL:
+        return std::make_unique<CppStringLiteralExpr>(str());
+      case CppAtomicExprType::CHAR_LITERAL:
+        return std::make_unique<CppCharLiteralExpr>(str());
+      case CppAtomicExprType::NUMBER_LITEREL:
+        return std::make_unique<CppNumberLiteralExpr>(str());
+      case CppAtomicExprType::NAME:
+        return std::make_unique<CppNameExpr>(str());
+      case CppAtomicExprType::VARTYPE:
+        return std::make_unique<CppVartypeExpr>(nonNull(varType()));
+      case CppAtomicExprType::LAMBDA:
+        return std::make_unique<CppLambdaExpr>(nonNull(entityAs<CppLambda>()));
+    }
+
+    throw BinaryAstError();
+  }
+
+  std::unique_ptr<CppExpression> typecastExpression()
+  {
+    const auto castType   = enumValue(CppTypecastType::REINTERPRET);
+    auto       targetType = nonNull(varType());
+    auto       expr       = nonNull(entityAs<CppExpression>());
+    switch (castType)
+    {
+      case CppTypecastType::C_STYLE:
+        return std::make_unique<CppCStyleTypecastExpr>(std::move(targetType), std::move(expr));
+      case CppTypecastType::FUNCTION_STYLE:
+        return std::make_unique<CppFunctionStyleTypecastExpr>(std::move(targetType), std::move(expr));
+      case CppTypecastType::STATIC:
+        return std::make_unique<CppStaticCastExpr>(std::move(targetType), std::move(expr));
+      case CppTypecastType::CONST:
+        return std::make_unique<CppConstCastExpr>(std::move(targetType), std::move(expr));
+      case CppTypecastType::DYNAMIC:
+        return std::make_unique<CppDynamiCastExpr>(std::move(targetType), std::move(expr));
+      case CppTypecastType::REINTERPRET:
+        return std::make_unique<CppReinterpretCastExpr>(std::move(targetType), std::move(expr));
+    }
+
+    throw BinaryAstError();
+  }
+
+  std::unique_ptr<CppExpression> expression()
+  {
+    switch (enumValue(CppExpressionType::TYPECAST))
+    {
+      case CppExpressionType::ATOMIC:
+        return atomicExpression();
+      case CppExpressionType::MONOMIAL:
+      {
+        const auto oper = enumValue(CppUnaryOperator::VARIADIC_SIZE_OF);
+        return std::make_unique<CppMonomialExpr>(oper, nonNull(entityAs<CppExpression>()));
+      }
+      case CppExpressionType::BINOMIAL:
+      {
+        const auto oper  = enumValue(CppBinaryOperator::USER_LITERAL);
+        auto       term1 = nonNull(entityAs<CppExpression>());
+        auto       term2 = nonNull(entityAs<CppExpression>());
+        return std::make_unique<CppBinomialExpr>(oper, std::move(term1), std::move(term2));
+      }
+      case CppExpressionType::TRINOMIAL:
+      {
+        const auto oper  = enumValue(CppTernaryOperator::CONDITIONAL);
+        auto       term1 = nonNull(entityAs<CppExpression>());
+        auto       term2 = nonNull(entityAs<CppExpression>());
+        auto       term3 = nonNull(entityAs<CppExpression>());
+        return std::make_unique<CppTrinomialExpr>(oper, std::move(term1), std::move(term2), std::move(term3));
+      }
+      case CppExpressionType::FUNCTION_CALL:
+      {
+        auto func = nonNull(entityAs<CppExpression>());
+        return std::make_unique<CppFunctionCallExpr>(std::move(func), nonNullItems(expressions()));
+      }
+      case CppExpressionType::UNIFORM_INITIALIZER:
+      {
+        auto name = str();
+        return std::make_unique<CppUniformInitializerExpr>(std::move(name), nonNullItems(expressions()));
+      }
+      case CppExpressionType::INITIALIZER_LIST:
+        return std::make_unique<CppInitializerListExpr>(nonNullItems(expressions()));
+      case CppExpressionType::TYPECAST:
+        return typecastExpression();
+    }
+
+    throw BinaryAstError();
+  }
+
+  std::unique_ptr<CppPreprocessor> preprocessor()
+  {
+    switch (enumValue(CppPreprocessorType::UNRECOGNIZED))
+    {
+      case CppPreprocessorType::DEFINE:
+      {
+        const auto defType = enumValue(CppPreprocessorDefineType::COMPLEX_DEFN);
+        auto       name    = str();
+        return std::make_unique<CppPreprocessorDefine>(defType, std::move(name), CppText(str()));
+      }
+      case CppPreprocessorType::UNDEF:
+        return std::make_unique<CppPreprocessorUndef>(str());
+      case CppPreprocessorType::CONDITIONAL:
+      {
+        const auto condType = enumValue(PreprocessorConditionalType::ENDIF);
+        return std::make_unique<CppPreprocessorConditional>(condType, str());
+      }
+      case CppPreprocessorType::INCLUDE:
+        return std::make_unique<CppPreprocessorInclude>(str());
+      case CppPreprocessorType::IMPORT:
+        return std::make_unique<CppPreprocessorImport>(str());
+      case CppPreprocessorType::WARNING:
+        return std::make_unique<CppPreprocessorWarning>(str());
+      case CppPreprocessorType::ERROR:
+        return std::make_unique<CppPreprocessorError>(str());
+      case CppPreprocessorType::PRAGMA:
+        return std::make_unique<CppPreprocessorPragma>(str());
+      case CppPreprocessorType::UNRECOGNIZED:
+      {
+        auto name = str();
+        return std::make_unique<CppPreprocessorUnrecognized>(std::move(name), str());
+      }
+      case CppPreprocessorType::LINE:
+        break;
+    }
+
+    throw BinaryAstError();
+  }
+
+  std::unique_ptr<CppEntity> entityData(CppEntityType entityType)
+  {
+    switch (entityType)
+    {
+      case CppEntityType::DOCUMENTATION_COMMENT:
+        return std::make_unique<CppDocumentationComment>(CppText(str()));
+      case CppEntityType::PREPROCESSOR:
+        return preprocessor();
+      case CppEntityType::ENTITY_ACCESS_SPECIFIER:
+        return std::make_unique<CppEntityAccessSpecifier>(enumValue(CppAccessType::PROTECTED));
+      case CppEntityType::COMPOUND:
+        return compound();
+      case CppEntityType::VAR:
+      {
+        auto type = nonNull(varType());
+        auto var  = std::make_unique<CppVar>(std::move(type), varDecl());
+        var->apidecor(str());
+        templateSpecification(*var);
+        return var;
+      }
+      case CppEntityType::VAR_LIST:
+      {
+        auto firstVar = nonNull(entityAs<CppVar>());
+        auto n        = count();
+        if (n == 0)
+          throw BinaryAstError();
+        auto modifier = typeModifier();
+        auto varList  = std::make_unique<CppVarList>(firstVar.release(), CppVarDeclInList(modifier, varDecl()));
+        for (; n > 1; --n)
+        {
+          modifier = typeModifier();
+          varList->addVarDecl(CppVarDeclInList(modifier, varDecl()));
+        }
+        return varList;
+      }
+      case CppEntityType::TYPEDEF_DECL:
+        return std::make_unique<CppTypedefName>(nonNull(entityAs<CppVar>()));
+      case CppEntityType::TYPEDEF_DECL_LIST:
+        return std::make_unique<CppTypedefList>(nonNull(entityAs<CppVarList>()));
+      case CppEntityType::NAMESPACE_ALIAS:
+      {
+        auto name = str();
+        return std::make_unique<CppNamespaceAlias>(std::move(name), str());
+      }
+      case CppEntityType::USING_NAMESPACE:
+        return std::make_unique<CppUsingNamespaceDecl>(str());
+      case CppEntityType::USING_DECL:
+      {
+        auto                   name = str();
+        CppUsingDecl::DeclData defn;
+        switch (varint())
+        {
+          case 0:
+            defn = varType();
+            break;
+          case 1:
+            defn = entityAs<CppFunctionPointer>();
+            break;
+          case 2:
+            defn = entityAs<CppCompound>();
+            break;
+          default:
+            throw BinaryAstError();
+        }
+        auto usingDecl = std::make_unique<CppUsingDecl>(std::move(name), std::move(defn));
+        templateSpecification(*usingDecl);
+        return usingDecl;
+      }
+      case CppEntityType::ENUM:
+      {
+        auto            name           = str();
+        const auto      isClass        = flag();
+        auto            underlyingType = str();
+        CppEnumItemList itemList;
+        const auto      numItems = count();
+        itemList.reserve(numItems);
+        for (auto n = numItems; n > 0; --n)
+        {
+          if (flag())
+          {
+            itemList.emplace_back(nonNull(entity()));
+          }
+          else
+          {
+            auto itemName = str();
+            itemList.emplace_back(std::move(itemName), entityAs<CppExpression>());
+          }
+        }
+        return std::make_unique<CppEnum>(std::move(name), std::move(itemList), isClass, std::move(underlyingType));
+      }
+      case CppEntityType::FORWARD_CLASS_DECL:
+      {
+        auto       name         = str();
+        auto       apidecor     = str();
+        const auto compoundType = enumValue(CppCompoundType::EXTERN_C_BLOCK);
+        auto       fwdDecl = std::make_unique<CppForwardClassDecl>(std::move(name), std::move(apidecor), compoundType);
+        fwdDecl->addAttr(integer<std::uint32_t>());
+        templateSpecification(*fwdDecl);
+        return fwdDecl;
+      }
+      case CppEntityType::FUNCTION:
+      {
+        auto       name    = str();
+        auto       retType = varType();
+        auto       params  = nonNullItems(entities());
+        const auto attr    = integer<std::uint32_t>();
+        return functionCommon(
+          std::make_unique<CppFunction>(std::move(name), std::move(retType), std::move(params), attr));
+      }
+      case CppEntityType::LAMBDA:
+      {
+        auto captures = entityAs<CppExpression>();
+        auto params   = nonNullItems(entities());
+        auto retType  = varType();
+        return std::make_unique<CppLambda>(
+          std::move(captures), std::move(params), entityAs<CppCompound>(), std::move(retType));
+      }
+      case CppEntityType::CONSTRUCTOR:
+      {
+        auto           name   = str();
+        auto           params = nonNullItems(entities());
+        CppMemberInits memInits;
+        if (flag())
+        {
+          const auto numMemInits = count();
+          memInits.reserve(numMemInits);
+          for (auto n = numMemInits; n > 0; --n)
+          {
+            auto memberName = str();
+            memInits.push_back(CppMemberInit {std::move(memberName), callArgs()});
+          }
+        }
+        const auto attr = integer<std::uint32_t>();
+        return functionCommon(
+          std::make_unique<CppConstructor>(std::move(name), std::move(params), std::move(memInits), attr));
+      }
+      case CppEntityType::DESTRUCTOR:
+      {
+        auto name = str();
+        return functionCommon(std::make_unique<CppDestructor>(std::move(name), integer<std::uint32_t>()));
+      }
+      case CppEntityType::TYPE_CONVERTER:
+      {
+        auto targetType = varType();
+        auto converter  = std::make_unique<CppTypeConverter>(targetType.release(), str());
+        converter->addAttr(integer<std::uint32_t>());
+        return functionCommon(std::move(converter));
+      }
+      case CppEntityType::FUNCTION_PTR:
+      {
+        auto       name      = str();
+        auto       retType   = varType();
+        auto       params    = nonNullItems(entities());
+        auto       ownerName = str();
+        const auto attr      = integer<std::uint32_t>();
+        return functionCommon(std::make_unique<CppFunctionPointer>(
+          std::move(name), std::move(retType), std::move(params), attr, std::move(ownerName)));
+      }
+      case CppEntityType::EXPRESSION:
+        return expression();
+      case CppEntityType::GOTO_STATEMENT:
+        return std::make_unique<CppGotoStatement>(nonNull(entityAs<CppExpression>()));
+      case CppEntityType::RETURN_STATEMENT:
+        return std::make_unique<CppReturnStatement>(entityAs<CppExpression>());
+      case CppEntityType::THROW_STATEMENT:
+        return std::make_unique<CppThrowStatement>(entityAs<CppExpression>());
+      case CppEntityType::MACRO_CALL:
+        return std::make_unique<CppMacroCall>(str());
+      case CppEntityType::ASM_BLOCK:
+        return std::make_unique<CppAsmBlock>(str());
+      case CppEntityType::LABEL:
+        return std::make_unique<CppLabel>(str());
+      case CppEntityType::IF_BLOCK:
+      {
+        auto cond = entity();
+        auto body = entity();
+        return std::make_unique<CppIfBlock>(std::move(cond), std::move(body), entity());
+      }
+      case CppEntityType::FOR_BLOCK:
+      {
+        auto start = entity();
+        auto stop  = entityAs<CppExpression>();
+        auto step  = entityAs<CppExpression>();
+        return std::make_unique<CppForBlock>(std::move(start), std::move(stop), std::move(step), entity());
+      }
+      case CppEntityType::RANGE_FOR_BLOCK:
+      {
+        auto var  = entityAs<CppVar>();
+        auto expr = entityAs<CppExpression>();
+        return std::make_unique<CppRangeForBlock>(std::move(var), std::move(expr), entity());
+      }
+      case CppEntityType::WHILE_BLOCK:
+      {
+        auto cond = entity();
+        return std::make_unique<CppWhileBlock>(std::move(cond), entity());
+      }
+      case CppEntityType::DO_WHILE_BLOCK:
+      {
+        auto cond = entity();
+        return std::make_unique<CppDoWhileBlock>(std::move(cond), entity());
+      }
+      case CppEntityType::SWITCH_BLOCK:
+      {
+        auto                 cond = entityAs<CppExpression>();
+        std::vector<CppCase> cases;
+        for (auto n = count(); n > 0; --n)
+        {
+          auto caseExpr = entityAs<CppExpression>();
+          cases.emplace_back(std::move(caseExpr), entityAs<CppCompound>());
+        }
+        return std::make_unique<CppSwitchBlock>(std::move(cond), std::move(cases));
+      }
+      case CppEntityType::TRY_BLOCK:
+      {
+        auto tryStmt = entityAs<CppCompound>();
+        auto n       = count();
+        if (n == 0)
+          throw BinaryAstError();
+        auto tryBlock = std::make_unique<CppTryBlock>(std::move(tryStmt), catchBlock());
+        for (; n > 1; --n)
+          tryBlock->addCatchBlock(catchBlock());
+        return tryBlock;
+      }
+      case CppEntityType::BLOB:
+        return std::make_unique<CppBlob>(CppText(str()));
+    }
+
+    throw BinaryAstError();
+  }
+
+  std::unique_ptr<CppCatchBlock> catchBlock()
+  {
+    auto catchBlk            = std::make_unique<CppCatchBlock>();
+    catchBlk->exceptionType_ = varType();
+    catchBlk->exceptionName_ = str();
+    catchBlk->catchStmt_     = entityAs<CppCompound>();
+    return catchBlk;
+  }
+
+  std::unique_ptr<CppEntity> entity()
+  {
+    const auto tag = enumValue(static_cast<std::uint64_t>(CppEntityType::BLOB) + 1);
+    if (tag == 0)
+      return nullptr;
+
+    auto attribs = attribSpecifierSequence();
+    auto ent     = entityData(static_cast<CppEntityType>(tag - 1));
+    ent->attribSpecifierSequence(std::move(attribs));
+
+    return ent;
+  }
+
+  template <typename EntityClass>
+  std::unique_ptr<EntityClass> entityAs()
+  {
+    auto ent = entity();
+    if (ent && (ent->entityType() != EntityClass::EntityType()))
+      throw BinaryAstError();
+    return std::unique_ptr<EntityClass>(static_cast<EntityClass*>(ent.release()));
+  }
+
+  template <typename T>
+  static std::unique_ptr<T> nonNull(std::unique_ptr<T> ptr)
+  {
+    if (!ptr)
+      throw BinaryAstError();
+    return ptr;
+  }
+
+  template <typename T>
+  static std::vector<std::unique_ptr<T>> nonNullItems(std::vector<std::unique_ptr<T>> items)
+  {
+    for (const auto& item : items)
+      nonNull(item.get());
+    return items;
+  }
+
+  static void nonNull(const void* ptr)
+  {
+    if (!ptr)
+      throw BinaryAstError();
+  }
+
+private:
+  std::string_view data_;
+  size_t           pos_ {0};
+};
+
+} // namespace
+
+std::string WriteBinaryAst(const CppCompound& ast)
+{
+  return BinaryAstWriter().write(ast);
+}
+
+std::unique_ptr<CppCompound> ReadBinaryAst(std::string_view data)
+{
+  try
+  {
+    return BinaryAstReader(data).read();
+  }
+  catch (const BinaryAstError&)
+  {
+    return nullptr;
+  }
+}
+
+} // namespace cppast
@@ -9,7 +9,7 @@ namespace cppast {
 
 CppCompound::CppCompound(std::string name, CppCompoundType type)
   : CppEntity(EntityType())
-  , name_(std::move(name))
+  , name_(name)
   , compoundType_(type)
 {
 }
@@ -19,6 +19,13 @@ CppCompound::CppCompound(CppCompoundType type)
 {
 }
 
+void CppCompound::adoptEntitiesOf(CppCompound& other)
+{
+  for (auto& entity : other.entities_)
+    add(std::move(entity));
+  other.entities_.clear();
+}
+
 bool CppCompound::visitAll(const Visitor<const CppEntity&>& callback) const
 {
   for (auto& entity : entities_)
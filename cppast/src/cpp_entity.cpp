@@ -0,0 +1,45 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_entity.h"
+#include "cppast/cpp_entity_arena.h"
+
+#include <cstdint>
+#include <new>
+
+namespace cppast {
+
+namespace {
+
+// Heap entities are aligned to kHeapAlignment and arena entities are placed kArenaOffset past such an alignment.
+// So, address of an entity tells whether it is allocated from an arena and neither needs a header.
+// No entity needs an alignment stricter than that of a pointer, so, an arena entity wastes no more than a pointer.
+constexpr std::size_t kArenaOffset   = alignof(CppEntityArena*);
+constexpr std::size_t kHeapAlignment = 2 * kArenaOffset;
+
+static_assert(alignof(CppEntity) <= kArenaOffset);
+
+bool IsFromArena(const void* ptr)
+{
+  return (reinterpret_cast<std::uintptr_t>(ptr) % kHeapAlignment) == kArenaOffset;
+}
+
+} // namespace
+
+void* CppEntity::operator new(std::size_t size)
+{
+  auto* const arena = CppEntityArena::current();
+  if (arena == nullptr)
+    return ::operator new(size, std::align_val_t(kHeapAlignment));
+
+  return static_cast<char*>(arena->allocate(kArenaOffset + size, kHeapAlignment)) + kArenaOffset;
+}
+
+void CppEntity::operator delete(void* ptr)
+{
+  // Memory carved out of an arena is released only when the arena is destroyed.
+  if ((ptr != nullptr) && !IsFromArena(ptr))
+    ::operator delete(ptr, std::align_val_t(kHeapAlignment));
+}
+
+} // namespace cppast
@@ -0,0 +1,49 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_entity_arena.h"
+
+namespace cppast {
+
+namespace {
+
+constexpr std::size_t kInitialArenaSize = 64 * 1024;
+
+thread_local CppEntityArena* gCurrentArena = nullptr;
+
+} // namespace
+
+CppEntityArena::Scope::Scope(CppEntityArena& arena)
+  : prevArena_(gCurrentArena)
+{
+  gCurrentArena = &arena;
+}
+
+CppEntityArena::Scope::~Scope()
+{
+  gCurrentArena = prevArena_;
+}
+
+CppEntityArena::CppEntityArena()
+  : CppEntityArena(kInitialArenaSize)
+{
+}
+
+CppEntityArena::CppEntityArena(std::size_t initialSize)
+  : memory_(initialSize)
+{
+}
+
+CppEntityArena* CppEntityArena::current()
+{
+  return gCurrentArena;
+}
+
+void* CppEntityArena::allocate(std::size_t size, std::size_t alignment)
+{
+  ++numAllocations_;
+  bytesAllocated_ += size;
+  return memory_.allocate(size, alignment);
+}
+
+} // namespace cppast
@@ -7,7 +7,7 @@ namespace cppast {
 
 CppLambda::CppLambda(std::unique_ptr<CppExpression>          captures,
                      std::vector<std::unique_ptr<CppEntity>> params,
-                     std::unique_ptr<CppCompound>            defn,
+                     CppLazyCompound                         defn,
                      std::unique_ptr<CppVarType>             retType)
   : CppEntity(EntityType())
   , captures_(std::move(captures))
@@ -0,0 +1,43 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_lazy_compound.h"
+#include "cppast/cpp_compound.h"
+
+namespace cppast {
+
+CppLazyCompound::CppLazyCompound() = default;
+
+CppLazyCompound::CppLazyCompound(std::unique_ptr<CppCompound> compound)
+  : compound_(std::move(compound))
+{
+}
+
+CppLazyCompound::CppLazyCompound(Parser parser)
+  : pending_(parser ? std::make_unique<Pending>() : nullptr)
+{
+  if (pending_)
+    pending_->parser = std::move(parser);
+}
+
+CppLazyCompound::CppLazyCompound(CppLazyCompound&& other) noexcept = default;
+
+CppLazyCompound::~CppLazyCompound() = default;
+
+CppLazyCompound& CppLazyCompound::operator=(CppLazyCompound&& other) noexcept = default;
+
+const CppCompound* CppLazyCompound::get() const
+{
+  if (pending_)
+  {
+    // Parser is released once done because the text it holds is not needed anymore.
+    std::call_once(pending_->once, [this]() {
+      compound_        = pending_->parser();
+      pending_->parser = nullptr;
+    });
+  }
+
+  return compound_.get();
+}
+
+} // namespace cppast
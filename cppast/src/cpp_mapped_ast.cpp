@@ -0,0 +1,346 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_mapped_ast.h"
+#include "cppast/cppast.h"
+
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+namespace cppast {
+
+namespace {
+
+constexpr char kMagic[8] = {'C', 'P', 'P', 'A', 'S', 'T', 'V', '\n'};
+
+struct Header
+{
+  char          magic[8];
+  std::uint32_t version;
+  std::uint32_t numNodes;
+  std::uint32_t stringsSize;
+  std::uint32_t reserved;
+};
+
+const CppFunctionCommon* FunctionCommon(const CppEntity& entity)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::FUNCTION:
+      return static_cast<const CppFunction*>(&entity);
+    case CppEntityType::CONSTRUCTOR:
+      return static_cast<const CppConstructor*>(&entity);
+    case CppEntityType::DESTRUCTOR:
+      return static_cast<const CppDestructor*>(&entity);
+    case CppEntityType::TYPE_CONVERTER:
+      return static_cast<const CppTypeConverter*>(&entity);
+    case CppEntityType::FUNCTION_PTR:
+      return static_cast<const CppFunctionPointer*>(&entity);
+    default:
+      return nullptr;
+  }
+}
+
+std::string_view EntityName(const CppEntity& entity)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::COMPOUND:
+      return static_cast<const CppCompound&>(entity).name();
+    case CppEntityType::FORWARD_CLASS_DECL:
+      return static_cast<const CppForwardClassDecl&>(entity).name();
+    case CppEntityType::VAR:
+      return static_cast<const CppVar&>(entity).name();
+    case CppEntityType::VAR_LIST:
+      return static_cast<const CppVarList&>(entity).firstVar()->name();
+    case CppEntityType::TYPEDEF_DECL:
+      return static_cast<const CppTypedefName&>(entity).var()->name();
+    case CppEntityType::TYPEDEF_DECL_LIST:
+      return static_cast<const CppTypedefList&>(entity).varList().firstVar()->name();
+    case CppEntityType::NAMESPACE_ALIAS:
+      return static_cast<const CppNamespaceAlias&>(entity).alias();
+    case CppEntityType::USING_NAMESPACE:
+      return static_cast<const CppUsingNamespaceDecl&>(entity).name();
+    case CppEntityType::USING_DECL:
+      return static_cast<const CppUsingDecl&>(entity).name();
+    case CppEntityType::ENUM:
+      return static_cast<const CppEnum&>(entity).name();
+    case CppEntityType::MACRO_CALL:
+      return static_cast<const CppMacroCall&>(entity).macroCall();
+    case CppEntityType::LABEL:
+      return static_cast<const CppLabel&>(entity).label();
+    case CppEntityType::PREPROCESSOR:
+    {
+      const auto& prepro = static_cast<const CppPreprocessor&>(entity);
+      switch (prepro.preprocessorType())
+      {
+        case CppPreprocessorType::DEFINE:
+          return static_cast<const CppPreprocessorDefine&>(prepro).name();
+        case CppPreprocessorType::UNDEF:
+          return static_cast<const CppPreprocessorUndef&>(prepro).name();
+        case CppPreprocessorType::INCLUDE:
+          return static_cast<const CppPreprocessorInclude&>(prepro).name();
+        case CppPreprocessorType::IMPORT:
+          return static_cast<const CppPreprocessorImport&>(prepro).name();
+        default:
+          break;
+      }
+      break;
+    }
+    default:
+      if (const auto* func = FunctionCommon(entity))
+        return func->name();
+      break;
+  }
+
+  return std::string_view();
+}
+
+std::uint8_t EntitySubType(const CppEntity& entity)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::COMPOUND:
+      return static_cast<std::uint8_t>(static_cast<const CppCompound&>(entity).compoundType());
+    case CppEntityType::FORWARD_CLASS_DECL:
+      return static_cast<std::uint8_t>(static_cast<const CppForwardClassDecl&>(entity).compoundType());
+    case CppEntityType::ENTITY_ACCESS_SPECIFIER:
+      return static_cast<std::uint8_t>(static_cast<const CppEntityAccessSpecifier&>(entity).type());
+    default:
+      return 0;
+  }
+}
+
+std::uint32_t EntityAttr(const CppEntity& entity)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::COMPOUND:
+      return static_cast<const CppCompound&>(entity).attr();
+    case CppEntityType::FORWARD_CLASS_DECL:
+      return static_cast<const CppForwardClassDecl&>(entity).attr();
+    default:
+    {
+      const auto* func = FunctionCommon(entity);
+      return func ? func->attr() : 0;
+    }
+  }
+}
+
+template <typename Callback>
+void VisitChildren(const CppEntity& entity, Callback&& callback)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::COMPOUND:
+      static_cast<const CppCompound&>(entity).visitAll([&callback](const CppEntity& member) {
+        callback(member);
+        return true;
+      });
+      break;
+    case CppEntityType::FUNCTION:
+      static_cast<const CppFunction&>(entity).visitAllParams(callback);
+      break;
+    case CppEntityType::CONSTRUCTOR:
+      static_cast<const CppConstructor&>(entity).visitAllParams(callback);
+      break;
+    case CppEntityType::FUNCTION_PTR:
+      static_cast<const CppFunctionPointer&>(entity).visitAllParams(callback);
+      break;
+    case CppEntityType::LAMBDA:
+      for (const auto& param : static_cast<const CppLambda&>(entity).params())
+        callback(*param);
+      break;
+    default:
+      break;
+  }
+}
+
+const CppCompound* EntityDefn(const CppEntity& entity)
+{
+  switch (entity.entityType())
+  {
+    case CppEntityType::LAMBDA:
+      return static_cast<const CppLambda&>(entity).defn();
+    default:
+    {
+      const auto* func = FunctionCommon(entity);
+      return func ? func->defn() : nullptr;
+    }
+  }
+}
+
+std::uint32_t CheckedSize(size_t size)
+{
+  // Largest value is reserved to mean none.
+  if (size >= std::numeric_limits<std::uint32_t>::max())
+    throw std::length_error("AST is too big for mapped AST layout");
+  return static_cast<std::uint32_t>(size);
+}
+
+} // namespace
+
+std::string WriteMappedAst(const CppCompound& ast)
+{
+  using Node = CppEntityView::Node;
+  static_assert(sizeof(Node) == 32, "Node record must stay compact and free of padding");
+
+  std::vector<Node>             nodes;
+  std::vector<const CppEntity*> entities;
+  std::string                   strings;
+
+  const auto addNode = [&nodes, &entities](const CppEntity& entity, std::uint32_t parent) {
+    Node node {};
+    node.entityType = static_cast<std::uint8_t>(entity.entityType());
+    node.parent     = parent;
+    node.defn       = Node::kNone;
+    nodes.push_back(node);
+    entities.push_back(&entity);
+  };
+
+  // Nodes are filled in the order they are added and a node adds all its children at once.
+  // That lays out the tree breadth first with children of every node next to each other.
+  addNode(ast, Node::kNone);
+  for (std::uint32_t idx = 0; idx < nodes.size(); ++idx)
+  {
+    const auto& entity = *entities[idx];
+    const auto  name   = EntityName(entity);
+
+    nodes[idx].subType    = EntitySubType(entity);
+    nodes[idx].attr       = EntityAttr(entity);
+    nodes[idx].nameOffset = CheckedSize(strings.size());
+    nodes[idx].nameSize   = CheckedSize(name.size());
+    strings.append(name);
+
+    nodes[idx].firstChild = CheckedSize(nodes.size());
+    VisitChildren(entity, [&addNode, idx](const CppEntity& child) { addNode(child, idx); });
+    nodes[idx].numChildren = CheckedSize(nodes.size() - nodes[idx].firstChild);
+
+    if (const auto* defn = EntityDefn(entity))
+    {
+      nodes[idx].defn = CheckedSize(nodes.size());
+      addNode(*defn, idx);
+    }
+  }
+
+  Header header {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version     = kMappedAstVersion;
+  header.numNodes    = CheckedSize(nodes.size());
+  header.stringsSize = CheckedSize(strings.size());
+
+  std::string data;
+  data.reserve(sizeof(header) + nodes.size() * sizeof(Node) + strings.size());
+  data.append(reinterpret_cast<const char*>(&header), sizeof(header));
+  data.append(reinterpret_cast<const char*>(nodes.data()), nodes.size() * sizeof(Node));
+  data.append(strings);
+
+  return data;
+}
+
+std::unique_ptr<CppMappedAst> CppMappedAst::open(const std::string& filename)
+{
+  std::unique_ptr<CppMappedAst> ast(new CppMappedAst());
+
+#if !defined(_WIN32)
+  const int fd = ::open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd >= 0)
+  {
+    struct stat fileStat;
+    if ((fstat(fd, &fileStat) == 0) && S_ISREG(fileStat.st_mode) && (fileStat.st_size != 0))
+    {
+      const auto fileSize = static_cast<size_t>(fileStat.st_size);
+      auto* const addr    = mmap(nullptr, fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      if (addr != MAP_FAILED)
+      {
+        ast->mapped_     = addr;
+        ast->mappedSize_ = fileSize;
+      }
+    }
+    close(fd);
+  }
+  if (ast->mapped_)
+    return ast->validate(std::string_view(static_cast<const char*>(ast->mapped_), ast->mappedSize_)) ? std::move(ast)
+                                                                                                       : nullptr;
+#endif
+
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  if (!in)
+    return nullptr;
+  in.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<size_t>(in.tellg());
+  in.seekg(0, std::ios::beg);
+  ast->contents_.reset(new char[fileSize]);
+  if (!in.read(ast->contents_.get(), fileSize))
+    return nullptr;
+
+  return ast->validate(std::string_view(ast->contents_.get(), fileSize)) ? std::move(ast) : nullptr;
+}
+
+std::unique_ptr<CppMappedAst> CppMappedAst::fromBuffer(std::string_view data)
+{
+  std::unique_ptr<CppMappedAst> ast(new CppMappedAst());
+  return ast->validate(data) ? std::move(ast) : nullptr;
+}
+
+CppMappedAst::~CppMappedAst()
+{
+#if !defined(_WIN32)
+  if (mapped_)
+    munmap(mapped_, mappedSize_);
+#endif
+}
+
+bool CppMappedAst::validate(std::string_view data)
+{
+  using Node = CppEntityView::Node;
+
+  if ((data.size() < sizeof(Header)) || (reinterpret_cast<std::uintptr_t>(data.data()) % alignof(Node) != 0))
+    return false;
+
+  Header header;
+  std::memcpy(&header, data.data(), sizeof(header));
+  if ((std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) || (header.version != kMappedAstVersion)
+      || (header.numNodes == 0))
+    return false;
+  const auto nodesSize = static_cast<std::uint64_t>(header.numNodes) * sizeof(Node);
+  if (sizeof(header) + nodesSize + header.stringsSize != data.size())
+    return false;
+
+  const auto* nodes = reinterpret_cast<const Node*>(data.data() + sizeof(header));
+  if ((nodes[0].entityType != static_cast<std::uint8_t>(CppEntityType::COMPOUND)) || (nodes[0].parent != Node::kNone))
+    return false;
+
+  // Children and definitions always come after their owner, that guarantees traversal to terminate.
+  for (std::uint32_t idx = 0; idx < header.numNodes; ++idx)
+  {
+    const auto& node = nodes[idx];
+    if ((node.entityType > static_cast<std::uint8_t>(CppEntityType::BLOB))
+        || (static_cast<std::uint64_t>(node.nameOffset) + node.nameSize > header.stringsSize)
+        || ((idx != 0) && (node.parent >= idx)))
+      return false;
+    if ((node.numChildren != 0)
+        && ((node.firstChild <= idx)
+            || (static_cast<std::uint64_t>(node.firstChild) + node.numChildren > header.numNodes)))
+      return false;
+    if ((node.defn != Node::kNone) && ((node.defn <= idx) || (node.defn >= header.numNodes)))
+      return false;
+  }
+
+  nodes_    = nodes;
+  numNodes_ = header.numNodes;
+  strings_  = data.data() + sizeof(header) + nodesSize;
+
+  return true;
+}
+
+} // namespace cppast
@@ -0,0 +1,198 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppast/cpp_symbol.h"
+#include "cppast/cpp_interned_type.h"
+
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+
+namespace cppast {
+
+namespace {
+
+// Strings and types are spread over shards by their hash,
+// so that threads interning different strings rarely wait for each other.
+constexpr std::size_t kNumShards = 16;
+
+thread_local CppSymbolTable* gCurrentSymbolTable = nullptr;
+
+const CppSymbol::Entry* EmptyEntry()
+{
+  // Symbols can be created during static initialization, so, it is created on first use.
+  static const CppSymbol::Entry emptyEntry(nullptr, std::hash<std::string_view>()(std::string_view()), std::string());
+  return &emptyEntry;
+}
+
+/**
+ * Key that carries its hash along, so that the string is hashed only once.
+ */
+struct SymbolKey
+{
+  std::string_view str;
+  std::size_t      hash;
+
+  bool operator==(const SymbolKey& other) const
+  {
+    return str == other.str;
+  }
+};
+
+// It is noexcept so that nodes of index do not keep another copy of the hash.
+struct SymbolKeyHash
+{
+  std::size_t operator()(const SymbolKey& key) const noexcept
+  {
+    return key.hash;
+  }
+};
+
+struct InternedTypeHash
+{
+  std::size_t operator()(const CppInternedType* type) const noexcept
+  {
+    return type->hash();
+  }
+};
+
+struct InternedTypeEqual
+{
+  bool operator()(const CppInternedType* lhs, const CppInternedType* rhs) const
+  {
+    return *lhs == *rhs;
+  }
+};
+
+} // namespace
+
+struct CppSymbolTable::Shard
+{
+  mutable std::mutex mutex;
+  // A deque never moves its elements, so, keys of index can view strings of entries.
+  std::deque<CppSymbol::Entry>                                          entries;
+  std::unordered_map<SymbolKey, const CppSymbol::Entry*, SymbolKeyHash> index;
+  std::size_t                                                           numInterned {0};
+  std::size_t                                                           bytesOfSymbols {0};
+  std::size_t                                                           bytesInterned {0};
+
+  // A type is looked up using pointer to the type being interned, so, it is never copied just for lookup.
+  std::deque<CppInternedType>                                                       types;
+  std::unordered_set<const CppInternedType*, InternedTypeHash, InternedTypeEqual> typeIndex;
+  std::size_t                                                                       numTypesInterned {0};
+};
+
+CppSymbol::CppSymbol()
+  : entry_(EmptyEntry())
+{
+}
+
+CppSymbol::CppSymbol(std::string_view str)
+  : entry_(EmptyEntry())
+{
+  if (auto* const symbolTable = CppSymbolTable::current())
+    *this = symbolTable->intern(str);
+  else if (!str.empty())
+    entry_ = new Entry(nullptr, std::hash<std::string_view>()(str), std::string(str), 1);
+}
+
+CppSymbolTable::Scope::Scope(CppSymbolTable& symbolTable)
+  : prevSymbolTable_(gCurrentSymbolTable)
+{
+  gCurrentSymbolTable = &symbolTable;
+}
+
+CppSymbolTable::Scope::~Scope()
+{
+  gCurrentSymbolTable = prevSymbolTable_;
+}
+
+CppSymbolTable::CppSymbolTable()
+  : shards_(new Shard[kNumShards])
+{
+}
+
+CppSymbolTable::~CppSymbolTable()
+{
+  // Base type of a type can be a string of another shard, so, all types go before any string.
+  for (std::size_t i = 0; i < kNumShards; ++i)
+  {
+    shards_[i].typeIndex.clear();
+    shards_[i].types.clear();
+  }
+}
+
+CppSymbolTable* CppSymbolTable::current()
+{
+  return gCurrentSymbolTable;
+}
+
+CppSymbol CppSymbolTable::intern(std::string_view str)
+{
+  if (str.empty())
+    return CppSymbol();
+
+  const SymbolKey key {str, std::hash<std::string_view>()(str)};
+  auto&           shard = shards_[key.hash % kNumShards];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  ++shard.numInterned;
+  shard.bytesInterned += str.size();
+
+  const auto itr = shard.index.find(key);
+  if (itr != shard.index.end())
+    return CppSymbol(itr->second);
+
+  const auto& entry = shard.entries.emplace_back(this, key.hash, std::string(str));
+  shard.index.emplace(SymbolKey {entry.str, key.hash}, &entry);
+  shard.bytesOfSymbols += str.size();
+
+  return CppSymbol(&entry);
+}
+
+const CppInternedType* CppSymbolTable::intern(const CppInternedType& type)
+{
+  // An interned type must not refer to a string of another table, which may be destroyed before this one,
+  // nor to a string of no table, which then does not count as interned.
+  if (!type.baseType.empty() && (type.baseType.entry_->table != this))
+  {
+    auto ownType     = type;
+    ownType.baseType = intern(type.baseType.str());
+    return intern(ownType);
+  }
+
+  auto& shard = shards_[type.hash() % kNumShards];
+
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  ++shard.numTypesInterned;
+
+  const auto itr = shard.typeIndex.find(&type);
+  if (itr != shard.typeIndex.end())
+    return *itr;
+
+  auto& internedType     = shard.types.emplace_back(type);
+  internedType.ofNoTable = false;
+  shard.typeIndex.insert(&internedType);
+
+  return &internedType;
+}
+
+CppSymbolTable::Stats CppSymbolTable::stats() const
+{
+  Stats stats;
+  for (std::size_t i = 0; i < kNumShards; ++i)
+  {
+    const auto&                 shard = shards_[i];
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    stats.numSymbols += shard.entries.size();
+    stats.numInterned += shard.numInterned;
+    stats.bytesOfSymbols += shard.bytesOfSymbols;
+    stats.bytesInterned += shard.bytesInterned;
+    stats.numTypes += shard.types.size();
+    stats.numTypesInterned += shard.numTypesInterned;
+  }
+  return stats;
+}
+
+} // namespace cppast
@@ -7,12 +7,12 @@ namespace cppast {
 
 const std::optional<CppTemplateParams>& CppTemplatableEntity::templateSpecification() const
 {
-  return templateSpec_;
+  return templateSpec_.get();
 }
 
 void CppTemplatableEntity::templateSpecification(CppTemplateParams templateSpec)
 {
-  templateSpec_ = std::move(templateSpec);
+  templateSpec_.set(std::move(templateSpec));
 }
 
 } // namespace cppast
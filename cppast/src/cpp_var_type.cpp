@@ -6,40 +6,119 @@
 
 namespace cppast {
 
+CppVarType::ModifierRef::ModifierRef(CppVarType& varType)
+  : varType_(varType)
+  , modifier_(varType.type_->typeModifier)
+  , refType_(modifier_.refType_)
+  , ptrLevel_(modifier_.ptrLevel_)
+  , constBits_(modifier_.constBits_)
+{
+}
+
+CppVarType::ModifierRef::~ModifierRef()
+{
+  // Modifier is mostly just read, which needs no interning.
+  const auto& typeModifier = varType_.type_->typeModifier;
+  if ((modifier_.refType_ != typeModifier.refType_) || (modifier_.ptrLevel_ != typeModifier.ptrLevel_)
+      || (modifier_.constBits_ != typeModifier.constBits_))
+  {
+    varType_.typeModifier(modifier_);
+  }
+}
+
 CppVarType::CppVarType(std::string baseType, CppTypeModifier modifier)
-  : CppVarType(std::move(baseType), 0, modifier)
+  : CppVarType(CppInternedType {CppSymbol(baseType), modifier, 0, false}, nullptr)
 {
 }
 
 CppVarType::CppVarType(CppCompound* compound, CppTypeModifier modifier)
-  : compound_(compound)
-  , typeModifier_(modifier)
+  : CppVarType(CppInternedType {CppSymbol(), modifier, 0, false}, compound)
 {
 }
 
-CppVarType::CppVarType(CppFunctionPointer* compound, CppTypeModifier modifier)
-  : compound_(compound)
-  , typeModifier_(modifier)
+CppVarType::CppVarType(CppFunctionPointer* fptr, CppTypeModifier modifier)
+  : CppVarType(CppInternedType {CppSymbol(), modifier, 0, false}, fptr)
 {
 }
 
 CppVarType::CppVarType(CppEnum* enumObj, CppTypeModifier modifier)
-  : compound_(enumObj)
-  , typeModifier_(modifier)
+  : CppVarType(CppInternedType {CppSymbol(), modifier, 0, false}, enumObj)
 {
 }
 
 CppVarType::CppVarType(const CppVarType& varType)
-  : CppVarType(varType.baseType(), varType.typeModifier())
 {
+  intern(*varType.type_);
   // TODO: clone compound_.
 }
 
-CppVarType::CppVarType(std::string baseType, std::uint32_t typeAttr, CppTypeModifier modifier)
-  : baseType_(std::move(baseType))
-  , typeModifier_(modifier)
-  , typeAttr_(typeAttr)
+CppVarType::~CppVarType()
+{
+  if (type_->ofNoTable)
+    delete type_;
+}
+
+CppVarType::CppVarType(CppInternedType type, CppEntity* compound)
+  : compound_(compound)
+{
+  intern(type);
+}
+
+void CppVarType::baseType(const std::string& baseTypeArg)
+{
+  auto type     = *type_;
+  type.baseType = CppSymbol(baseTypeArg);
+  intern(type);
+}
+
+void CppVarType::typeAttr(std::uint32_t attr)
+{
+  auto type     = *type_;
+  type.typeAttr = attr;
+  intern(type);
+}
+
+void CppVarType::addAttr(std::uint32_t attr)
+{
+  auto type = *type_;
+  if ((attr & CppIdentifierAttrib::CONST) == 0)
+    type.typeAttr |= attr;
+  else
+    type.typeModifier.constBits_ |= 1;
+  intern(type);
+}
+
+void CppVarType::typeModifier(CppTypeModifier modifier)
+{
+  auto type         = *type_;
+  type.typeModifier = modifier;
+  intern(type);
+}
+
+void CppVarType::parameterPack(bool paramPack)
+{
+  auto type      = *type_;
+  type.paramPack = paramPack;
+  intern(type);
+}
+
+void CppVarType::intern(const CppInternedType& type)
 {
+  // Without a table the type keeps its own description that is released with it.
+  auto* const symbolTable = CppSymbolTable::current();
+  auto* const prevType    = type_;
+  if (symbolTable)
+  {
+    type_ = symbolTable->intern(type);
+  }
+  else
+  {
+    auto* const ownType = new CppInternedType(type);
+    ownType->ofNoTable  = true;
+    type_               = ownType;
+  }
+  if (prevType && prevType->ofNoTable)
+    delete prevType;
 }
 
 } // namespace cppast
@@ -0,0 +1,78 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cpp_binary_ast.h"
+#include "cppast/cppast.h"
+
+namespace {
+
+std::unique_ptr<cppast::CppCompound> MakeTestAst()
+{
+  auto ast = std::make_unique<cppast::CppCompound>(cppast::CppCompoundType::FILE);
+  ast->add(std::make_unique<cppast::CppPreprocessorDefine>(
+    cppast::CppPreprocessorDefineType::RENAME, "TEST_MACRO", cppast::CppText(std::string("1"))));
+
+  auto cls = std::make_unique<cppast::CppCompound>("TestClass", cppast::CppCompoundType::CLASS);
+  cls->add(std::make_unique<cppast::CppEntityAccessSpecifier>(cppast::CppAccessType::PUBLIC));
+
+  std::vector<std::unique_ptr<cppast::CppEntity>> params;
+  params.push_back(std::make_unique<cppast::CppVar>(
+    std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), cppast::CppVarDecl("x")));
+  auto func = std::make_unique<cppast::CppFunction>(
+    "Twice", std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), std::move(params), 0);
+  auto body = std::make_unique<cppast::CppCompound>(cppast::CppCompoundType::BLOCK);
+  body->add(std::make_unique<cppast::CppReturnStatement>(
+    std::make_unique<cppast::CppBinomialExpr>(cppast::CppBinaryOperator::MUL,
+                                              std::make_unique<cppast::CppNameExpr>("x"),
+                                              std::make_unique<cppast::CppNumberLiteralExpr>("2"))));
+  func->defn(std::move(body));
+  cls->add(std::move(func));
+
+  std::unique_ptr<cppast::CppExpression> memberInit = std::make_unique<cppast::CppNumberLiteralExpr>("0.5");
+  cls->add(std::make_unique<cppast::CppVar>(std::make_unique<cppast::CppVarType>("double", cppast::CppTypeModifier()),
+                                            cppast::CppVarDecl("member_", std::move(memberInit))));
+  ast->add(std::move(cls));
+
+  cppast::CppEnumItemList items;
+  items.emplace_back("RED");
+  items.emplace_back("GREEN", std::make_unique<cppast::CppNumberLiteralExpr>("2"));
+  ast->add(std::make_unique<cppast::CppEnum>("Color", std::move(items), true, "int"));
+  ast->add(std::make_unique<cppast::CppBlob>(cppast::CppText(std::string("some blob"))));
+
+  return ast;
+}
+
+} // namespace
+
+TEST_CASE("Binary AST round trip")
+{
+  const auto ast  = MakeTestAst();
+  const auto data = cppast::WriteBinaryAst(*ast);
+
+  const auto readAst = cppast::ReadBinaryAst(data);
+  REQUIRE(readAst != nullptr);
+  CHECK(readAst->compoundType() == cppast::CppCompoundType::FILE);
+  CHECK(cppast::WriteBinaryAst(*readAst) == data);
+
+  const auto members = GetAllOwnedEntities(*readAst);
+  REQUIRE(members.size() == 4);
+  cppast::CppConstCompoundEPtr cls = members[1];
+  REQUIRE(cls);
+  CHECK(cls->name() == "TestClass");
+  cppast::CppConstEnumEPtr enumObj = members[2];
+  REQUIRE(enumObj);
+  CHECK(enumObj->isClass());
+  CHECK(enumObj->itemList().size() == 2);
+}
+
+TEST_CASE("Invalid binary AST is rejected")
+{
+  const auto data = cppast::WriteBinaryAst(*MakeTestAst());
+
+  CHECK(cppast::ReadBinaryAst("") == nullptr);
+  CHECK(cppast::ReadBinaryAst(data.substr(0, data.size() / 2)) == nullptr);
+  CHECK(cppast::ReadBinaryAst(data + '\0') == nullptr);
+
+  auto wrongMagic = data;
+  wrongMagic[0]   = 'X';
+  CHECK(cppast::ReadBinaryAst(wrongMagic) == nullptr);
+}
@@ -0,0 +1,35 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+#include <memory>
+
+namespace {
+
+std::unique_ptr<cppast::CppExpression> MakeSum()
+{
+  return std::make_unique<cppast::CppBinomialExpr>(cppast::CppBinaryOperator::PLUS,
+                                                   std::make_unique<cppast::CppNameExpr>("x"),
+                                                   std::make_unique<cppast::CppNumberLiteralExpr>("1"));
+}
+
+} // namespace
+
+TEST_CASE("Entities are allocated from the current arena")
+{
+  cppast::CppEntityArena arena(256);
+  {
+    cppast::CppEntityArena::Scope arenaScope(arena);
+    CHECK(cppast::CppEntityArena::current() == &arena);
+
+    const auto sum      = MakeSum();
+    const auto compound = std::make_unique<cppast::CppCompound>("Point", cppast::CppCompoundType::STRUCT);
+    CHECK(arena.numAllocations() == 4);
+    CHECK(arena.bytesAllocated() >= 3 * sizeof(cppast::CppNameExpr) + sizeof(cppast::CppCompound));
+  }
+  CHECK(cppast::CppEntityArena::current() == nullptr);
+
+  // Without a current arena entities are allocated from heap, and both kinds are deleted the same way.
+  const auto sum = MakeSum();
+  CHECK(arena.numAllocations() == 4);
+}
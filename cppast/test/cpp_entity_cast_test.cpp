@@ -17,3 +17,175 @@ TEST_CASE("Casting of const CppEntity* to derived class")
   cppast::CppConstCompoundEPtr compoundPtr = entity;
   CHECK(compoundPtr);
 }
+
+namespace {
+
+template <typename... Ts>
+struct TypeList
+{
+};
+
+using CastTargets = TypeList<cppast::CppAsmBlock,
+                             cppast::CppAtomicExpr,
+                             cppast::CppBinomialExpr,
+                             cppast::CppBlob,
+                             cppast::CppCharLiteralExpr,
+                             cppast::CppCompound,
+                             cppast::CppConstCastExpr,
+                             cppast::CppConstructor,
+                             cppast::CppCStyleTypecastExpr,
+                             cppast::CppDestructor,
+                             cppast::CppDocumentationComment,
+                             cppast::CppDoWhileBlock,
+                             cppast::CppDynamiCastExpr,
+                             cppast::CppEntityAccessSpecifier,
+                             cppast::CppEnum,
+                             cppast::CppExpression,
+                             cppast::CppForBlock,
+                             cppast::CppForwardClassDecl,
+                             cppast::CppFunction,
+                             cppast::CppFunctionCallExpr,
+                             cppast::CppFunctionPointer,
+                             cppast::CppFunctionStyleTypecastExpr,
+                             cppast::CppGotoStatement,
+                             cppast::CppIfBlock,
+                             cppast::CppInitializerListExpr,
+                             cppast::CppLabel,
+                             cppast::CppLambda,
+                             cppast::CppLambdaExpr,
+                             cppast::CppMacroCall,
+                             cppast::CppMonomialExpr,
+                             cppast::CppNameExpr,
+                             cppast::CppNamespaceAlias,
+                             cppast::CppNumberLiteralExpr,
+                             cppast::CppPreprocessor,
+                             cppast::CppPreprocessorConditional,
+                             cppast::CppPreprocessorDefine,
+                             cppast::CppPreprocessorError,
+                             cppast::CppPreprocessorImport,
+                             cppast::CppPreprocessorInclude,
+                             cppast::CppPreprocessorPragma,
+                             cppast::CppPreprocessorUndef,
+                             cppast::CppPreprocessorUnrecognized,
+                             cppast::CppPreprocessorWarning,
+                             cppast::CppRangeForBlock,
+                             cppast::CppReinterpretCastExpr,
+                             cppast::CppReturnStatement,
+                             cppast::CppStaticCastExpr,
+                             cppast::CppStringLiteralExpr,
+                             cppast::CppSwitchBlock,
+                             cppast::CppThrowStatement,
+                             cppast::CppTrinomialExpr,
+                             cppast::CppTryBlock,
+                             cppast::CppTypecastExpr,
+                             cppast::CppTypeConverter,
+                             cppast::CppTypedefList,
+                             cppast::CppTypedefName,
+                             cppast::CppUniformInitializerExpr,
+                             cppast::CppUsingDecl,
+                             cppast::CppUsingNamespaceDecl,
+                             cppast::CppVar,
+                             cppast::CppVarDeclInList,
+                             cppast::CppVarList,
+                             cppast::CppVarType,
+                             cppast::CppVartypeExpr,
+                             cppast::CppWhileBlock>;
+
+std::unique_ptr<cppast::CppVarType> MakeVarType()
+{
+  return std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier());
+}
+
+std::unique_ptr<cppast::CppExpression> MakeName()
+{
+  return std::make_unique<cppast::CppNameExpr>("x");
+}
+
+std::vector<std::unique_ptr<cppast::CppEntity>> MakeEntityOfEveryKind()
+{
+  using namespace cppast;
+
+  std::vector<std::unique_ptr<CppEntity>> entities;
+  entities.push_back(std::make_unique<CppAsmBlock>("nop"));
+  entities.push_back(std::make_unique<CppBlob>(CppText(std::string("blob"))));
+  entities.push_back(std::make_unique<CppCompound>("TestClass", CppCompoundType::CLASS));
+  entities.push_back(std::make_unique<CppDestructor>("~TestClass", 0));
+  entities.push_back(std::make_unique<CppDocumentationComment>(CppText(std::string("// doc"))));
+  entities.push_back(std::make_unique<CppEntityAccessSpecifier>(CppAccessType::PUBLIC));
+  entities.push_back(std::make_unique<CppEnum>("TestEnum", CppEnumItemList()));
+  entities.push_back(std::make_unique<CppForwardClassDecl>("TestClass", CppCompoundType::CLASS));
+  entities.push_back(
+    std::make_unique<CppFunction>("Test", MakeVarType(), std::vector<std::unique_ptr<CppEntity>>(), 0));
+  entities.push_back(
+    std::make_unique<CppFunctionPointer>("TestPtr", MakeVarType(), std::vector<std::unique_ptr<CppEntity>>(), 0));
+  entities.push_back(std::make_unique<CppGotoStatement>(MakeName()));
+  entities.push_back(std::make_unique<CppLabel>("label"));
+  entities.push_back(std::make_unique<CppMacroCall>("MACRO()"));
+  entities.push_back(std::make_unique<CppNamespaceAlias>("ns", "alias"));
+  entities.push_back(std::make_unique<CppReturnStatement>(MakeName()));
+  entities.push_back(std::make_unique<CppThrowStatement>(MakeName()));
+  entities.push_back(std::make_unique<CppUsingNamespaceDecl>("std"));
+  entities.push_back(std::make_unique<CppVar>(MakeVarType(), CppVarDecl("x")));
+  entities.push_back(std::make_unique<CppWhileBlock>(MakeName(), MakeName()));
+  entities.push_back(std::make_unique<CppDoWhileBlock>(MakeName(), MakeName()));
+  entities.push_back(std::make_unique<CppIfBlock>(MakeName(), MakeName()));
+
+  entities.push_back(std::make_unique<CppStringLiteralExpr>("\"str\""));
+  entities.push_back(std::make_unique<CppCharLiteralExpr>("'c'"));
+  entities.push_back(std::make_unique<CppNumberLiteralExpr>("1"));
+  entities.push_back(MakeName());
+  entities.push_back(std::make_unique<CppVartypeExpr>(MakeVarType()));
+  entities.push_back(std::make_unique<CppMonomialExpr>(CppUnaryOperator::UNARY_MINUS, MakeName()));
+  entities.push_back(std::make_unique<CppBinomialExpr>(CppBinaryOperator::PLUS, MakeName(), MakeName()));
+  entities.push_back(
+    std::make_unique<CppTrinomialExpr>(CppTernaryOperator::CONDITIONAL, MakeName(), MakeName(), MakeName()));
+  entities.push_back(std::make_unique<CppFunctionCallExpr>(MakeName(), std::vector<std::unique_ptr<CppExpression>>()));
+  entities.push_back(std::make_unique<CppUniformInitializerExpr>("x", std::vector<std::unique_ptr<CppExpression>>()));
+  entities.push_back(std::make_unique<CppInitializerListExpr>(std::vector<std::unique_ptr<CppExpression>>()));
+  entities.push_back(std::make_unique<CppCStyleTypecastExpr>(MakeVarType(), MakeName()));
+  entities.push_back(std::make_unique<CppFunctionStyleTypecastExpr>(MakeVarType(), MakeName()));
+  entities.push_back(std::make_unique<CppStaticCastExpr>(MakeVarType(), MakeName()));
+  entities.push_back(std::make_unique<CppConstCastExpr>(MakeVarType(), MakeName()));
+  entities.push_back(std::make_unique<CppDynamiCastExpr>(MakeVarType(), MakeName()));
+  entities.push_back(std::make_unique<CppReinterpretCastExpr>(MakeVarType(), MakeName()));
+
+  entities.push_back(std::make_unique<CppPreprocessorConditional>(PreprocessorConditionalType::ENDIF));
+  entities.push_back(std::make_unique<CppPreprocessorDefine>(CppPreprocessorDefineType::RENAME, "MACRO"));
+  entities.push_back(std::make_unique<CppPreprocessorError>("error"));
+  entities.push_back(std::make_unique<CppPreprocessorImport>("<module>"));
+  entities.push_back(std::make_unique<CppPreprocessorInclude>("<header.h>"));
+  entities.push_back(std::make_unique<CppPreprocessorPragma>("once"));
+  entities.push_back(std::make_unique<CppPreprocessorUndef>("MACRO"));
+  entities.push_back(std::make_unique<CppPreprocessorUnrecognized>("unknown", "directive"));
+  entities.push_back(std::make_unique<CppPreprocessorWarning>("warning"));
+
+  return entities;
+}
+
+template <typename T>
+void CheckCastsTo(const std::vector<std::unique_ptr<cppast::CppEntity>>& entities)
+{
+  for (const auto& entity : entities)
+  {
+    cppast::CppEntity*       mutableEntity = entity.get();
+    const cppast::CppEntity* constEntity   = entity.get();
+    CHECK(cppast::helper::CppEntityPtr<T>(mutableEntity).get() == dynamic_cast<T*>(mutableEntity));
+    CHECK(cppast::helper::CppEntityPtr<const T>(constEntity).get() == dynamic_cast<const T*>(constEntity));
+  }
+}
+
+template <typename... Ts>
+void CheckCasts(const std::vector<std::unique_ptr<cppast::CppEntity>>& entities, TypeList<Ts...>)
+{
+  (CheckCastsTo<Ts>(entities), ...);
+}
+
+} // namespace
+
+TEST_CASE("Casting by type tags agrees with dynamic_cast")
+{
+  CheckCasts(MakeEntityOfEveryKind(), CastTargets());
+
+  const cppast::CppEntity* nullEntity = nullptr;
+  CHECK_FALSE(cppast::CppConstCompoundEPtr(nullEntity));
+}
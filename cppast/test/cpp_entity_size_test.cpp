@@ -0,0 +1,113 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+#include <cstdint>
+
+// Size budgets are sizes of 64 bit builds with libstdc++, other standard libraries are not bigger in release builds.
+#if (UINTPTR_MAX == UINT64_MAX) && !(defined(_MSC_VER) && defined(_DEBUG))
+
+#define CHECK_SIZE_BUDGET(Class, budget)                                                                               \
+  static_assert(sizeof(cppast::Class) <= (budget), #Class " has outgrown its size budget");                            \
+  static_assert(alignof(cppast::Class) <= alignof(void*), #Class " needs more alignment than CppEntity allocates for")
+
+CHECK_SIZE_BUDGET(CppAsmBlock, 64);
+CHECK_SIZE_BUDGET(CppBinomialExpr, 48);
+CHECK_SIZE_BUDGET(CppBlob, 72);
+CHECK_SIZE_BUDGET(CppCharLiteralExpr, 64);
+CHECK_SIZE_BUDGET(CppCompound, 104);
+CHECK_SIZE_BUDGET(CppConstCastExpr, 48);
+CHECK_SIZE_BUDGET(CppConstructor, 144);
+CHECK_SIZE_BUDGET(CppCStyleTypecastExpr, 48);
+CHECK_SIZE_BUDGET(CppDestructor, 96);
+CHECK_SIZE_BUDGET(CppDocumentationComment, 72);
+CHECK_SIZE_BUDGET(CppDoWhileBlock, 48);
+CHECK_SIZE_BUDGET(CppDynamiCastExpr, 48);
+CHECK_SIZE_BUDGET(CppEntityAccessSpecifier, 32);
+CHECK_SIZE_BUDGET(CppEnum, 120);
+CHECK_SIZE_BUDGET(CppForBlock, 64);
+CHECK_SIZE_BUDGET(CppForwardClassDecl, 64);
+CHECK_SIZE_BUDGET(CppFunction, 128);
+CHECK_SIZE_BUDGET(CppFunctionCallExpr, 64);
+CHECK_SIZE_BUDGET(CppFunctionPointer, 160);
+CHECK_SIZE_BUDGET(CppFunctionStyleTypecastExpr, 48);
+CHECK_SIZE_BUDGET(CppGotoStatement, 40);
+CHECK_SIZE_BUDGET(CppIfBlock, 56);
+CHECK_SIZE_BUDGET(CppInitializerListExpr, 56);
+CHECK_SIZE_BUDGET(CppLabel, 64);
+CHECK_SIZE_BUDGET(CppLambda, 88);
+CHECK_SIZE_BUDGET(CppLambdaExpr, 40);
+CHECK_SIZE_BUDGET(CppMacroCall, 64);
+CHECK_SIZE_BUDGET(CppMonomialExpr, 40);
+CHECK_SIZE_BUDGET(CppNameExpr, 40);
+CHECK_SIZE_BUDGET(CppNamespaceAlias, 96);
+CHECK_SIZE_BUDGET(CppNumberLiteralExpr, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorConditional, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorDefine, 104);
+CHECK_SIZE_BUDGET(CppPreprocessorError, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorImport, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorInclude, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorPragma, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorUndef, 64);
+CHECK_SIZE_BUDGET(CppPreprocessorUnrecognized, 96);
+CHECK_SIZE_BUDGET(CppPreprocessorWarning, 64);
+CHECK_SIZE_BUDGET(CppRangeForBlock, 56);
+CHECK_SIZE_BUDGET(CppReinterpretCastExpr, 48);
+CHECK_SIZE_BUDGET(CppReturnStatement, 40);
+CHECK_SIZE_BUDGET(CppStaticCastExpr, 48);
+CHECK_SIZE_BUDGET(CppStringLiteralExpr, 64);
+CHECK_SIZE_BUDGET(CppSwitchBlock, 64);
+CHECK_SIZE_BUDGET(CppThrowStatement, 40);
+CHECK_SIZE_BUDGET(CppTrinomialExpr, 56);
+CHECK_SIZE_BUDGET(CppTryBlock, 64);
+CHECK_SIZE_BUDGET(CppTypeConverter, 104);
+CHECK_SIZE_BUDGET(CppTypedefList, 40);
+CHECK_SIZE_BUDGET(CppTypedefName, 40);
+CHECK_SIZE_BUDGET(CppUniformInitializerExpr, 64);
+CHECK_SIZE_BUDGET(CppUsingDecl, 88);
+CHECK_SIZE_BUDGET(CppUsingNamespaceDecl, 64);
+CHECK_SIZE_BUDGET(CppVar, 128);
+CHECK_SIZE_BUDGET(CppVarList, 64);
+CHECK_SIZE_BUDGET(CppVartypeExpr, 40);
+CHECK_SIZE_BUDGET(CppWhileBlock, 48);
+
+// Not entities themselves but parts of every entity or of many.
+CHECK_SIZE_BUDGET(CppEntity, 32);
+CHECK_SIZE_BUDGET(CppVarType, 24);
+
+#undef CHECK_SIZE_BUDGET
+
+#endif
+
+TEST_CASE("Fields that are out of line read back what was set")
+{
+  cppast::CppCompound compound("TestClass", cppast::CppCompoundType::CLASS);
+  CHECK(compound.apidecor().empty());
+  CHECK(compound.inheritanceList().empty());
+  CHECK_FALSE(compound.isTemplated());
+
+  compound.apidecor("DLL_EXPORT");
+  compound.inheritanceList({cppast::CppInheritanceInfo {"Base", cppast::CppAccessType::PUBLIC, false}});
+  compound.templateSpecification(cppast::CppTemplateParams());
+  CHECK(compound.apidecor() == "DLL_EXPORT");
+  REQUIRE(compound.inheritanceList().size() == 1);
+  CHECK(compound.inheritanceList().front().baseName == "Base");
+  CHECK(compound.isTemplated());
+
+  cppast::CppFunction func("Test", std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), {}, 0);
+  CHECK(func.decor1().empty());
+  CHECK(func.throwSpec().empty());
+  func.decor1("__declspec(dllexport)");
+  func.decor2("__stdcall");
+  func.throwSpec({"std::exception"});
+  CHECK(func.decor1() == "__declspec(dllexport)");
+  CHECK(func.decor2() == "__stdcall");
+  CHECK(func.throwSpec() == std::vector<std::string> {"std::exception"});
+
+  cppast::CppVar var(std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), cppast::CppVarDecl("x"));
+  CHECK(var.arraySizes().empty());
+  var.addArraySize(new cppast::CppNumberLiteralExpr("4"));
+  var.apidecor("WINAPI");
+  CHECK(var.arraySizes().size() == 1);
+  CHECK(var.apidecor() == "WINAPI");
+}
@@ -0,0 +1,149 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+namespace {
+
+cppast::CppTypeModifier PointerModifier()
+{
+  cppast::CppTypeModifier modifier {};
+  modifier.ptrLevel_ = 1;
+  return modifier;
+}
+
+} // namespace
+
+TEST_CASE("Equal types share one interned type")
+{
+  cppast::CppSymbolTable        symbolTable;
+  cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+
+  cppast::CppVarType intType1("int", cppast::CppTypeModifier());
+  cppast::CppVarType intType2("int", cppast::CppTypeModifier());
+  cppast::CppVarType intPtrType("int", PointerModifier());
+  cppast::CppVarType charPtrType("char", PointerModifier());
+
+  CHECK(&intType1.internedType() == &intType2.internedType());
+  CHECK(intType1 == intType2);
+  CHECK(intType1 != intPtrType);
+  CHECK(intPtrType != charPtrType);
+  CHECK(intPtrType.typeModifier().ptrLevel_ == 1);
+  CHECK(charPtrType.baseType() == "char");
+
+  const auto stats = symbolTable.stats();
+  CHECK(stats.numTypes == 3);
+  CHECK(stats.numTypesInterned == 4);
+}
+
+TEST_CASE("Modifying a type does not modify the types it was shared with")
+{
+  cppast::CppSymbolTable        symbolTable;
+  cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+
+  cppast::CppVarType intType("int", cppast::CppTypeModifier());
+  cppast::CppVarType constIntType("int", cppast::CppTypeModifier());
+  constIntType.addAttr(cppast::CppIdentifierAttrib::CONST);
+  constIntType.addAttr(cppast::CppIdentifierAttrib::STATIC);
+
+  CHECK_FALSE(cppast::IsConst(intType));
+  CHECK(intType.typeAttr() == 0);
+  CHECK(cppast::IsConst(constIntType));
+  CHECK(constIntType.typeAttr() == cppast::CppIdentifierAttrib::STATIC);
+  CHECK(intType != constIntType);
+
+  cppast::CppVarType copiedType(constIntType);
+  CHECK(&copiedType.internedType() == &constIntType.internedType());
+  CHECK(copiedType == constIntType);
+
+  copiedType.baseType("long");
+  copiedType.typeModifier(PointerModifier());
+  copiedType.parameterPack(true);
+  CHECK(constIntType.baseType() == "int");
+  CHECK(copiedType.baseType() == "long");
+  CHECK(copiedType.typeModifier().ptrLevel_ == 1);
+  CHECK(copiedType.parameterPack());
+  CHECK_FALSE(constIntType.parameterPack());
+
+  intType.addAttr(cppast::CppIdentifierAttrib::CONST);
+  intType.addAttr(cppast::CppIdentifierAttrib::STATIC);
+  CHECK(&intType.internedType() == &constIntType.internedType());
+}
+
+TEST_CASE("Types defined in place are equal only to themselves")
+{
+  cppast::CppVarType structType1(new cppast::CppCompound(cppast::CppCompoundType::STRUCT), cppast::CppTypeModifier());
+  cppast::CppVarType structType2(new cppast::CppCompound(cppast::CppCompoundType::STRUCT), cppast::CppTypeModifier());
+
+  CHECK(structType1 == structType1);
+  CHECK(structType1 != structType2);
+}
+
+TEST_CASE("Types of different tables are compared by their content")
+{
+  cppast::CppSymbolTable symbolTable1;
+  cppast::CppSymbolTable symbolTable2;
+
+  const auto makeType = [](cppast::CppSymbolTable& symbolTable, const char* baseType) {
+    cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+    return std::make_unique<cppast::CppVarType>(baseType, PointerModifier());
+  };
+
+  const auto type1 = makeType(symbolTable1, "wxString");
+  const auto type2 = makeType(symbolTable2, "wxString");
+  const auto type3 = makeType(symbolTable2, "AcDbObjectId");
+  CHECK(&type1->internedType() != &type2->internedType());
+  CHECK(*type1 == *type2);
+  CHECK(*type1 != *type3);
+}
+
+TEST_CASE("Modifier of a type can be changed in place")
+{
+  cppast::CppSymbolTable        symbolTable;
+  cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+
+  cppast::CppVarType intType("int", cppast::CppTypeModifier());
+  cppast::CppVarType otherIntType("int", cppast::CppTypeModifier());
+
+  intType.typeModifier().ptrLevel_ = 2;
+  CHECK(cppast::PtrLevel(intType) == 2);
+  CHECK(cppast::PtrLevel(otherIntType) == 0);
+
+  {
+    auto&& modifier   = intType.typeModifier();
+    modifier.refType_ = cppast::CppRefType::BY_REF;
+    modifier.constBits_ |= 1;
+  }
+  CHECK(cppast::IsByRef(intType));
+  CHECK(cppast::IsConst(intType));
+  CHECK(cppast::PtrLevel(intType) == 2);
+  CHECK_FALSE(cppast::IsByRef(otherIntType));
+
+  cppast::CppTypeModifier modifier {cppast::CppRefType::BY_REF, 2, 1};
+  cppast::CppVarType      sameType("int", modifier);
+  CHECK(&sameType.internedType() == &intType.internedType());
+}
+
+TEST_CASE("Copy of a type outlives the table of the original")
+{
+  cppast::CppSymbolTable              copyTable;
+  std::unique_ptr<cppast::CppVarType> copiedType;
+  {
+    cppast::CppSymbolTable              symbolTable;
+    std::unique_ptr<cppast::CppVarType> type;
+    {
+      cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+      type = std::make_unique<cppast::CppVarType>("wxString", PointerModifier());
+    }
+
+    cppast::CppSymbolTable::Scope symbolTableScope(copyTable);
+    copiedType = std::make_unique<cppast::CppVarType>(*type);
+    CHECK(&copiedType->internedType() != &type->internedType());
+    CHECK(*copiedType == *type);
+  }
+
+  CHECK(copiedType->baseType() == "wxString");
+  CHECK(cppast::PtrLevel(*copiedType) == 1);
+  const auto stats = copyTable.stats();
+  CHECK(stats.numSymbols == 1);
+  CHECK(stats.numTypes == 1);
+}
@@ -0,0 +1,111 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cpp_mapped_ast.h"
+#include "cppast/cppast.h"
+
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+std::unique_ptr<cppast::CppCompound> MakeTestAst()
+{
+  auto ast = std::make_unique<cppast::CppCompound>("test.h", cppast::CppCompoundType::FILE);
+
+  auto cls = std::make_unique<cppast::CppCompound>("TestClass", cppast::CppCompoundType::CLASS);
+  cls->add(std::make_unique<cppast::CppEntityAccessSpecifier>(cppast::CppAccessType::PUBLIC));
+  std::vector<std::unique_ptr<cppast::CppEntity>> params;
+  params.push_back(std::make_unique<cppast::CppVar>(
+    std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), cppast::CppVarDecl("x")));
+  auto func = std::make_unique<cppast::CppFunction>(
+    "Twice", std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), std::move(params), 0);
+  auto body = std::make_unique<cppast::CppCompound>(cppast::CppCompoundType::BLOCK);
+  body->add(std::make_unique<cppast::CppReturnStatement>(std::make_unique<cppast::CppNameExpr>("x")));
+  func->defn(std::move(body));
+  cls->add(std::move(func));
+  cls->add(std::make_unique<cppast::CppVar>(std::make_unique<cppast::CppVarType>("double", cppast::CppTypeModifier()),
+                                            cppast::CppVarDecl("member_")));
+  ast->add(std::move(cls));
+
+  ast->add(std::make_unique<cppast::CppFunction>("Declared",
+                                                 std::make_unique<cppast::CppVarType>("void", cppast::CppTypeModifier()),
+                                                 std::vector<std::unique_ptr<cppast::CppEntity>>(),
+                                                 0));
+
+  return ast;
+}
+
+} // namespace
+
+TEST_CASE("Mapped AST is traversed in place")
+{
+  const auto data      = cppast::WriteMappedAst(*MakeTestAst());
+  const auto mappedAst = cppast::CppMappedAst::fromBuffer(data);
+  REQUIRE(mappedAst != nullptr);
+
+  const auto root = mappedAst->root();
+  CHECK(root.entityType() == cppast::CppEntityType::COMPOUND);
+  CHECK(root.compoundType() == cppast::CppCompoundType::FILE);
+  CHECK(root.name() == "test.h");
+  CHECK(!root.owner());
+
+  const auto members = cppast::GetAllOwnedEntities(root);
+  REQUIRE(members.size() == 2);
+  const auto cls = members[0];
+  CHECK(cls.name() == "TestClass");
+  CHECK(cls.compoundType() == cppast::CppCompoundType::CLASS);
+
+  const auto funcs = cppast::GetOwnedEntities<cppast::CppFunction>(cls);
+  REQUIRE(funcs.size() == 1);
+  const auto func = funcs[0];
+  CHECK(func.name() == "Twice");
+  REQUIRE(func.owner());
+  CHECK(func.owner()->name() == "TestClass");
+  REQUIRE(func.numChildren() == 1);
+  CHECK(func.child(0).name() == "x");
+  const auto defn = func.defn();
+  REQUIRE(defn);
+  CHECK(defn->compoundType() == cppast::CppCompoundType::BLOCK);
+  REQUIRE(defn->numChildren() == 1);
+  CHECK(defn->child(0).entityType() == cppast::CppEntityType::RETURN_STATEMENT);
+
+  const auto vars = cppast::GetOwnedEntities<cppast::CppVar>(cls);
+  REQUIRE(vars.size() == 1);
+  CHECK(vars[0].name() == "member_");
+
+  CHECK(members[1].name() == "Declared");
+  CHECK(!members[1].defn());
+}
+
+TEST_CASE("Mapped AST is opened from file")
+{
+  const auto filename = (std::filesystem::temp_directory_path() / "cppast-mapped-ast-test.astv").string();
+  {
+    const auto    data = cppast::WriteMappedAst(*MakeTestAst());
+    std::ofstream stm(filename, std::ios::binary);
+    stm.write(data.data(), data.size());
+  }
+
+  const auto mappedAst = cppast::CppMappedAst::open(filename);
+  REQUIRE(mappedAst != nullptr);
+  CHECK(cppast::GetAllOwnedEntities(mappedAst->root()).size() == 2);
+
+  std::filesystem::remove(filename);
+  CHECK(cppast::CppMappedAst::open(filename) == nullptr);
+}
+
+TEST_CASE("Invalid mapped AST is rejected")
+{
+  const auto data = cppast::WriteMappedAst(*MakeTestAst());
+
+  CHECK(cppast::CppMappedAst::fromBuffer(std::string()) == nullptr);
+  CHECK(cppast::CppMappedAst::fromBuffer(data.substr(0, data.size() - 1)) == nullptr);
+
+  // First child of root is moved to point back at root itself.
+  auto cyclic     = data;
+  cyclic[24 + 20] = 0;
+  cyclic[24 + 21] = 0;
+  cyclic[24 + 22] = 0;
+  cyclic[24 + 23] = 0;
+  CHECK(cppast::CppMappedAst::fromBuffer(cyclic) == nullptr);
+}
@@ -0,0 +1,164 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+#include <string>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<cppast::CppVarType> MakeIntType()
+{
+  return std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier());
+}
+
+std::unique_ptr<cppast::CppExpression> MakeName(std::string name)
+{
+  return std::make_unique<cppast::CppNameExpr>(std::move(name));
+}
+
+std::unique_ptr<cppast::CppExpression> MakeNumber(std::string number)
+{
+  return std::make_unique<cppast::CppNumberLiteralExpr>(std::move(number));
+}
+
+std::vector<std::unique_ptr<cppast::CppEntity>> MakeIntParam(std::string name)
+{
+  std::vector<std::unique_ptr<cppast::CppEntity>> params;
+  params.push_back(std::make_unique<cppast::CppVar>(MakeIntType(), cppast::CppVarDecl(std::move(name))));
+  return params;
+}
+
+/**
+ * Builds AST of:
+ * class A {
+ *   int f(int x) { if (x) { return g(x, 1); } else throw 0; }
+ * };
+ * auto l = [](int y) { return y; };
+ */
+std::unique_ptr<cppast::CppCompound> MakeFileAst()
+{
+  using namespace cppast;
+
+  std::vector<std::unique_ptr<CppExpression>> args;
+  args.push_back(MakeName("x"));
+  args.push_back(MakeNumber("1"));
+  auto ifBody = std::make_unique<CppCompound>(CppCompoundType::BLOCK);
+  auto call = std::make_unique<CppFunctionCallExpr>(MakeName("g"), std::move(args));
+  ifBody->add(std::make_unique<CppReturnStatement>(std::move(call)));
+  auto funcBody = std::make_unique<CppCompound>(CppCompoundType::BLOCK);
+  auto elsePart = std::make_unique<CppThrowStatement>(MakeNumber("0"));
+  funcBody->add(std::make_unique<CppIfBlock>(MakeName("x"), std::move(ifBody), std::move(elsePart)));
+  auto func = std::make_unique<CppFunction>("f", MakeIntType(), MakeIntParam("x"), 0);
+  func->defn(CppLazyCompound(std::move(funcBody)));
+  auto cls = std::make_unique<CppCompound>("A", CppCompoundType::CLASS);
+  cls->add(std::move(func));
+
+  auto lambdaBody = std::make_unique<CppCompound>(CppCompoundType::BLOCK);
+  lambdaBody->add(std::make_unique<CppReturnStatement>(MakeName("y")));
+  auto lambda = std::make_unique<CppLambda>(nullptr, MakeIntParam("y"), CppLazyCompound(std::move(lambdaBody)));
+  std::unique_ptr<CppExpression> lambdaExpr = std::make_unique<CppLambdaExpr>(std::move(lambda));
+  auto var = std::make_unique<CppVar>(std::make_unique<CppVarType>("auto", CppTypeModifier()),
+                                      CppVarDecl("l", std::move(lambdaExpr)));
+
+  auto fileAst = std::make_unique<CppCompound>(CppCompoundType::FILE);
+  fileAst->add(std::move(cls));
+  fileAst->add(std::move(var));
+  return fileAst;
+}
+
+class TrailRecorder : public cppast::CppRecursiveAstVisitor<TrailRecorder>
+{
+public:
+  cppast::CppVisitAction preVisit(const cppast::CppFunction& func)
+  {
+    trail.push_back("function " + func.name());
+    return cppast::CppVisitAction::CONTINUE;
+  }
+
+  cppast::CppVisitAction preVisit(const cppast::CppVar& var)
+  {
+    trail.push_back("var " + var.name());
+    return cppast::CppVisitAction::CONTINUE;
+  }
+
+  cppast::CppVisitAction preVisit(const cppast::CppLambda&)
+  {
+    trail.push_back("lambda");
+    return cppast::CppVisitAction::CONTINUE;
+  }
+
+  cppast::CppVisitAction preVisit(const cppast::CppNameExpr& expr)
+  {
+    trail.push_back(expr.value());
+    return cppast::CppVisitAction::CONTINUE;
+  }
+
+  cppast::CppVisitAction preVisit(const cppast::CppNumberLiteralExpr& expr)
+  {
+    trail.push_back(expr.value());
+    return numberAction;
+  }
+
+  cppast::CppVisitAction preVisit(const cppast::CppIfBlock&)
+  {
+    trail.push_back("if");
+    return ifBlockAction;
+  }
+
+  bool postVisit(const cppast::CppIfBlock&)
+  {
+    trail.push_back("end if");
+    return true;
+  }
+
+  bool postVisit(const cppast::CppEntity&)
+  {
+    ++numEntities;
+    return true;
+  }
+
+public:
+  std::vector<std::string> trail;
+  size_t                   numEntities {0};
+  cppast::CppVisitAction   ifBlockAction {cppast::CppVisitAction::CONTINUE};
+  cppast::CppVisitAction   numberAction {cppast::CppVisitAction::CONTINUE};
+};
+
+} // namespace
+
+TEST_CASE("Recursive visitor reaches every entity in order of source")
+{
+  const auto    fileAst = MakeFileAst();
+  TrailRecorder recorder;
+  CHECK(recorder.traverse(*fileAst));
+
+  const std::vector<std::string> expectedTrail = {
+    "function f", "var x", "if", "x", "g", "x", "1", "0", "end if", "var l", "lambda", "var y", "y"};
+  CHECK(recorder.trail == expectedTrail);
+  // Every entity except the if block, whose postVisit() is the more specific one.
+  CHECK(recorder.numEntities == 21);
+}
+
+TEST_CASE("Recursive visitor prunes children of an entity")
+{
+  const auto    fileAst = MakeFileAst();
+  TrailRecorder recorder;
+  recorder.ifBlockAction = cppast::CppVisitAction::SKIP_CHILDREN;
+  CHECK(recorder.traverse(*fileAst));
+
+  const std::vector<std::string> expectedTrail = {
+    "function f", "var x", "if", "end if", "var l", "lambda", "var y", "y"};
+  CHECK(recorder.trail == expectedTrail);
+}
+
+TEST_CASE("Recursive visitor stops when a hook asks to")
+{
+  const auto    fileAst = MakeFileAst();
+  TrailRecorder recorder;
+  recorder.numberAction = cppast::CppVisitAction::STOP;
+  CHECK_FALSE(recorder.traverse(*fileAst));
+
+  const std::vector<std::string> expectedTrail = {"function f", "var x", "if", "x", "g", "x", "1"};
+  CHECK(recorder.trail == expectedTrail);
+}
@@ -0,0 +1,73 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+TEST_CASE("Small vector keeps a few elements inline")
+{
+  cppast::helper::CppSmallVector<std::string, 2> names;
+  CHECK(names.empty());
+  CHECK(names.isInline());
+  CHECK(names.capacity() == 2);
+
+  names.push_back("Base1");
+  names.emplace_back("Base2");
+  CHECK(names.isInline());
+  CHECK(names.size() == 2);
+  CHECK(names.front() == "Base1");
+  CHECK(names.back() == "Base2");
+
+  // Growing beyond inline capacity moves elements to heap, even when the new element is one of them.
+  names.push_back(names.front());
+  CHECK_FALSE(names.isInline());
+  CHECK(std::vector<std::string>(names.begin(), names.end()) == std::vector<std::string> {"Base1", "Base2", "Base1"});
+  CHECK(std::vector<std::string>(names.rbegin(), names.rend())
+        == std::vector<std::string> {"Base1", "Base2", "Base1"});
+
+  names.pop_back();
+  CHECK(names.size() == 2);
+  CHECK(names[1] == "Base2");
+
+  const auto copied = names;
+  CHECK(copied == names);
+  CHECK(copied.data() != names.data());
+
+  names.clear();
+  CHECK(names.empty());
+  CHECK(copied != names);
+}
+
+TEST_CASE("Small vector moves its elements or its heap storage")
+{
+  cppast::helper::CppSmallVector<std::unique_ptr<int>, 1> inlineItems;
+  inlineItems.push_back(std::make_unique<int>(1));
+  auto* const inlineItem = inlineItems.front().get();
+
+  auto movedInlineItems = std::move(inlineItems);
+  CHECK(movedInlineItems.isInline());
+  CHECK(movedInlineItems.front().get() == inlineItem);
+  CHECK(inlineItems.empty());
+
+  cppast::helper::CppSmallVector<std::unique_ptr<int>, 1> heapItems;
+  for (int i = 0; i < 100; ++i)
+    heapItems.push_back(std::make_unique<int>(i));
+  const auto* const heapData = heapItems.data();
+
+  movedInlineItems = std::move(heapItems);
+  CHECK(movedInlineItems.data() == heapData);
+  CHECK(movedInlineItems.size() == 100);
+  CHECK(*movedInlineItems.back() == 99);
+  CHECK(heapItems.empty());
+  CHECK(heapItems.isInline());
+
+  // Without inline capacity it is just a pointer and two sizes.
+  cppast::helper::CppSmallVector<std::unique_ptr<int>, 0> noInlineItems;
+  CHECK(sizeof(noInlineItems) == sizeof(void*) + 8);
+  CHECK(noInlineItems.capacity() == 0);
+  noInlineItems.push_back(std::make_unique<int>(1));
+  CHECK_FALSE(noInlineItems.isInline());
+  CHECK(*noInlineItems.front() == 1);
+}
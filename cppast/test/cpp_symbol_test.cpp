@@ -0,0 +1,143 @@
+#include <catch/catch.hpp>
+
+#include "cppast/cppast.h"
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST_CASE("Same string is interned only once")
+{
+  cppast::CppSymbolTable symbolTable;
+
+  const auto symbol1 = symbolTable.intern("std::string");
+  const auto symbol2 = symbolTable.intern(std::string("std::") + "string");
+  const auto symbol3 = symbolTable.intern("size_t");
+
+  CHECK(symbol1 == symbol2);
+  CHECK(&symbol1.str() == &symbol2.str());
+  CHECK(symbol1.hash() == symbol2.hash());
+  CHECK(symbol1 != symbol3);
+  CHECK(symbol1.str() == "std::string");
+  CHECK(symbolTable.intern("").empty());
+  CHECK(symbolTable.intern("") == cppast::CppSymbol());
+
+  const auto stats = symbolTable.stats();
+  CHECK(stats.numSymbols == 2);
+  CHECK(stats.numInterned == 3);
+  CHECK(stats.bytesOfSymbols == 17);
+  CHECK(stats.bytesInterned == 28);
+}
+
+TEST_CASE("Symbols of different tables are compared by their strings")
+{
+  cppast::CppSymbolTable symbolTable1;
+  cppast::CppSymbolTable symbolTable2;
+
+  CHECK(symbolTable1.intern("wxString") == symbolTable2.intern("wxString"));
+  CHECK(symbolTable1.intern("wxString") != symbolTable2.intern("AcDbObjectId"));
+  CHECK(std::hash<cppast::CppSymbol>()(symbolTable1.intern("wxString"))
+        == std::hash<cppast::CppSymbol>()(symbolTable2.intern("wxString")));
+}
+
+TEST_CASE("Names of entities are interned in the current symbol table")
+{
+  cppast::CppSymbolTable symbolTable;
+  {
+    cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+
+    auto                    voidType = std::make_unique<cppast::CppVarType>("void", cppast::CppTypeModifier());
+    cppast::CppCompound     compound("Point", cppast::CppCompoundType::STRUCT);
+    cppast::CppVarType      varType("Point", cppast::CppTypeModifier());
+    cppast::CppNameExpr     nameExpr("Point");
+    cppast::CppVarDecl      varDecl("Point");
+    cppast::CppVarType      copiedVarType(varType);
+    cppast::CppFunction     func("Point", std::move(voidType), {}, 0);
+    const cppast::CppSymbol symbol("Point");
+
+    CHECK(compound.nameSymbol() == symbol);
+    CHECK(varType.baseTypeSymbol() == symbol);
+    CHECK(copiedVarType.baseTypeSymbol() == symbol);
+    CHECK(nameExpr.valueSymbol() == symbol);
+    CHECK(varDecl.nameSymbol() == symbol);
+    CHECK(func.nameSymbol() == symbol);
+    CHECK(&compound.name() == &nameExpr.value());
+    CHECK(cppast::CppSymbolTable::current() == &symbolTable);
+  }
+  CHECK(cppast::CppSymbolTable::current() == nullptr);
+
+  const auto stats = symbolTable.stats();
+  CHECK(stats.numSymbols == 2);
+  CHECK(stats.numInterned == 7);
+
+  // Without a current table a symbol owns its string.
+  const cppast::CppSymbol ownSymbol("Point");
+  CHECK(&ownSymbol.str() != &symbolTable.intern("Point").str());
+  CHECK(ownSymbol == symbolTable.intern("Point"));
+}
+
+TEST_CASE("Names created without a current table are owned by the entities")
+{
+  std::unique_ptr<cppast::CppSymbol> copiedSymbol;
+  {
+    const cppast::CppSymbol symbol("NameOfNoTable");
+    const cppast::CppSymbol otherSymbol("NameOfNoTable");
+    CHECK(symbol == otherSymbol);
+    CHECK(symbol != cppast::CppSymbol("OtherNameOfNoTable"));
+
+    copiedSymbol = std::make_unique<cppast::CppSymbol>(symbol);
+    CHECK(&copiedSymbol->str() == &symbol.str());
+  }
+  CHECK(copiedSymbol->str() == "NameOfNoTable");
+
+  std::unique_ptr<cppast::CppVarType> copiedType;
+  {
+    cppast::CppVarType varType("NameOfNoTable", cppast::CppTypeModifier());
+    varType.typeModifier().ptrLevel_ = 1;
+    copiedType                       = std::make_unique<cppast::CppVarType>(varType);
+    CHECK(*copiedType == varType);
+  }
+  CHECK(copiedType->baseType() == "NameOfNoTable");
+  CHECK(copiedType->typeModifier().ptrLevel_ == 1);
+
+  cppast::CppSymbolTable symbolTable;
+  {
+    cppast::CppSymbolTable::Scope symbolTableScope(symbolTable);
+    cppast::CppVarType            varType(*copiedType);
+    CHECK(varType.baseTypeSymbol() == symbolTable.intern("NameOfNoTable"));
+    CHECK(&varType.baseType() == &symbolTable.intern("NameOfNoTable").str());
+  }
+  CHECK(symbolTable.stats().numSymbols == 1);
+}
+
+TEST_CASE("Symbols are interned from many threads at the same time")
+{
+  constexpr int kNumThreads   = 4;
+  constexpr int kNumNames     = 100;
+  constexpr int kNumRepeats   = 50;
+  constexpr int kNumPerThread = kNumNames * kNumRepeats;
+
+  cppast::CppSymbolTable                      symbolTable;
+  std::vector<std::vector<cppast::CppSymbol>> symbols(kNumThreads);
+  std::vector<std::thread>                    threads;
+  for (int t = 0; t < kNumThreads; ++t)
+  {
+    threads.emplace_back([&symbolTable, &threadSymbols = symbols[t]]() {
+      for (int i = 0; i < kNumPerThread; ++i)
+        threadSymbols.push_back(symbolTable.intern("name" + std::to_string(i % kNumNames)));
+    });
+  }
+  for (auto& thread : threads)
+    thread.join();
+
+  for (int t = 1; t < kNumThreads; ++t)
+  {
+    for (int i = 0; i < kNumPerThread; ++i)
+      REQUIRE(&symbols[t][i].str() == &symbols[0][i].str());
+  }
+
+  const auto stats = symbolTable.stats();
+  CHECK(stats.numSymbols == kNumNames);
+  CHECK(stats.numInterned == kNumThreads * kNumPerThread);
+}
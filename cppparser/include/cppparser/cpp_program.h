@@ -7,11 +7,16 @@
 #include "cppparser/cpp_type_tree.h"
 #include "cppparser/cppparser.h"
 
+#include <array>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <map>
 #include <memory>
 #include <set>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
 namespace cppparser {
@@ -22,7 +27,14 @@ namespace cppparser {
 class CppProgram
 {
 public:
-  CppProgram(const std::vector<std::string>& files);
+  /**
+   * Parses all @a files using @a parser and builds the type tree of the whole program.
+   * @param numThreads Number of threads to parse files and to build the type tree with, 0 means as many as the
+   * hardware supports.
+   */
+  CppProgram(const std::vector<std::string>& files,
+             const CppParser&                parser     = CppParser(),
+             unsigned                        numThreads = 0);
 
 public:
   /**
@@ -30,6 +42,32 @@ public:
    * @warning It is a no-op if @a cppAst is not of CppCompoundType::FILE type.
    */
   void addCppFile(std::unique_ptr<cppast::CppCompound> cppAst);
+  /**
+   * Adds the given file ASTs to this program in the given order.
+   * @param numThreads Number of threads to use, 0 means as many as the hardware supports.
+   * @remarks Type nodes of each file are collected on a pool of threads. Then every thread of the pool merges, in the
+   * order of files, the nodes below a different set of top level nodes. So, the type tree is exactly the same as the
+   * one built by calling addCppFile() for each file. It is faster than that even on one thread because new nodes are
+   * indexed in one batch.
+   * @note Null ASTs and ASTs that are not of CppCompoundType::FILE type are skipped.
+   */
+  void addCppFiles(std::vector<std::unique_ptr<cppast::CppCompound>> cppAsts, unsigned numThreads = 0);
+  /**
+   * Parses @a sourceFiles and all the files they include, directly or indirectly, and adds them to this program.
+   * @param includeDirs Directories in which included files are searched. A file included using double quotes is
+   * first searched in the directory of the file that includes it.
+   * @param numThreads Number of threads to use, 0 means as many as the hardware supports.
+   * @remarks Every distinct file is parsed only once however many files include it, and all of them share its AST.
+   * A file is scheduled as soon as a parsed file is found to include it, so, independent headers are parsed in
+   * parallel. Files already in this program are not parsed again.
+   * Files are added to the type tree in breadth first order of the include graph starting from @a sourceFiles, so,
+   * the result does not depend on the order in which threads finish.
+   * @note Files are identified by their canonical paths, and included files that cannot be found are ignored.
+   */
+  void addSourceFiles(const std::vector<std::string>& sourceFiles,
+                      const std::vector<std::string>& includeDirs,
+                      const CppParser&                parser     = CppParser(),
+                      unsigned                        numThreads = 0);
   void addCompound(const cppast::CppCompound& compound, const cppast::CppCompound& parent);
   void addCompound(const cppast::CppCompound& compound, CppTypeTreeNode& parentTypeNode);
 
@@ -44,8 +82,9 @@ public:
    *    1. The search moves upward. E.g. if @a beginFrom does not contain the type whose name is @a name then
    * it is searched in parent node and keeps moving upward till a match is found or type-hierarchy ends without a match.
    *    2. It is supposed to work exactly like how compiler looks for name.
+   *    3. It does not allocate, segments of a qualified name are looked up as views into @a name.
    */
-  const CppTypeTreeNode* nameLookup(const std::string& name, const CppTypeTreeNode* beginFrom = nullptr) const;
+  const CppTypeTreeNode* nameLookup(std::string_view name, const CppTypeTreeNode* beginFrom = nullptr) const;
   /**
    * Searches down (in breadth first manner) the CppTypeTreeNode object corresponding to a given name.
    * @param name Name of type for which CppTypeTreeNode needs to be found.
@@ -56,8 +95,22 @@ public:
    * @remarks The search moves downward. E.g. if @a parentNode does not contain the type whose name is @a name then
    * it is searched in child nodes and keeps going downwards till a match is found or type-hierarchy ends without a
    * match.
+   * It is answered from an index of all names, so, it does not walk the type tree.
    */
-  const CppTypeTreeNode* searchTypeNode(const std::string& name, const CppTypeTreeNode* parentNode = nullptr) const;
+  const CppTypeTreeNode* searchTypeNode(std::string_view name, const CppTypeTreeNode* parentNode = nullptr) const;
+  /**
+   * Same as searchTypeNode() but returns all the nodes of given name under @a parentNode.
+   * @return Nodes in breadth first order, children of a node are visited in order of their names.
+   * So, the order does not depend on the order in which files were added to the program.
+   */
+  std::vector<const CppTypeTreeNode*> searchTypeNodes(std::string_view       name,
+                                                      const CppTypeTreeNode* parentNode = nullptr) const;
+  /**
+   * @return true if @a cppEntity belongs to @a scope or to any of its descendants.
+   * @remarks It is a hash lookup of the node of @a cppEntity and then a climb of at most as many levels as the
+   * nesting of that node, see CppTypeTreeNode::encloses(). Adding files to the program does not make it any slower.
+   */
+  bool has(const CppTypeTreeNode& scope, const cppast::CppEntity* cppEntity) const;
   /**
    * @return CppTypeTreeNode for cppast::CppEntity.
    * @note Return value may be nullptr if cppast::CppEntity does not represent a valid type.
@@ -67,16 +120,94 @@ public:
    * @return An array of cppast::CppCompound each element of which represents AST of a C++ file.
    */
   const std::vector<std::unique_ptr<cppast::CppCompound>>& getFileAsts() const;
+  /**
+   * @return AST of the file of given name, nullptr if this program does not have it.
+   */
+  const cppast::CppCompound* fileAst(const std::string& filename) const;
+  /**
+   * @return Canonical paths of files that @a filename directly includes, in the order in which they are included.
+   * @note Include graph is known only for files added using addSourceFiles().
+   */
+  const std::vector<std::string>& includedFiles(const std::string& filename) const;
+  /**
+   * @return Table in which names of all files parsed by this program are interned, nullptr if none is parsed yet.
+   * @remarks It is the table of the parser first used by this program, or a table of its own if that parser has
+   * none. Files parsed later with another parser too are interned in it, and it is released with the program.
+   */
+  const std::shared_ptr<cppast::CppSymbolTable>& symbolTable() const
+  {
+    return symbolTable_;
+  }
 
 private:
+  struct TypeNodeRecord;
+  using TypeNodeRecords = std::vector<TypeNodeRecord>;
+  struct TypeNodeShard;
+
   void loadType(const cppast::CppCompound& cppCompound, CppTypeTreeNode& typeNode);
+  /**
+   * Collects, without touching the type tree, the type nodes that loadType() would add for @a cppCompound.
+   * @note It can be called on many threads at the same time.
+   */
+  static void collectTypeNodes(const cppast::CppCompound& cppCompound, size_t parentIdx, TypeNodeRecords& records);
+  /**
+   * Adds collected type nodes under @a typeNode in the same order in which loadType() would have added them.
+   */
+  void mergeTypeNodes(const cppast::CppCompound& cppCompound,
+                      const TypeNodeRecords&     records,
+                      CppTypeTreeNode&           typeNode);
+  /**
+   * Adds collected type nodes of all @a cppAsts under the root using @a numThreads threads.
+   * Nodes are the same, and children of every node are added in the same order, as when files are merged one by one.
+   */
+  void mergeTypeNodes(const std::vector<std::unique_ptr<cppast::CppCompound>>& cppAsts,
+                      const std::vector<TypeNodeRecords>&                      fileRecords,
+                      unsigned                                                 numThreads);
+  /**
+   * Adds @a cppEntity to the child node of @a parentTypeNode named @a name, the node is created if needed.
+   * @note @a name must be owned by @a cppEntity so that the node can keep viewing it.
+   */
+  CppTypeTreeNode& addTypeNode(const cppast::CppEntity& cppEntity,
+                               const std::string&       name,
+                               CppTypeTreeNode&         parentTypeNode);
+  /**
+   * Adds @a typeNode to the nodes of its name.
+   */
+  void indexTypeNodeName(const CppTypeTreeNode* typeNode);
+  /**
+   * @return Copy of @a parser that interns names in the symbol table of this program.
+   */
+  CppParser sessionParser(const CppParser& parser);
 
 private:
-  using CppEntityToTypeNodeMap = std::map<const cppast::CppEntity*, CppTypeTreeNode*>;
+  using CppEntityToTypeNodeMap = std::unordered_map<const cppast::CppEntity*, CppTypeTreeNode*>;
+  /**
+   * Nodes of every name in breadth first order, it is kept up to date as nodes are added.
+   */
+  using CppNameToTypeNodesMap = std::unordered_map<std::string_view, std::vector<const CppTypeTreeNode*>>;
+
+  /**
+   * Indexes are split by hash of their keys, so that nodes merged in parallel are indexed in parallel too.
+   */
+  static constexpr unsigned kIndexShardBits = 4;
+  static constexpr size_t   kNumIndexShards = size_t(1) << kIndexShardBits;
+
+  static size_t indexShardOf(const cppast::CppEntity* cppEntity);
+  static size_t indexShardOf(std::string_view name);
 
   std::vector<std::unique_ptr<cppast::CppCompound>> fileAsts_; ///< Array of all top level ASTs corresponding to files.
-  CppTypeTreeNode        cppTypeTreeRoot_; ///< Repository of all compound objects arranged as type-tree.
-  CppEntityToTypeNodeMap cppEntityToTypeNode_;
+  CppTypeTreeNode cppTypeTreeRoot_; ///< Repository of all compound objects arranged as type-tree.
+  /**
+   * Storage of all nodes except the root, in chunks so that each thread merging in parallel fills its own.
+   * Neither a chunk nor the deque of chunks ever moves a node.
+   */
+  std::deque<std::deque<CppTypeTreeNode>>             typeNodes_;
+  std::array<CppEntityToTypeNodeMap, kNumIndexShards> cppEntityToTypeNode_;
+  std::array<CppNameToTypeNodesMap, kNumIndexShards>  nameToTypeNodes_;
+
+  std::unordered_map<std::string, const cppast::CppCompound*> fileNameToAst_;
+  std::unordered_map<std::string, std::vector<std::string>>   includeGraph_;
+  std::shared_ptr<cppast::CppSymbolTable>                     symbolTable_;
 };
 
 inline const std::vector<std::unique_ptr<cppast::CppCompound>>& CppProgram::getFileAsts() const
@@ -84,10 +215,23 @@ inline const std::vector<std::unique_ptr<cppast::CppCompound>>& CppProgram::getF
   return fileAsts_;
 }
 
+inline size_t CppProgram::indexShardOf(const cppast::CppEntity* cppEntity)
+{
+  // Low bits of aligned addresses are all same, multiplying by 2^64 / golden ratio spreads them into the high bits.
+  const auto address = static_cast<std::uint64_t>(reinterpret_cast<std::uintptr_t>(cppEntity));
+  return static_cast<size_t>((address * 0x9E3779B97F4A7C15ULL) >> (64 - kIndexShardBits));
+}
+
+inline size_t CppProgram::indexShardOf(std::string_view name)
+{
+  return std::hash<std::string_view>()(name) % kNumIndexShards;
+}
+
 inline const CppTypeTreeNode* CppProgram::typeTreeNodeFromCppEntity(const cppast::CppEntity* cppEntity) const
 {
-  CppEntityToTypeNodeMap::const_iterator itr = cppEntityToTypeNode_.find(cppEntity);
-  return itr == cppEntityToTypeNode_.end() ? nullptr : itr->second;
+  const auto&                            index = cppEntityToTypeNode_[indexShardOf(cppEntity)];
+  CppEntityToTypeNodeMap::const_iterator itr   = index.find(cppEntity);
+  return itr == index.end() ? nullptr : itr->second;
 }
 
 } // namespace cppparser
@@ -6,9 +6,10 @@
 
 #include "cppast/cpp_entity.h"
 
-#include <map>
-#include <set>
-#include <string>
+#include <algorithm>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
 
 namespace cppparser {
 
@@ -20,9 +21,12 @@ struct CppTypeTreeNode;
  * The root of the tree is the global namespace which contains other compound objects like namespace, class, struct,
  * etc. And each of those compound object can form another branch of tree.
  *
+ * Children are hashed by name so that finding one neither compares strings one by one nor allocates.
+ * A name is a view into the name of the first entity that introduced it, so, it is not copied.
+ *
  * @note This tree has no relation with inheritance hierarchy.
  */
-using CppTypeTree = std::map<std::string, CppTypeTreeNode>;
+using CppTypeTree = std::unordered_map<std::string_view, CppTypeTreeNode*>;
 
 struct CppEntityCmp
 {
@@ -36,7 +40,52 @@ struct CppEntityCmp
   }
 };
 
-using CppEntitySet = std::set<const cppast::CppEntity*, CppEntityCmp>;
+/**
+ * @brief Set of entities ordered by CppEntityCmp.
+ *
+ * Almost every set has one or two entities, so, a sorted vector is both smaller and faster than a tree.
+ */
+class CppEntitySet
+{
+public:
+  using const_iterator = std::vector<const cppast::CppEntity*>::const_iterator;
+
+public:
+  bool insert(const cppast::CppEntity* cppEntity)
+  {
+    const auto itr = std::lower_bound(entities_.begin(), entities_.end(), cppEntity, CppEntityCmp());
+    if ((itr != entities_.end()) && (*itr == cppEntity))
+      return false;
+    entities_.insert(itr, cppEntity);
+    return true;
+  }
+
+  size_t count(const cppast::CppEntity* cppEntity) const
+  {
+    return std::binary_search(entities_.begin(), entities_.end(), cppEntity, CppEntityCmp()) ? 1 : 0;
+  }
+
+  size_t size() const
+  {
+    return entities_.size();
+  }
+  bool empty() const
+  {
+    return entities_.empty();
+  }
+
+  const_iterator begin() const
+  {
+    return entities_.begin();
+  }
+  const_iterator end() const
+  {
+    return entities_.end();
+  }
+
+private:
+  std::vector<const cppast::CppEntity*> entities_;
+};
 
 /**
  * @brief A node in a CppTypeTree.
@@ -53,19 +102,51 @@ struct CppTypeTreeNode
   CppEntitySet     cppEntitySet;
   CppTypeTree      children;
   CppTypeTreeNode* parent;
+  std::string_view name;  ///< Same as the key of this node among children of its parent, empty for the root.
+  size_t           depth; ///< Distance from the root.
 
   CppTypeTreeNode()
     : parent(nullptr)
+    , depth(0)
+  {
+  }
+
+  /**
+   * @return Child node of the given name, nullptr if there is none.
+   */
+  const CppTypeTreeNode* child(std::string_view name) const
   {
+    const auto itr = children.find(name);
+    return (itr == children.end()) ? nullptr : itr->second;
   }
 
+  /**
+   * @return true if @a node is this node or one of its descendants.
+   * @remarks It climbs from @a node only as many levels as it is deeper than this node, so, it costs as much as
+   * nesting of namespaces and classes, however large the tree is, and it needs no bookkeeping when the tree grows.
+   */
+  bool encloses(const CppTypeTreeNode& node) const
+  {
+    if (node.depth < depth)
+      return false;
+    const auto* ancestor = &node;
+    while (ancestor->depth > depth)
+      ancestor = ancestor->parent;
+    return ancestor == this;
+  }
+
+  /**
+   * @return true if @a cppEntity belongs to this node or to any of its descendants.
+   * @warning It walks the whole subtree because a node cannot find the node of an entity.
+   * CppProgram::has() finds it through its index and then only climbs, use that one in hot paths.
+   */
   bool has(const cppast::CppEntity* cppEntity) const
   {
     if (cppEntitySet.count(cppEntity))
       return true;
-    for (const auto child : children)
+    for (const auto& child : children)
     {
-      if (child.second.has(cppEntity))
+      if (child.second->has(cppEntity))
         return true;
     }
     return false;
@@ -6,16 +6,23 @@
 
 #include <cppast/cppast.h>
 
+#include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
+#include <vector>
 
 namespace cppparser {
 
+struct ParserOptions;
+class AstCache;
+
 /**
  * @brief Parses C++ source and generates an AST.
  *
- * @warning Although its a class it is not reentrant because underlying btyacc is not reentrant.
- * So, any change done through this class is global and affects the result of other instances too.
+ * Each instance owns its configuration and the parser keeps its state per thread.
+ * So, different instances can parse different files on different threads at the same time.
+ * @warning A single instance must not be reconfigured while it is being used for parsing.
  */
 class CppParser
 {
@@ -23,6 +30,15 @@ public:
   using ErrorHandler =
     std::function<void(const char* errLineText, size_t lineNum, size_t errorStartPos, int lexerContext)>;
 
+public:
+  CppParser();
+  CppParser(const CppParser& other);
+  CppParser(CppParser&& other) noexcept;
+  ~CppParser();
+
+  CppParser& operator=(const CppParser& other);
+  CppParser& operator=(CppParser&& other) noexcept;
+
 public:
   void addKnownMacro(std::string knownMacro);
   void addKnownMacros(const std::vector<std::string>& knownMacros);
@@ -42,20 +58,104 @@ public:
 
   void parseEnumBodyAsBlob();
   void parseFunctionBodyAsBlob(bool asBlob);
+  /**
+   * @brief Records only the text of function, constructor, and lambda bodies while parsing.
+   *
+   * A body is parsed when its definition is accessed for the first time, see cppast::CppLazyCompound.
+   * So, tools that mostly look at signatures do not pay for parsing the bodies.
+   * Bodies of an AST returned by parseStream() refer to the stream when shareSourceBuffer() is set.
+   * @note parseFunctionBodyAsBlob() takes precedence over it.
+   * @warning A definition must not be accessed for the first time while a stream is being parsed on the same thread,
+   * e.g. from an error handler, that throws std::logic_error.
+   */
+  void parseFunctionBodyLazily(bool lazily);
+  /**
+   * @brief Allocates all entities of a parsed file from an arena that is owned by the returned file level compound.
+   *
+   * It saves lots of small allocations while parsing and the whole memory is released at once with the AST.
+   * Entities of a body that is parsed lazily are likewise allocated from an arena owned by its block.
+   * @warning An entity of such an AST must not be moved out to outlive the compound that owns the arena.
+   */
+  void allocateEntitiesFromArena(bool fromArena);
+  /**
+   * @brief Makes texts of blobs, documentation comments, and macro definitions views into the source buffer.
+   *
+   * It avoids copying most of the file when function bodies are parsed as blob.
+   * parseFile() makes the returned AST keep the source buffer alive, and shared texts keep line endings of the file.
+   * @warning With parseStream() the caller must keep the stream alive as long as the AST is used.
+   * @warning parseFile() maps the file where supported. So, a file must not be truncated while its AST is alive,
+   * reading the AST can then crash with SIGBUS.
+   */
+  void shareSourceBuffer(bool share);
+  /**
+   * @brief Interns names of entities of all files parsed by this parser, and by its copies, in @a symbolTable.
+   *
+   * Each distinct name is then stored only once however many files have it, and names of different files can be
+   * compared by comparing their symbols. Every parsed AST keeps the table alive.
+   * @note By default there is no such table, names of each file are interned in a table that only its AST keeps
+   * alive, and so, they are released with the AST.
+   * @note Nothing is ever removed from a table, so, a shared one keeps growing with names of every file that is
+   * parsed with it, even after ASTs of those files are destroyed. A long running program can give the parser a new
+   * table, e.g. for each batch of files, so that the old one is released with the last AST that uses it.
+   * @warning An entity of such an AST must not be moved out to outlive the file level compound.
+   */
+  void symbolTable(std::shared_ptr<cppast::CppSymbolTable> symbolTableArg);
+  const std::shared_ptr<cppast::CppSymbolTable>& symbolTable() const;
+  /**
+   * @brief Makes parseFile() and parseFiles() keep ASTs of parsed files in the given directory.
+   *
+   * A file whose content is unchanged since it was last parsed with the same configuration
+   * is then loaded from the directory instead of being parsed again, even by another process.
+   * Least recently used ASTs are removed when the directory grows beyond @a maxCacheSize bytes.
+   * @param cacheDir Directory of cached ASTs, empty string disables caching.
+   * @note Caching is bypassed when function bodies are parsed lazily because cached ASTs have all bodies parsed.
+   */
+  void cacheParsedFiles(std::string cacheDir, std::uint64_t maxCacheSize = std::uint64_t(1) << 30);
 
 public:
-  std::unique_ptr<cppast::CppCompound> parseFile(const std::string& filename);
+  /**
+   * @brief Parses the given file and returns the AST, nullptr if the file cannot be read or parsed.
+   * @note The file is memory mapped where supported, so, it is not read into a separate buffer before parsing.
+   */
+  std::unique_ptr<cppast::CppCompound> parseFile(const std::string& filename) const;
+  /**
+   * @brief Parses all the given files using a pool of threads.
+   * @param filenames Files to parse.
+   * @param numThreads Number of threads to use, 0 means as many as the hardware supports.
+   * @return ASTs in the same order as @a filenames, an element is nullptr if parsing of corresponding file failed.
+   * @note Bigger files are parsed first and idle threads keep picking the next biggest file that is not yet taken.
+   * So, a big file does not end up being parsed alone at the end while other threads sit idle.
+   */
+  std::vector<std::unique_ptr<cppast::CppCompound>> parseFiles(const std::vector<std::string>& filenames,
+                                                               unsigned                        numThreads = 0) const;
   /**
    * @brief Parses the given stream and returns the AST.
    * @param stm The stream to parse.
    * @param stmSize The size of the stream.
    * @return The AST.
+   * @note The stream is scanned in place without being copied, the scanner writes into it while scanning.
    * @warning The stream \a stm must terminate with double null characters, i.e. the last 2 bytes must be '\0'.
    */
-  std::unique_ptr<cppast::CppCompound> parseStream(char* stm, size_t stmSize);
+  std::unique_ptr<cppast::CppCompound> parseStream(char* stm, size_t stmSize) const;
+  /**
+   * @brief Parses the given read only stream and returns the AST.
+   * @param stm The stream to parse, it need not be null terminated.
+   * @param stmSize The size of the stream.
+   * @return The AST.
+   * @note The whole stream is copied because scanning needs a writable buffer, it costs an allocation and a copy
+   * of the size of the stream for every call. A caller that has a writable stream that ends with double null
+   * characters can avoid that by calling parseStream(char*, size_t) instead.
+   * Texts shared with shareSourceBuffer() are views into \a stm, not into the copy, and so the caller must keep it
+   * alive.
+   */
+  std::unique_ptr<cppast::CppCompound> parseStream(const char* stm, size_t stmSize) const;
 
   void setErrorHandler(ErrorHandler errorHandler);
   void resetErrorHandler();
+
+private:
+  std::unique_ptr<ParserOptions> options_;
+  std::shared_ptr<AstCache>      astCache_;
 };
 
 } // namespace cppparser
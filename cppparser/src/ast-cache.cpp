@@ -0,0 +1,260 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "ast-cache.h"
+#include "cppast/cpp_binary_ast.h"
+#include "cppast/cppast.h"
+#include "parser-options.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <process.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace cppparser {
+
+static constexpr char kEntryExtension[] = ".ast";
+
+/**
+ * @return Suffix of a temporary file that no other thread or process, that shares the cache directory, uses.
+ * @note Process id alone is not enough, processes in different containers can have the same id.
+ */
+static std::string UniqueTmpSuffix()
+{
+#if defined(_WIN32)
+  static const auto processId = _getpid();
+#else
+  static const auto processId = getpid();
+#endif
+  static const auto                 processNonce = std::random_device()();
+  static std::atomic<std::uint64_t> numTmpFiles {0};
+
+  return "." + std::to_string(processId) + "." + std::to_string(processNonce) + "." + std::to_string(numTmpFiles++)
+         + ".tmp";
+}
+
+/**
+ * @brief 64 bit variant of MurmurHash2 by Austin Appleby.
+ *
+ * It is not cryptographic, but, 2 of them with different seeds make collisions of cache keys practically impossible.
+ */
+static std::uint64_t MurmurHash64(std::string_view data, std::uint64_t seed)
+{
+  constexpr std::uint64_t m = 0xc6a4a7935bd1e995ULL;
+  constexpr int           r = 47;
+
+  std::uint64_t h = seed ^ (data.size() * m);
+
+  const auto* p   = data.data();
+  const auto* end = p + (data.size() / 8) * 8;
+  for (; p != end; p += 8)
+  {
+    std::uint64_t k;
+    std::memcpy(&k, p, sizeof(k));
+
+    k *= m;
+    k ^= k >> r;
+    k *= m;
+
+    h ^= k;
+    h *= m;
+  }
+
+  const auto rest = data.size() & 7;
+  for (size_t i = rest; i > 0; --i)
+    h ^= static_cast<std::uint64_t>(static_cast<unsigned char>(p[i - 1])) << (8 * (i - 1));
+  if (rest != 0)
+    h *= m;
+
+  h ^= h >> r;
+  h *= m;
+  h ^= h >> r;
+
+  return h;
+}
+
+/**
+ * @return Text that is same for 2 configurations if and only if they produce same AST of any file.
+ */
+static std::string ConfigFingerprint(const ParserOptions& options)
+{
+  std::ostringstream fingerprint;
+  fingerprint << "version:" << cppast::kBinaryAstVersion << '\n';
+  fingerprint << "enum-blob:" << options.parseEnumBodyAsBlob << '\n';
+  fingerprint << "function-blob:" << options.parseFunctionBodyAsBlob << '\n';
+  for (const auto& definedName : options.definedNames)
+    fingerprint << "defined:" << definedName.first << '=' << definedName.second << '\n';
+  for (const auto& undefinedName : options.undefinedNames)
+    fingerprint << "undefined:" << undefinedName << '\n';
+
+  // Table order depends on the order in which identifiers were added.
+  std::vector<std::tuple<std::string_view, IdentifierKind, int>> identifiers;
+  options.identifiers.visitAll([&identifiers](std::string_view identifier, IdentifierClass idClass) {
+    identifiers.emplace_back(identifier, idClass.kind, idClass.keywordId);
+  });
+  std::sort(identifiers.begin(), identifiers.end());
+  for (const auto& identifier : identifiers)
+  {
+    fingerprint << "identifier:" << std::get<0>(identifier) << ':' << static_cast<int>(std::get<1>(identifier))
+                << ':' << std::get<2>(identifier) << '\n';
+  }
+
+  return fingerprint.str();
+}
+
+AstCache::AstCache(fs::path dir, std::uint64_t maxSize)
+  : dir_(std::move(dir))
+  , maxSize_(maxSize)
+{
+  std::error_code ec;
+  fs::create_directories(dir_, ec);
+  for (fs::directory_iterator itr(dir_, ec), end; !ec && (itr != end); itr.increment(ec))
+  {
+    if (itr->path().extension() == kEntryExtension)
+      size_ += itr->file_size(ec);
+  }
+}
+
+fs::path AstCache::entryPath(std::string_view source, const ParserOptions& options) const
+{
+  const auto fingerprint = ConfigFingerprint(options);
+  const auto hi          = MurmurHash64(source, MurmurHash64(fingerprint, 0x9e3779b97f4a7c15ULL));
+  const auto lo          = MurmurHash64(source, MurmurHash64(fingerprint, 0xc2b2ae3d27d4eb4fULL));
+
+  char name[33];
+  std::snprintf(name,
+                sizeof(name),
+                "%016llx%016llx",
+                static_cast<unsigned long long>(hi),
+                static_cast<unsigned long long>(lo));
+
+  return dir_ / (std::string(name) + kEntryExtension);
+}
+
+std::unique_ptr<cppast::CppCompound> AstCache::load(const fs::path& entry, const ParserOptions& options) const
+{
+  std::ifstream entryStm(entry, std::ios::binary);
+  if (!entryStm)
+    return nullptr;
+  const std::string data((std::istreambuf_iterator<char>(entryStm)), std::istreambuf_iterator<char>());
+  entryStm.close();
+
+  auto arena = options.allocateEntitiesFromArena ? std::make_unique<cppast::CppEntityArena>() : nullptr;
+  std::unique_ptr<cppast::CppCompound> ast;
+  {
+    std::optional<cppast::CppEntityArena::Scope> arenaScope;
+    if (arena)
+      arenaScope.emplace(*arena);
+    ast = cppast::ReadBinaryAst(data);
+  }
+  if (!ast)
+    return nullptr;
+
+  if (arena)
+  {
+    // File level compound owns the arena and so it cannot itself live in the arena.
+    auto fileAst = std::make_unique<cppast::CppCompound>(cppast::CppCompoundType::FILE);
+    fileAst->adoptEntitiesOf(*ast);
+    ast.reset();
+    fileAst->arena(std::move(arena));
+    ast = std::move(fileAst);
+  }
+
+  // Modification time is the time of last use and it decides what gets evicted first.
+  std::error_code ec;
+  fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+
+  return ast;
+}
+
+void AstCache::store(const fs::path& entry, const cppast::CppCompound& ast)
+{
+  std::string data;
+  try
+  {
+    data = cppast::WriteBinaryAst(ast);
+  }
+  catch (const std::invalid_argument&)
+  {
+    return;
+  }
+
+  // Entry is renamed into place only when it is completely written, so, a reader never sees a partial entry.
+  auto tmpPath = entry;
+  tmpPath += UniqueTmpSuffix();
+  {
+    std::ofstream entryStm(tmpPath, std::ios::binary | std::ios::trunc);
+    if (!entryStm || !entryStm.write(data.data(), static_cast<std::streamsize>(data.size())))
+      return;
+  }
+  std::error_code ec;
+  fs::rename(tmpPath, entry, ec);
+  if (ec)
+  {
+    fs::remove(tmpPath, ec);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  size_ += data.size();
+  if (size_ > maxSize_)
+    evict();
+}
+
+void AstCache::evict()
+{
+  struct Entry
+  {
+    fs::file_time_type lastUsed;
+    std::uint64_t      size;
+    fs::path           path;
+  };
+
+  std::vector<Entry> entries;
+  std::uint64_t      totalSize = 0;
+  std::error_code    ec;
+  for (fs::directory_iterator itr(dir_, ec), end; !ec && (itr != end); itr.increment(ec))
+  {
+    if (itr->path().extension() != kEntryExtension)
+      continue;
+    std::error_code entryEc;
+    const auto      lastUsed = itr->last_write_time(entryEc);
+    const auto      size     = itr->file_size(entryEc);
+    if (entryEc)
+      continue;
+    entries.push_back(Entry {lastUsed, size, itr->path()});
+    totalSize += size;
+  }
+
+  // Evicting a bit more than needed avoids scanning the directory again on the very next store.
+  const auto targetSize = maxSize_ / 10 * 9;
+  std::sort(
+    entries.begin(), entries.end(), [](const Entry& lhs, const Entry& rhs) { return lhs.lastUsed < rhs.lastUsed; });
+  for (const auto& entry : entries)
+  {
+    if (totalSize <= targetSize)
+      break;
+    if (fs::remove(entry.path, ec))
+      totalSize -= entry.size;
+  }
+
+  size_ = totalSize;
+}
+
+} // namespace cppparser
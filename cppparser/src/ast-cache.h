@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef E78E9FB7_98E2_4C72_BE51_EA35F121FA9A
+#define E78E9FB7_98E2_4C72_BE51_EA35F121FA9A
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace cppast {
+class CppCompound;
+}
+
+namespace cppparser {
+
+struct ParserOptions;
+
+/**
+ * @brief Directory of binary ASTs of parsed files, keyed by hash of file content and of parser configuration.
+ *
+ * An unchanged file parsed with same configuration is loaded from the cache instead of being parsed again.
+ * Files of cache are written atomically, so, many threads and processes can share one cache directory.
+ * When the cache grows beyond its limit, least recently used entries are removed.
+ * Failure to read or write the cache is never an error, the file is just parsed as if there were no cache.
+ */
+class AstCache
+{
+public:
+  AstCache(std::filesystem::path dir, std::uint64_t maxSize);
+
+public:
+  /**
+   * @return Path of the entry for AST of @a source parsed with @a options.
+   * @note Scanner modifies the source buffer, so, entry path must be known before the source is parsed.
+   */
+  std::filesystem::path entryPath(std::string_view source, const ParserOptions& options) const;
+
+  /**
+   * @return The cached AST, nullptr if the cache does not have it.
+   */
+  std::unique_ptr<cppast::CppCompound> load(const std::filesystem::path& entry, const ParserOptions& options) const;
+
+  void store(const std::filesystem::path& entry, const cppast::CppCompound& ast);
+
+private:
+  void evict();
+
+private:
+  const std::filesystem::path dir_;
+  const std::uint64_t         maxSize_;
+
+  std::mutex    mutex_;
+  std::uint64_t size_ {0}; // Estimated size of all entries, it is corrected whenever entries are evicted.
+};
+
+} // namespace cppparser
+
+#endif /* E78E9FB7_98E2_4C72_BE51_EA35F121FA9A */
@@ -6,160 +6,677 @@
 
 #include "utils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <functional>
 #include <iostream>
+#include <mutex>
+#include <thread>
+
+namespace fs = std::filesystem;
 
 namespace cppparser {
 
-CppProgram::CppProgram(const std::vector<std::string>& files)
+/**
+ * Type node that loadType() would add for an entity, @a parentIdx is the index of record of its parent node.
+ * Records are in pre-order, so, records of descendants of a node are the ones right after its own record till
+ * @a subtreeEnd.
+ */
+struct CppProgram::TypeNodeRecord
 {
-  cppEntityToTypeNode_[nullptr] = &cppTypeTreeRoot_;
+  static constexpr size_t kTopLevel = ~size_t(0);
 
-  CppParser parser;
-  for (const auto& f : files)
+  const cppast::CppEntity* cppEntity;
+  const std::string*       name;
+  size_t                   parentIdx;
+  size_t                   subtreeEnd;
+};
+
+/**
+ * Records that are merged by one thread, and what merging them adds to the indexes.
+ */
+struct CppProgram::TypeNodeShard
+{
+  /**
+   * Records of descendants of a top level record.
+   */
+  struct RecordRange
+  {
+    size_t fileIdx;
+    size_t beginIdx;
+    size_t endIdx;
+  };
+
+  std::vector<RecordRange>     ranges; ///< In the order of files, and in the order of records within a file.
+  std::deque<CppTypeTreeNode>* typeNodes {nullptr};
+
+  std::array<std::vector<std::pair<const cppast::CppEntity*, CppTypeTreeNode*>>, kNumIndexShards> entityNodes;
+  std::array<std::vector<const CppTypeTreeNode*>, kNumIndexShards>                              newNodes;
+};
+
+/**
+ * Runs @a worker on @a numThreads threads, the calling thread being one of them, and waits for all of them.
+ */
+static void RunInParallel(unsigned numThreads, const std::function<void()>& worker)
+{
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker();
+  for (auto& t : threads)
+    t.join();
+}
+
+/**
+ * Adds @a cppEntity to the child node of @a parentTypeNode named @a name, the node is created in @a typeNodes if
+ * needed.
+ * @return The child node and whether it is created.
+ */
+static std::pair<CppTypeTreeNode*, bool> AddChildNode(const cppast::CppEntity&     cppEntity,
+                                                      const std::string&           name,
+                                                      CppTypeTreeNode&             parentTypeNode,
+                                                      std::deque<CppTypeTreeNode>& typeNodes)
+{
+  auto&      childNode = parentTypeNode.children[name];
+  const auto isNew     = (childNode == nullptr);
+  if (isNew)
   {
+    childNode         = &typeNodes.emplace_back();
+    childNode->parent = &parentTypeNode;
+    childNode->name   = name;
+    childNode->depth  = parentTypeNode.depth + 1;
+  }
+  childNode->cppEntitySet.insert(&cppEntity);
+
+  return std::make_pair(childNode, isNew);
+}
+
+CppProgram::CppProgram(const std::vector<std::string>& files, const CppParser& parser, unsigned numThreads)
+{
+  cppEntityToTypeNode_[indexShardOf(nullptr)][nullptr] = &cppTypeTreeRoot_;
+
+  for (const auto& f : files)
     std::cout << "INFO\t Parsing '" << f << "'\n";
-    auto cppAst = parser.parseFile(f.c_str());
-    if (cppAst)
-      addCppFile(std::move(cppAst));
+
+  addCppFiles(sessionParser(parser).parseFiles(files, numThreads), numThreads);
+}
+
+CppParser CppProgram::sessionParser(const CppParser& parser)
+{
+  // Names of all files of a program are interned in one table, so that they are stored only once.
+  if (!symbolTable_)
+    symbolTable_ = parser.symbolTable() ? parser.symbolTable() : std::make_shared<cppast::CppSymbolTable>();
+
+  CppParser session(parser);
+  session.symbolTable(symbolTable_);
+  return session;
+}
+
+void CppProgram::addCppFile(std::unique_ptr<cppast::CppCompound> cppAst)
+{
+  if (!IsCppFile(*cppAst))
+    return;
+  loadType(*cppAst, cppTypeTreeRoot_);
+  fileNameToAst_.emplace(cppAst->name(), cppAst.get());
+  fileAsts_.push_back(std::move(cppAst));
+}
+
+void CppProgram::addCppFiles(std::vector<std::unique_ptr<cppast::CppCompound>> cppAsts, unsigned numThreads)
+{
+  cppAsts.erase(std::remove_if(cppAsts.begin(),
+                               cppAsts.end(),
+                               [](const std::unique_ptr<cppast::CppCompound>& cppAst) {
+                                 return !cppAst || !IsCppFile(*cppAst);
+                               }),
+                cppAsts.end());
+  if (cppAsts.empty())
+    return;
+
+  if (numThreads == 0)
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  numThreads = static_cast<unsigned>(std::min<size_t>(numThreads, cppAsts.size()));
+
+  std::vector<TypeNodeRecords> fileRecords(cppAsts.size());
+  std::atomic<size_t>          nextFileIdx {0};
+  RunInParallel(numThreads, [&]() {
+    for (auto i = nextFileIdx++; i < cppAsts.size(); i = nextFileIdx++)
+      collectTypeNodes(*cppAsts[i], TypeNodeRecord::kTopLevel, fileRecords[i]);
+  });
+
+  mergeTypeNodes(cppAsts, fileRecords, numThreads);
+
+  for (auto& cppAst : cppAsts)
+  {
+    fileNameToAst_.emplace(cppAst->name(), cppAst.get());
+    fileAsts_.push_back(std::move(cppAst));
+  }
+}
+
+/**
+ * @return Canonical path of @a path, empty if it is not a regular file.
+ */
+static std::string CanonicalFilePath(const fs::path& path)
+{
+  std::error_code ec;
+  if (!fs::is_regular_file(path, ec))
+    return std::string();
+  auto canonicalPath = fs::weakly_canonical(path, ec);
+  return ec ? std::string() : canonicalPath.string();
+}
+
+/**
+ * @param includeName Name of included file including the delimiters, i.e. "file.h" or <file.h>.
+ * @return Canonical path of the included file, empty if it cannot be found.
+ */
+static std::string ResolveInclude(const std::string&              includeName,
+                                  const fs::path&                 includerDir,
+                                  const std::vector<std::string>& includeDirs)
+{
+  if (includeName.size() < 3)
+    return std::string();
+  const fs::path header = includeName.substr(1, includeName.size() - 2);
+  if (header.is_absolute())
+    return CanonicalFilePath(header);
+
+  if (includeName.front() == '"')
+  {
+    auto path = CanonicalFilePath(includerDir / header);
+    if (!path.empty())
+      return path;
+  }
+  for (const auto& includeDir : includeDirs)
+  {
+    auto path = CanonicalFilePath(fs::path(includeDir) / header);
+    if (!path.empty())
+      return path;
   }
+
+  return std::string();
+}
+
+/**
+ * Appends names of all files included by @a cppCompound and by compounds nested in it.
+ */
+static void CollectIncludes(const cppast::CppCompound& cppCompound, std::vector<std::string>& includeNames)
+{
+  cppCompound.visitAll([&](const cppast::CppEntity& mem) {
+    if (IsPreProcessorType(mem))
+    {
+      const auto& preprocessor = static_cast<const cppast::CppPreprocessor&>(mem);
+      if (preprocessor.preprocessorType() == cppast::CppPreprocessorType::INCLUDE)
+        includeNames.push_back(static_cast<const cppast::CppPreprocessorInclude&>(mem).name());
+    }
+    else if (IsCompound(mem))
+    {
+      CollectIncludes(static_cast<const cppast::CppCompound&>(mem), includeNames);
+    }
+
+    return true;
+  });
+}
+
+void CppProgram::addSourceFiles(const std::vector<std::string>& sourceFiles,
+                                const std::vector<std::string>& includeDirs,
+                                const CppParser&                parser,
+                                unsigned                        numThreads)
+{
+  if (numThreads == 0)
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  const auto session = sessionParser(parser);
+
+  struct IncludeGraphNode
+  {
+    std::string                          path;
+    std::unique_ptr<cppast::CppCompound> ast;
+    std::vector<size_t>                  includes;
+  };
+
+  // Deque never moves its elements, so, a worker can fill a node while others discover new files.
+  std::deque<IncludeGraphNode>                 graphNodes;
+  std::unordered_map<std::string, size_t>      pathToGraphNode;
+  std::deque<size_t>                           pending;
+  std::unordered_map<std::string, std::string> resolvedIncludes;
+  unsigned                                     numBusy = 0;
+  std::exception_ptr                           firstError;
+  std::mutex                                   mutex;
+  std::condition_variable                      cv;
+
+  // Must be called with mutex locked.
+  const auto discover = [&](std::string path) {
+    const auto inserted = pathToGraphNode.emplace(path, graphNodes.size());
+    if (inserted.second)
+    {
+      graphNodes.push_back(IncludeGraphNode {std::move(path), nullptr, {}});
+      pending.push_back(inserted.first->second);
+    }
+    return inserted.first->second;
+  };
+
+  std::vector<size_t> sourceGraphNodes;
+  for (const auto& sourceFile : sourceFiles)
+  {
+    auto path = CanonicalFilePath(sourceFile);
+    if (!path.empty())
+      sourceGraphNodes.push_back(discover(std::move(path)));
+  }
+
+  const auto worker = [&]() {
+    std::unique_lock<std::mutex> lock(mutex);
+    for (;;)
+    {
+      cv.wait(lock, [&]() { return !pending.empty() || (numBusy == 0); });
+      if (pending.empty())
+        break;
+      auto& graphNode = graphNodes[pending.front()];
+      pending.pop_front();
+      ++numBusy;
+      lock.unlock();
+
+      std::vector<std::string> includedPaths;
+      try
+      {
+        const auto* cppAst = fileAst(graphNode.path);
+        if (!cppAst)
+        {
+          graphNode.ast = session.parseFile(graphNode.path);
+          cppAst        = graphNode.ast.get();
+        }
+        if (cppAst)
+        {
+          std::vector<std::string> includeNames;
+          CollectIncludes(*cppAst, includeNames);
+          const auto includerDir = fs::path(graphNode.path).parent_path();
+          for (const auto& includeName : includeNames)
+          {
+            // Same header is included from many files, probing the file system for it once is enough.
+            // Result for an include using double quotes also depends on the directory of includer.
+            auto key = (includeName.front() == '"') ? includerDir.string() : std::string();
+            key.append(1, '\0').append(includeName);
+            // References to elements of unordered_map remain valid while other threads insert more.
+            lock.lock();
+            const auto  itr      = resolvedIncludes.find(key);
+            const auto* resolved = (itr == resolvedIncludes.end()) ? nullptr : &itr->second;
+            lock.unlock();
+            if (!resolved)
+            {
+              auto path = ResolveInclude(includeName, includerDir, includeDirs);
+              lock.lock();
+              resolved = &resolvedIncludes.emplace(std::move(key), std::move(path)).first->second;
+              lock.unlock();
+            }
+            if (!resolved->empty())
+              includedPaths.push_back(*resolved);
+          }
+        }
+      }
+      catch (...)
+      {
+        lock.lock();
+        if (!firstError)
+          firstError = std::current_exception();
+        lock.unlock();
+      }
+
+      lock.lock();
+      for (auto& path : includedPaths)
+        graphNode.includes.push_back(discover(std::move(path)));
+      --numBusy;
+      cv.notify_all();
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker(); // Calling thread is one of the workers.
+  for (auto& t : threads)
+    t.join();
+
+  if (firstError)
+    std::rethrow_exception(firstError);
+
+  std::vector<bool>                                 visited(graphNodes.size());
+  std::deque<size_t>                                bfsQueue;
+  std::vector<std::unique_ptr<cppast::CppCompound>> cppAsts;
+  for (const auto idx : sourceGraphNodes)
+  {
+    if (!visited[idx])
+    {
+      visited[idx] = true;
+      bfsQueue.push_back(idx);
+    }
+  }
+  while (!bfsQueue.empty())
+  {
+    auto& graphNode = graphNodes[bfsQueue.front()];
+    bfsQueue.pop_front();
+    if (graphNode.ast)
+      cppAsts.push_back(std::move(graphNode.ast));
+
+    auto& includedFiles = includeGraph_[graphNode.path];
+    includedFiles.clear();
+    for (const auto idx : graphNode.includes)
+    {
+      includedFiles.push_back(graphNodes[idx].path);
+      if (!visited[idx])
+      {
+        visited[idx] = true;
+        bfsQueue.push_back(idx);
+      }
+    }
+  }
+
+  addCppFiles(std::move(cppAsts), numThreads);
+}
+
+const cppast::CppCompound* CppProgram::fileAst(const std::string& filename) const
+{
+  const auto itr = fileNameToAst_.find(filename);
+  return (itr == fileNameToAst_.end()) ? nullptr : itr->second;
+}
+
+const std::vector<std::string>& CppProgram::includedFiles(const std::string& filename) const
+{
+  static const std::vector<std::string> kNoIncludedFiles;
+
+  const auto itr = includeGraph_.find(filename);
+  return (itr == includeGraph_.end()) ? kNoIncludedFiles : itr->second;
+}
+
+/**
+ * @return true if @a lhs is reached before @a rhs in breadth first walk of type tree
+ * that visits children of a node in order of their names.
+ */
+static bool IsSearchedBefore(const CppTypeTreeNode* lhs, const CppTypeTreeNode* rhs)
+{
+  if (lhs->depth != rhs->depth)
+    return lhs->depth < rhs->depth;
+  // Nodes of same depth are in the order of their parents, and siblings are in the order of their names.
+  while (lhs->parent != rhs->parent)
+  {
+    lhs = lhs->parent;
+    rhs = rhs->parent;
+  }
+  return lhs->name < rhs->name;
+}
+
+void CppProgram::indexTypeNodeName(const CppTypeTreeNode* typeNode)
+{
+  // Nodes are kept in search order, which does not depend on the order in which they are added.
+  auto& sameNamedNodes = nameToTypeNodes_[indexShardOf(typeNode->name)][typeNode->name];
+  sameNamedNodes.insert(
+    std::upper_bound(sameNamedNodes.begin(), sameNamedNodes.end(), typeNode, IsSearchedBefore), typeNode);
+}
+
+CppTypeTreeNode& CppProgram::addTypeNode(const cppast::CppEntity& cppEntity,
+                                         const std::string&       name,
+                                         CppTypeTreeNode&         parentTypeNode)
+{
+  if (typeNodes_.empty())
+    typeNodes_.emplace_back();
+  const auto [childNode, isNew] = AddChildNode(cppEntity, name, parentTypeNode, typeNodes_.back());
+  if (isNew)
+    indexTypeNodeName(childNode);
+  cppEntityToTypeNode_[indexShardOf(&cppEntity)][&cppEntity] = childNode;
+
+  return *childNode;
 }
 
 void CppProgram::addCompound(const cppast::CppCompound& compound, CppTypeTreeNode& parentTypeNode)
 {
   if (compound.name().empty())
     return;
-  auto& childNode = parentTypeNode.children[compound.name()];
-  childNode.cppEntitySet.insert(&compound);
-  childNode.parent                = &parentTypeNode;
-  cppEntityToTypeNode_[&compound] = &childNode;
+  auto& childNode = addTypeNode(compound, compound.name(), parentTypeNode);
   loadType(compound, childNode);
 }
 
 void CppProgram::addCompound(const cppast::CppCompound& compound, const cppast::CppCompound& parent)
 {
-  auto itr = cppEntityToTypeNode_.find(&parent);
-  if (itr != cppEntityToTypeNode_.end())
+  const auto& index = cppEntityToTypeNode_[indexShardOf(&parent)];
+  const auto  itr   = index.find(&parent);
+  if (itr != index.end())
     addCompound(compound, *(itr->second));
 }
 
 void CppProgram::loadType(const cppast::CppCompound& cppCompound, CppTypeTreeNode& typeNode)
 {
-  if (IsCppFile(cppCompound)) // Type node for file object should be the root itself.
-  {
-    cppEntityToTypeNode_[&cppCompound] = &typeNode;
-    typeNode.cppEntitySet.insert(&cppCompound);
-  }
+  TypeNodeRecords records;
+  collectTypeNodes(cppCompound, TypeNodeRecord::kTopLevel, records);
+  mergeTypeNodes(cppCompound, records, typeNode);
+}
+
+void CppProgram::collectTypeNodes(const cppast::CppCompound& cppCompound, size_t parentIdx, TypeNodeRecords& records)
+{
+  const auto addRecord = [&](const cppast::CppEntity& mem, const std::string& name) {
+    records.push_back(TypeNodeRecord {&mem, &name, parentIdx, records.size() + 1});
+  };
+
   cppCompound.visitAll([&](const cppast::CppEntity& mem) {
     if (IsCompound(mem))
     {
-      addCompound(*static_cast<const cppast::CppCompound*>(&mem), typeNode);
+      const auto& compound = static_cast<const cppast::CppCompound&>(mem);
+      if (!compound.name().empty())
+      {
+        addRecord(mem, compound.name());
+        const auto compoundIdx = records.size() - 1;
+        collectTypeNodes(compound, compoundIdx, records);
+        records[compoundIdx].subtreeEnd = records.size();
+      }
     }
     else if (IsEnum(mem))
     {
-      CppTypeTreeNode& childNode = typeNode.children[((cppast::CppEnum&) mem).name()];
-      childNode.cppEntitySet.insert(&mem);
-      childNode.parent           = &typeNode;
-      cppEntityToTypeNode_[&mem] = &childNode;
+      addRecord(mem, static_cast<const cppast::CppEnum&>(mem).name());
     }
     else if (IsTypedefName(mem))
     {
-      const auto&      typedefName = static_cast<const cppast::CppTypedefName&>(mem);
-      CppTypeTreeNode& childNode   = typeNode.children[typedefName.var()->name()];
-      childNode.cppEntitySet.insert(&mem);
-      childNode.parent           = &typeNode;
-      cppEntityToTypeNode_[&mem] = &childNode;
+      addRecord(mem, static_cast<const cppast::CppTypedefName&>(mem).var()->name());
     }
     else if (IsUsingDecl(mem))
     {
-      const auto&      usingDecl = static_cast<const cppast::CppUsingDecl&>(mem);
-      CppTypeTreeNode& childNode = typeNode.children[usingDecl.name()];
-      childNode.cppEntitySet.insert(&mem);
-      childNode.parent           = &typeNode;
-      cppEntityToTypeNode_[&mem] = &childNode;
+      addRecord(mem, static_cast<const cppast::CppUsingDecl&>(mem).name());
     }
     else if (IsFunctionPtr(mem))
     {
-      CppTypeTreeNode& childNode = typeNode.children[((const cppast::CppFunctionPointer&) mem).name()];
-      childNode.cppEntitySet.insert(&mem);
-      childNode.parent           = &typeNode;
-      cppEntityToTypeNode_[&mem] = &childNode;
+      addRecord(mem, static_cast<const cppast::CppFunctionPointer&>(mem).name());
     }
     else if (IsFwdClsDecl(mem))
     {
       const auto& fwdCls = static_cast<const cppast::CppForwardClassDecl&>(mem);
       if (!(fwdCls.attr() & cppast::CppIdentifierAttrib::FRIEND))
+        addRecord(mem, fwdCls.name());
+    }
+
+    return true;
+  });
+}
+
+void CppProgram::mergeTypeNodes(const cppast::CppCompound& cppCompound,
+                                const TypeNodeRecords&     records,
+                                CppTypeTreeNode&           typeNode)
+{
+  if (IsCppFile(cppCompound)) // Type node for file object should be the root itself.
+  {
+    cppEntityToTypeNode_[indexShardOf(&cppCompound)][&cppCompound] = &typeNode;
+    typeNode.cppEntitySet.insert(&cppCompound);
+  }
+
+  // Records are in pre-order, so, node of a parent is always added before nodes of its children.
+  std::vector<CppTypeTreeNode*> recordNodes;
+  recordNodes.reserve(records.size());
+  for (const auto& record : records)
+  {
+    auto& parentNode = (record.parentIdx == TypeNodeRecord::kTopLevel) ? typeNode : *recordNodes[record.parentIdx];
+    recordNodes.push_back(&addTypeNode(*record.cppEntity, *record.name, parentNode));
+  }
+}
+
+void CppProgram::mergeTypeNodes(const std::vector<std::unique_ptr<cppast::CppCompound>>& cppAsts,
+                                const std::vector<TypeNodeRecords>&                      fileRecords,
+                                unsigned                                                 numThreads)
+{
+  // Top level nodes are children of the root, which all files share, so, they are added on this thread.
+  // Rest of the nodes of a file are in subtrees of its top level nodes. Subtrees of one top level node, from all
+  // files, are merged by one thread in the order of files. So, no node is modified by more than one thread, and
+  // children of every node are added in the same order as when files are merged one by one.
+  // More shards than threads keep all threads busy when some top level nodes have much bigger subtrees.
+  std::vector<TypeNodeShard>                         shards(numThreads * 4);
+  std::unordered_map<const CppTypeTreeNode*, size_t> topLevelNodeToShard;
+  std::vector<std::vector<CppTypeTreeNode*>>         fileRecordNodes(cppAsts.size());
+  for (size_t fileIdx = 0; fileIdx < cppAsts.size(); ++fileIdx)
+  {
+    cppEntityToTypeNode_[indexShardOf(cppAsts[fileIdx].get())][cppAsts[fileIdx].get()] = &cppTypeTreeRoot_;
+    cppTypeTreeRoot_.cppEntitySet.insert(cppAsts[fileIdx].get());
+
+    const auto& records     = fileRecords[fileIdx];
+    auto&       recordNodes = fileRecordNodes[fileIdx];
+    recordNodes.resize(records.size());
+    for (size_t i = 0; i < records.size(); i = records[i].subtreeEnd)
+    {
+      recordNodes[i] = &addTypeNode(*records[i].cppEntity, *records[i].name, cppTypeTreeRoot_);
+      if (records[i].subtreeEnd == i + 1)
+        continue;
+      const auto shardIdx =
+        topLevelNodeToShard.emplace(recordNodes[i], topLevelNodeToShard.size() % shards.size()).first->second;
+      shards[shardIdx].ranges.push_back(TypeNodeShard::RecordRange {fileIdx, i + 1, records[i].subtreeEnd});
+    }
+  }
+  for (auto& shard : shards)
+  {
+    if (!shard.ranges.empty())
+      shard.typeNodes = &typeNodes_.emplace_back();
+  }
+
+  std::atomic<size_t> nextShardIdx {0};
+  RunInParallel(numThreads, [&]() {
+    for (auto shardIdx = nextShardIdx++; shardIdx < shards.size(); shardIdx = nextShardIdx++)
+    {
+      auto& shard = shards[shardIdx];
+      for (const auto& range : shard.ranges)
       {
-        CppTypeTreeNode& childNode = typeNode.children[fwdCls.name()];
-        childNode.cppEntitySet.insert(&mem);
-        childNode.parent           = &typeNode;
-        cppEntityToTypeNode_[&mem] = &childNode;
+        const auto& records     = fileRecords[range.fileIdx];
+        auto&       recordNodes = fileRecordNodes[range.fileIdx];
+        for (auto i = range.beginIdx; i < range.endIdx; ++i)
+        {
+          const auto& record = records[i];
+          const auto [childNode, isNew] =
+            AddChildNode(*record.cppEntity, *record.name, *recordNodes[record.parentIdx], *shard.typeNodes);
+          recordNodes[i] = childNode;
+          shard.entityNodes[indexShardOf(record.cppEntity)].emplace_back(record.cppEntity, childNode);
+          if (isNew)
+            shard.newNodes[indexShardOf(childNode->name)].push_back(childNode);
+        }
       }
     }
+  });
 
-    return false;
+  // Every shard of the indexes is filled by one thread.
+  // New nodes of a name are appended and sorted once, instead of inserting each of them in the middle.
+  std::atomic<size_t> nextIndexShardIdx {0};
+  RunInParallel(static_cast<unsigned>(std::min<size_t>(numThreads, kNumIndexShards)), [&]() {
+    for (auto indexShardIdx = nextIndexShardIdx++; indexShardIdx < kNumIndexShards;
+         indexShardIdx      = nextIndexShardIdx++)
+    {
+      auto&                                             nameIndex = nameToTypeNodes_[indexShardIdx];
+      std::vector<std::vector<const CppTypeTreeNode*>*> unsortedNodes;
+      for (const auto& shard : shards)
+      {
+        for (const auto& entityNode : shard.entityNodes[indexShardIdx])
+          cppEntityToTypeNode_[indexShardIdx][entityNode.first] = entityNode.second;
+        for (const auto* typeNode : shard.newNodes[indexShardIdx])
+        {
+          auto& sameNamedNodes = nameIndex[typeNode->name];
+          if (!sameNamedNodes.empty() && IsSearchedBefore(typeNode, sameNamedNodes.back()))
+            unsortedNodes.push_back(&sameNamedNodes);
+          sameNamedNodes.push_back(typeNode);
+        }
+      }
+      std::sort(unsortedNodes.begin(), unsortedNodes.end());
+      unsortedNodes.erase(std::unique(unsortedNodes.begin(), unsortedNodes.end()), unsortedNodes.end());
+      for (auto* sameNamedNodes : unsortedNodes)
+        std::sort(sameNamedNodes->begin(), sameNamedNodes->end(), IsSearchedBefore);
+    }
   });
 }
 
-const CppTypeTreeNode* CppProgram::nameLookup(const std::string& name, const CppTypeTreeNode* beginFrom) const
+const CppTypeTreeNode* CppProgram::nameLookup(std::string_view name, const CppTypeTreeNode* beginFrom) const
 {
   if (name.empty())
     return &cppTypeTreeRoot_;
-  auto*  typeNode   = beginFrom ? beginFrom : &cppTypeTreeRoot_;
-  size_t nameBegPos = 0;
-  size_t nameEndPos = name.find("::", nameBegPos);
-  if (nameEndPos == std::string::npos)
+
+  // Only the first segment is searched upward, rest of them must be right inside the scope found so far.
+  auto       segmentEndPos = name.find("::");
+  const auto firstSegment  = name.substr(0, segmentEndPos);
+
+  const CppTypeTreeNode* typeNode = nullptr;
+  if (firstSegment.empty())
   {
-    for (; typeNode != nullptr; typeNode = typeNode->parent)
-    {
-      CppTypeTree::const_iterator itr = typeNode->children.find(name);
-      if (itr != typeNode->children.end())
-        return &itr->second;
-    }
-    return nullptr;
+    typeNode = &cppTypeTreeRoot_;
   }
   else
   {
-    auto nameToLookFor = name.substr(nameBegPos, nameEndPos - nameBegPos);
-    typeNode           = nameLookup(nameToLookFor, typeNode);
-    if (!typeNode)
-      return nullptr;
-    do
-    {
-      nameBegPos = nameEndPos + 2;
-      nameEndPos = name.find("::", nameBegPos);
-      if (nameEndPos == std::string::npos)
-        nameEndPos = name.length();
-      nameToLookFor = name.substr(nameBegPos, nameEndPos - nameBegPos);
-      auto itr      = typeNode->children.find(nameToLookFor);
-      if (itr == typeNode->children.end())
-        return nullptr;
-      typeNode = &itr->second;
-    } while (nameEndPos < name.length());
+    for (const auto* scope = beginFrom ? beginFrom : &cppTypeTreeRoot_; scope && !typeNode; scope = scope->parent)
+      typeNode = scope->child(firstSegment);
   }
+
+  while (typeNode && (segmentEndPos != std::string_view::npos))
+  {
+    const auto segmentBegPos = segmentEndPos + 2;
+    segmentEndPos            = name.find("::", segmentBegPos);
+    typeNode                 = typeNode->child(name.substr(segmentBegPos, segmentEndPos - segmentBegPos));
+  }
+
   return typeNode;
 }
 
-const CppTypeTreeNode* CppProgram::searchTypeNode(const std::string& name, const CppTypeTreeNode* parentNode) const
+bool CppProgram::has(const CppTypeTreeNode& scope, const cppast::CppEntity* cppEntity) const
 {
-  std::vector<const CppTypeTreeNode*> nextLevelNodes(1, parentNode ? parentNode : &cppTypeTreeRoot_);
+  const auto* typeNode = typeTreeNodeFromCppEntity(cppEntity);
+  return typeNode && scope.encloses(*typeNode);
+}
 
-  do
+/**
+ * @return true if @a node is in the subtree of @a ancestor, excluding @a ancestor itself.
+ */
+static bool IsUnder(const CppTypeTreeNode* node, const CppTypeTreeNode* ancestor)
+{
+  return (node != ancestor) && ancestor->encloses(*node);
+}
+
+const CppTypeTreeNode* CppProgram::searchTypeNode(std::string_view name, const CppTypeTreeNode* parentNode) const
+{
+  const auto& index = nameToTypeNodes_[indexShardOf(name)];
+  const auto  itr   = index.find(name);
+  if (itr == index.end())
+    return nullptr;
+  for (const auto* node : itr->second)
   {
-    std::vector<const CppTypeTreeNode*> currentLevelNodes;
-    currentLevelNodes.swap(nextLevelNodes);
-    assert(nextLevelNodes.empty());
-    for (const auto* node : currentLevelNodes)
-    {
-      for (const auto& child : node->children)
-      {
-        if (child.first == name)
-          return &(child.second);
-        nextLevelNodes.push_back(&(child.second));
-      }
-    }
-  } while (!nextLevelNodes.empty());
+    if (!parentNode || IsUnder(node, parentNode))
+      return node;
+  }
 
   return nullptr;
 }
 
+std::vector<const CppTypeTreeNode*> CppProgram::searchTypeNodes(std::string_view       name,
+                                                                const CppTypeTreeNode* parentNode) const
+{
+  std::vector<const CppTypeTreeNode*> result;
+
+  const auto& index = nameToTypeNodes_[indexShardOf(name)];
+  const auto  itr   = index.find(name);
+  if (itr == index.end())
+    return result;
+  for (const auto* node : itr->second)
+  {
+    if (!parentNode || IsUnder(node, parentNode))
+      result.push_back(node);
+  }
+
+  return result;
+}
+
 } // namespace cppparser
@@ -2,82 +2,125 @@
 // SPDX-License-Identifier: MIT
 
 #include "cppparser/cppparser.h"
+#include "ast-cache.h"
 #include "cppast/cppast.h"
+#include "file-buffer.h"
+#include "parser-options.h"
 #include "parser.h"
 #include "utils.h"
 
 #include <algorithm>
-#include <map>
-#include <set>
+#include <atomic>
+#include <cstdint>
+#include <exception>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <numeric>
 #include <stdexcept>
 #include <string>
+#include <thread>
 #include <vector>
 
-// Unfortunately parser is not reentrant and has no way as of now to inject parameters.
-// So, we need globals.
+extern int GetKeywordId(const std::string& keyword);
 
-// Globals to help parse when preprocessors are used
-std::set<std::string>      gMacroNames;
-std::set<std::string>      gKnownApiDecorNames;
-std::map<std::string, int> gDefinedNames;
-std::set<std::string>      gUndefinedNames;
-std::set<std::string>      gIgnorableMacroNames;
-std::map<std::string, int> gRenamedKeywords;
+/**
+ * @return Indices of files in descending order of their sizes.
+ */
+static std::vector<size_t> LargestFirstOrder(const std::vector<std::string>& filenames)
+{
+  std::vector<std::uintmax_t> sizes;
+  sizes.reserve(filenames.size());
+  for (const auto& filename : filenames)
+  {
+    std::error_code ec;
+    const auto      size = std::filesystem::file_size(filename, ec);
+    sizes.push_back(ec ? 0 : size);
+  }
 
-bool gParseEnumBodyAsBlob     = false;
-bool gParseFunctionBodyAsBlob = false;
+  std::vector<size_t> order(filenames.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(), [&sizes](size_t lhs, size_t rhs) { return sizes[lhs] > sizes[rhs]; });
 
-extern int GetKeywordId(const std::string& keyword);
+  return order;
+}
 
 namespace cppparser {
 
+CppParser::CppParser()
+  : options_(std::make_unique<ParserOptions>())
+{
+}
+
+CppParser::CppParser(const CppParser& other)
+  : options_(std::make_unique<ParserOptions>(*other.options_))
+  , astCache_(other.astCache_)
+{
+}
+
+CppParser::CppParser(CppParser&& other) noexcept = default;
+
+CppParser::~CppParser() = default;
+
+CppParser& CppParser::operator=(const CppParser& other)
+{
+  if (this != &other)
+  {
+    *options_ = *other.options_;
+    astCache_ = other.astCache_;
+  }
+  return *this;
+}
+
+CppParser& CppParser::operator=(CppParser&& other) noexcept = default;
+
 void CppParser::addKnownMacro(std::string knownMacro)
 {
-  gMacroNames.insert(std::move(knownMacro));
+  options_->identifiers.add(std::move(knownMacro), IdentifierKind::Macro);
 }
 
 void CppParser::addKnownMacros(const std::vector<std::string>& knownMacros)
 {
   for (auto& macro : knownMacros)
-    gMacroNames.insert(macro);
+    options_->identifiers.add(macro, IdentifierKind::Macro);
 }
 
 void CppParser::addDefinedName(std::string definedName, int value)
 {
-  gDefinedNames[std::move(definedName)] = value;
+  options_->definedNames[std::move(definedName)] = value;
 }
 
 void CppParser::addUndefinedName(std::string undefinedName)
 {
-  gUndefinedNames.insert(std::move(undefinedName));
+  options_->undefinedNames.insert(std::move(undefinedName));
 }
 
 void CppParser::addUndefinedNames(const std::vector<std::string>& undefinedNames)
 {
   for (auto& macro : undefinedNames)
-    gUndefinedNames.insert(macro);
+    options_->undefinedNames.insert(macro);
 }
 
 void CppParser::addIgnorableMacro(std::string ignorableMacro)
 {
-  gIgnorableMacroNames.insert(std::move(ignorableMacro));
+  options_->identifiers.add(std::move(ignorableMacro), IdentifierKind::IgnorableMacro);
 }
 
 void CppParser::addIgnorableMacros(const std::vector<std::string>& ignorableMacros)
 {
   for (auto& macro : ignorableMacros)
-    gIgnorableMacroNames.insert(macro);
+    options_->identifiers.add(macro, IdentifierKind::IgnorableMacro);
 }
 
 void CppParser::addKnownApiDecor(std::string knownApiDecor)
 {
-  gKnownApiDecorNames.insert(std::move(knownApiDecor));
+  options_->identifiers.add(std::move(knownApiDecor), IdentifierKind::ApiDecor);
 }
 
 void CppParser::addKnownApiDecors(const std::vector<std::string>& knownApiDecor)
 {
   for (auto& apiDecor : knownApiDecor)
-    gKnownApiDecorNames.insert(apiDecor);
+    options_->identifiers.add(apiDecor, IdentifierKind::ApiDecor);
 }
 
 bool CppParser::addRenamedKeyword(const std::string& keyword, std::string renamedKeyword)
@@ -85,46 +128,163 @@ bool CppParser::addRenamedKeyword(const std::string& keyword, std::string rename
   auto id = GetKeywordId(keyword);
   if (id == -1)
     return false;
-  gRenamedKeywords.emplace(std::make_pair(std::move(renamedKeyword), id));
+  options_->identifiers.add(std::move(renamedKeyword), IdentifierKind::RenamedKeyword, id);
 
   return true;
 }
 
 void CppParser::parseEnumBodyAsBlob()
 {
-  gParseEnumBodyAsBlob = true;
+  options_->parseEnumBodyAsBlob = true;
 }
 
 void CppParser::parseFunctionBodyAsBlob(bool asBlob)
 {
-  gParseFunctionBodyAsBlob = asBlob;
+  options_->parseFunctionBodyAsBlob = asBlob;
 }
 
-std::unique_ptr<cppast::CppCompound> CppParser::parseFile(const std::string& filename)
+void CppParser::parseFunctionBodyLazily(bool lazily)
 {
-  auto stm         = ReadFile(filename);
-  auto cppCompound = ParseStream(stm.data(), stm.size());
+  options_->parseFunctionBodyLazily = lazily;
+}
+
+void CppParser::allocateEntitiesFromArena(bool fromArena)
+{
+  options_->allocateEntitiesFromArena = fromArena;
+}
+
+void CppParser::shareSourceBuffer(bool share)
+{
+  options_->shareSourceBuffer = share;
+}
+
+void CppParser::symbolTable(std::shared_ptr<cppast::CppSymbolTable> symbolTableArg)
+{
+  options_->symbolTable = std::move(symbolTableArg);
+}
+
+const std::shared_ptr<cppast::CppSymbolTable>& CppParser::symbolTable() const
+{
+  return options_->symbolTable;
+}
+
+void CppParser::cacheParsedFiles(std::string cacheDir, std::uint64_t maxCacheSize)
+{
+  astCache_ = cacheDir.empty() ? nullptr : std::make_shared<AstCache>(std::move(cacheDir), maxCacheSize);
+}
+
+std::unique_ptr<cppast::CppCompound> CppParser::parseFile(const std::string& filename) const
+{
+  auto stm = std::make_shared<FileBuffer>(filename, options_->shareSourceBuffer);
+  if (stm->size() == 0)
+    return nullptr;
+
+  auto* const           astCache = options_->parseFunctionBodyLazily ? nullptr : astCache_.get();
+  std::filesystem::path cacheEntry;
+  if (astCache)
+  {
+    cacheEntry = astCache->entryPath(std::string_view(stm->data(), stm->size()), *options_);
+
+    // Names of an AST loaded from cache are interned the same way as those of a parsed one.
+    auto symbolTable = options_->symbolTable ? options_->symbolTable : std::make_shared<cppast::CppSymbolTable>();
+    cppast::CppSymbolTable::Scope symbolTableScope(*symbolTable);
+    if (auto cppCompound = astCache->load(cacheEntry, *options_))
+    {
+      cppCompound->name(filename);
+      cppCompound->symbolTable(std::move(symbolTable));
+      return cppCompound;
+    }
+  }
+
+  auto cppCompound = ParseStream(stm->data(), stm->size(), *options_);
   if (!cppCompound)
     return cppCompound;
   cppCompound->name(filename);
+  if (astCache)
+    astCache->store(cacheEntry, *cppCompound);
+  if (options_->shareSourceBuffer)
+    cppCompound->sourceBuffer(std::move(stm));
   return cppCompound;
 }
 
-std::unique_ptr<cppast::CppCompound> CppParser::parseStream(char* stm, size_t stmSize)
+std::vector<std::unique_ptr<cppast::CppCompound>> CppParser::parseFiles(const std::vector<std::string>& filenames,
+                                                                         unsigned numThreads) const
+{
+  std::vector<std::unique_ptr<cppast::CppCompound>> asts(filenames.size());
+  if (filenames.empty())
+    return asts;
+
+  if (numThreads == 0)
+    numThreads = std::max(1U, std::thread::hardware_concurrency());
+  numThreads = static_cast<unsigned>(std::min<size_t>(numThreads, filenames.size()));
+
+  const auto          order = LargestFirstOrder(filenames);
+  std::atomic<size_t> nextInOrder {0};
+  std::exception_ptr  firstError;
+  std::mutex          errorMutex;
+
+  const auto worker = [&]() {
+    for (auto i = nextInOrder++; i < order.size(); i = nextInOrder++)
+    {
+      const auto fileIdx = order[i];
+      try
+      {
+        asts[fileIdx] = parseFile(filenames[fileIdx]);
+      }
+      catch (...)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!firstError)
+          firstError = std::current_exception();
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 1; i < numThreads; ++i)
+    threads.emplace_back(worker);
+  worker(); // Calling thread is one of the workers.
+  for (auto& t : threads)
+    t.join();
+
+  if (firstError)
+    std::rethrow_exception(firstError);
+
+  return asts;
+}
+
+std::unique_ptr<cppast::CppCompound> CppParser::parseStream(char* stm, size_t stmSize) const
 {
   if ((stm == nullptr) || (stmSize < 2) || (stm[stmSize - 1] != '\0') || (stm[stmSize - 2] != '\0'))
     throw std::invalid_argument("Stream must be valid and it must terminate with double null characters");
-  return ::ParseStream(stm, stmSize);
+  return ::ParseStream(stm, stmSize, *options_);
+}
+
+std::unique_ptr<cppast::CppCompound> CppParser::parseStream(const char* stm, size_t stmSize) const
+{
+  if ((stm == nullptr) && (stmSize != 0))
+    throw std::invalid_argument("Stream must be valid");
+  while ((stmSize != 0) && (stm[stmSize - 1] == '\0'))
+    --stmSize;
+
+  // Scanner terminates tokens in place, so, it needs a writable copy that it can also terminate the way it needs.
+  std::unique_ptr<char[]> scanBuffer(new char[stmSize + 3]);
+  std::copy(stm, stm + stmSize, scanBuffer.get());
+  scanBuffer[stmSize]     = '\n';
+  scanBuffer[stmSize + 1] = '\0';
+  scanBuffer[stmSize + 2] = '\0';
+
+  return ::ParseStream(scanBuffer.get(), stmSize + 3, *options_, stm, stmSize);
 }
 
 void CppParser::setErrorHandler(ErrorHandler errorHandler)
 {
-  ::SetErrorHandler(errorHandler);
+  options_->errorHandler = std::move(errorHandler);
 }
 
 void CppParser::resetErrorHandler()
 {
-  ::ResetErrorHandler();
+  options_->errorHandler = nullptr;
 }
 
 } // namespace cppparser
@@ -0,0 +1,121 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "file-buffer.h"
+#include "cppparser/string-utils.h"
+
+#include <cstring>
+#include <fstream>
+
+#if !defined(_WIN32)
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+// A new line and 2 null characters.
+static constexpr size_t kNumTerminatingChars = 3;
+
+FileBuffer::FileBuffer(const std::string& filename, bool shared)
+{
+  size_t fileSize = 0;
+  if (!mapFile(filename, fileSize) && !readFile(filename, fileSize))
+    return;
+
+  // Texts that are views into the buffer keep line endings of the file, others never see carriage returns.
+  // Most files have none, and so, they are only read to find that out.
+  if (!shared)
+  {
+    if (auto* const firstCr = static_cast<char*>(std::memchr(data_, '\r', fileSize)))
+      fileSize = (firstCr - data_) + StripChar(firstCr, data_ + fileSize - firstCr, '\r');
+  }
+  terminate(fileSize);
+}
+
+FileBuffer::~FileBuffer()
+{
+#if !defined(_WIN32)
+  if (mappedSize_ != 0)
+    munmap(data_, mappedSize_);
+#endif
+}
+
+bool FileBuffer::mapFile(const std::string& filename, size_t& fileSize)
+{
+#if defined(_WIN32)
+  (void) filename;
+  (void) fileSize;
+  return false;
+#else
+  const int fd = open(filename.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return false;
+
+  struct stat fileStat;
+  if ((fstat(fd, &fileStat) != 0) || !S_ISREG(fileStat.st_mode))
+  {
+    close(fd);
+    return false;
+  }
+
+  fileSize              = static_cast<size_t>(fileStat.st_size);
+  const auto pageSize   = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const auto mappedSize = (fileSize + kNumTerminatingChars + pageSize - 1) / pageSize * pageSize;
+
+  // Anonymous memory is reserved for the whole buffer and the file is then mapped over its beginning.
+  // So, even when the file ends exactly at a page boundary the terminating characters go into a zero filled page.
+  auto* const addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (addr == MAP_FAILED)
+  {
+    close(fd);
+    return false;
+  }
+  if ((fileSize != 0)
+      && (mmap(addr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, 0) == MAP_FAILED))
+  {
+    munmap(addr, mappedSize);
+    close(fd);
+    return false;
+  }
+  close(fd);
+  madvise(addr, mappedSize, MADV_SEQUENTIAL);
+
+  data_       = static_cast<char*>(addr);
+  mappedSize_ = mappedSize;
+
+  return true;
+#endif
+}
+
+bool FileBuffer::readFile(const std::string& filename, size_t& fileSize)
+{
+  std::ifstream in(filename, std::ios::in | std::ios::binary);
+  if (!in)
+    return false;
+
+  in.seekg(0, std::ios::end);
+  const auto endPos = in.tellg();
+  if (endPos < 0)
+    return false;
+  fileSize = static_cast<size_t>(endPos);
+  in.seekg(0, std::ios::beg);
+
+  contents_.reset(new char[fileSize + kNumTerminatingChars]);
+  if (!in.read(contents_.get(), static_cast<std::streamsize>(fileSize)))
+  {
+    contents_.reset();
+    return false;
+  }
+
+  data_ = contents_.get();
+  return true;
+}
+
+void FileBuffer::terminate(size_t fileSize)
+{
+  data_[fileSize]     = '\n';
+  data_[fileSize + 1] = '\0';
+  data_[fileSize + 2] = '\0';
+  size_               = fileSize + kNumTerminatingChars;
+}
@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef B2EC33F1_B601_423C_A83A_8FC6920B9B85
+#define B2EC33F1_B601_423C_A83A_8FC6920B9B85
+
+#include <cstddef>
+#include <memory>
+#include <string>
+
+/**
+ * @brief Content of a file in the form the scanner needs it.
+ *
+ * The scanner works in place on a writable buffer that ends with a new line and 2 null characters.
+ * Where supported, the file is mapped copy-on-write instead of being read into a separate buffer,
+ * and the terminating characters go into the zero filled tail of the mapping.
+ * Unless the AST shares the buffer, carriage returns are stripped, like they always were, which copies only files
+ * that have them.
+ * @note The scanner terminates tokens in place, so, a page of the mapping is still copied when it is scanned.
+ * Yet, it is copied only then, there is neither a separate read of the whole file nor a buffer allocated for it.
+ * @warning A mapped file must not be truncated as long as the buffer is alive, reading the buffer can then crash with
+ * SIGBUS. So, a file must not be truncated while it is parsed, or while its AST shares the buffer.
+ */
+class FileBuffer
+{
+public:
+  /**
+   * @param shared true if the AST keeps the buffer to share texts with it, carriage returns are then kept.
+   */
+  FileBuffer(const std::string& filename, bool shared);
+  ~FileBuffer();
+
+  FileBuffer(const FileBuffer&)            = delete;
+  FileBuffer& operator=(const FileBuffer&) = delete;
+
+public:
+  char* data()
+  {
+    return data_;
+  }
+
+  /**
+   * @return Size including the terminating characters, 0 if the file could not be read.
+   */
+  size_t size() const
+  {
+    return size_;
+  }
+
+private:
+  bool mapFile(const std::string& filename, size_t& fileSize);
+  bool readFile(const std::string& filename, size_t& fileSize);
+  void terminate(size_t fileSize);
+
+private:
+  char*                   data_ {nullptr};
+  size_t                  size_ {0};
+  size_t                  mappedSize_ {0};
+  std::unique_ptr<char[]> contents_;
+};
+
+#endif /* B2EC33F1_B601_423C_A83A_8FC6920B9B85 */
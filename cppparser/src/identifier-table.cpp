@@ -0,0 +1,79 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "identifier-table.h"
+
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+namespace cppparser {
+
+static constexpr size_t kMinNumSlots = 16;
+
+void IdentifierTable::add(std::string identifier, IdentifierKind kind, int keywordId)
+{
+  if (kind == IdentifierKind::Name)
+    return;
+
+  // Keeping at least half of the slots empty keeps probe sequences short.
+  if ((numIdentifiers_ + 1) * 2 > slots_.size())
+    grow();
+
+  auto& slot = slots_[findSlot(identifier)];
+  if (slot.kind == IdentifierKind::Name)
+  {
+    slot.identifier = std::move(identifier);
+    ++numIdentifiers_;
+  }
+  else if (slot.kind <= kind)
+  {
+    return;
+  }
+  slot.kind      = kind;
+  slot.keywordId = keywordId;
+}
+
+IdentifierClass IdentifierTable::classify(std::string_view identifier) const
+{
+  if (slots_.empty())
+    return IdentifierClass {IdentifierKind::Name, 0};
+
+  const auto& slot = slots_[findSlot(identifier)];
+  return IdentifierClass {slot.kind, slot.keywordId};
+}
+
+void IdentifierTable::visitAll(
+  const std::function<void(std::string_view identifier, IdentifierClass idClass)>& visitor) const
+{
+  for (const auto& slot : slots_)
+  {
+    if (slot.kind != IdentifierKind::Name)
+      visitor(slot.identifier, IdentifierClass {slot.kind, slot.keywordId});
+  }
+}
+
+size_t IdentifierTable::findSlot(std::string_view identifier) const
+{
+  const auto mask = slots_.size() - 1;
+  for (auto idx = std::hash<std::string_view>()(identifier) & mask;; idx = (idx + 1) & mask)
+  {
+    const auto& slot = slots_[idx];
+    if ((slot.kind == IdentifierKind::Name) || (slot.identifier == identifier))
+      return idx;
+  }
+}
+
+void IdentifierTable::grow()
+{
+  std::vector<Slot> oldSlots(std::max(kMinNumSlots, slots_.size() * 2));
+  slots_.swap(oldSlots);
+
+  for (auto& oldSlot : oldSlots)
+  {
+    if (oldSlot.kind != IdentifierKind::Name)
+      slots_[findSlot(oldSlot.identifier)] = std::move(oldSlot);
+  }
+}
+
+} // namespace cppparser
@@ -0,0 +1,82 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef E5A1DD02_BB6B_4C8D_AAF2_AFC6D89584FF
+#define E5A1DD02_BB6B_4C8D_AAF2_AFC6D89584FF
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace cppparser {
+
+/**
+ * @brief How lexer should treat an identifier.
+ *
+ * Enumerators are in order of precedence, i.e. when an identifier is added as more than one kind,
+ * it is classified as the one that comes first.
+ */
+enum class IdentifierKind : std::uint8_t
+{
+  IgnorableMacro,
+  Macro,
+  ApiDecor,
+  RenamedKeyword,
+  Name
+};
+
+struct IdentifierClass
+{
+  IdentifierKind kind;
+  /**
+   * Token id of the keyword when kind is IdentifierKind::RenamedKeyword.
+   */
+  int keywordId;
+};
+
+/**
+ * @brief Open addressing hash table of all identifiers that need special treatment by lexer.
+ *
+ * Classifying an identifier neither allocates nor needs a null terminated string,
+ * so, lexer can look up the token text right inside the input buffer.
+ */
+class IdentifierTable
+{
+public:
+  /**
+   * @brief Adds an identifier unless it is already there as a kind of higher precedence.
+   *
+   * Like for renamed keywords, the first added one wins when an identifier is added again as the same kind.
+   */
+  void add(std::string identifier, IdentifierKind kind, int keywordId = 0);
+
+  IdentifierClass classify(std::string_view identifier) const;
+
+  /**
+   * @brief Calls @a visitor for every identifier in the table, in no particular order.
+   */
+  void visitAll(const std::function<void(std::string_view identifier, IdentifierClass idClass)>& visitor) const;
+
+private:
+  struct Slot
+  {
+    std::string    identifier;
+    IdentifierKind kind {IdentifierKind::Name};
+    int            keywordId {0};
+  };
+
+  size_t findSlot(std::string_view identifier) const;
+  void   grow();
+
+private:
+  // Size is always a power of 2 and an empty slot has kind IdentifierKind::Name.
+  std::vector<Slot> slots_;
+  size_t            numIdentifiers_ {0};
+};
+
+} // namespace cppparser
+
+#endif /* E5A1DD02_BB6B_4C8D_AAF2_AFC6D89584FF */
@@ -23,8 +23,8 @@ inline MacroDependentCodeEnablement Invert(MacroDependentCodeEnablement enabledC
   return MacroDependentCodeEnablement::kNoInfo;
 }
 
-MacroDefineInfo GetMacroDefineInfo(const std::string& id);
+MacroDefineInfo GetMacroDefineInfo(const cppparser::ParserOptions& options, const std::string& id);
 
-std::optional<int> GetIdValue(const std::string& id);
+std::optional<int> GetIdValue(const cppparser::ParserOptions& options, const std::string& id);
 
 #endif /* EF4ACF9B_9D2E_4947_A8CD_17D2F1A6B363 */
@@ -0,0 +1,86 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef D26D3F8B_4DFB_4498_BA1D_D9D4FC4E1D97
+#define D26D3F8B_4DFB_4498_BA1D_D9D4FC4E1D97
+
+#include <cstddef>
+#include <functional>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+
+#include "cppast/cpp_symbol.h"
+
+#include "identifier-table.h"
+
+namespace cppparser {
+
+/**
+ * @brief Configuration of one CppParser instance.
+ *
+ * Lexer and parser only read it while a stream is being parsed,
+ * so, different instances can be used on different threads at the same time.
+ */
+struct ParserOptions
+{
+  using ErrorHandler =
+    std::function<void(const char* errLineText, size_t lineNum, size_t errorStartPos, int lexerContext)>;
+
+  std::map<std::string, int> definedNames;
+  std::set<std::string>      undefinedNames;
+
+  /**
+   * Known macros, ignorable macros, API decorations, and renamed keywords.
+   */
+  IdentifierTable identifiers;
+
+  bool parseEnumBodyAsBlob     = false;
+  bool parseFunctionBodyAsBlob = false;
+
+  /**
+   * When set, only the text of function bodies is recorded and it is parsed on first access of the definition.
+   * It has no effect when parseFunctionBodyAsBlob is set.
+   */
+  bool parseFunctionBodyLazily = false;
+
+  /**
+   * When set, entities of a parsed file are allocated from an arena owned by the file level compound,
+   * and those of a lazily parsed body from an arena owned by its block.
+   */
+  bool allocateEntitiesFromArena = false;
+
+  /**
+   * Size of the first block of the arena of a lazily parsed body, it is small because many bodies are small.
+   */
+  static constexpr std::size_t kBodyArenaSize = 1024;
+
+  /**
+   * When set, texts of blobs, documentation comments, and macro definitions are views into the source buffer.
+   */
+  bool shareSourceBuffer = false;
+
+  /**
+   * Names of entities of all files parsed with these options, or with a copy of them, are interned in this table.
+   * When it is empty, each file is interned in a table of its own.
+   */
+  std::shared_ptr<cppast::CppSymbolTable> symbolTable;
+
+  /**
+   * Default error handler is used when it is empty.
+   */
+  ErrorHandler errorHandler;
+
+  /**
+   * @return true if lexer should return function bodies as blob, which it does for lazy parsing too.
+   */
+  bool skipFunctionBody() const
+  {
+    return parseFunctionBodyAsBlob || parseFunctionBodyLazily;
+  }
+};
+
+} // namespace cppparser
+
+#endif /* D26D3F8B_4DFB_4498_BA1D_D9D4FC4E1D97 */
@@ -8,16 +8,20 @@
 #ifndef BD166B6E_821D_49A3_9593_70C58C59558D
 #define BD166B6E_821D_49A3_9593_70C58C59558D
 
-#include <functional>
-
 #include "cppast/cppast.h"
+#include "parser-options.h"
 
-using ErrorHandler =
-  std::function<void(const char* errLineText, size_t lineNum, size_t errorStartPos, int lexerContext)>;
-
-void SetErrorHandler(ErrorHandler errorHandler);
-void ResetErrorHandler();
-
-std::unique_ptr<cppast::CppCompound> ParseStream(char* stm, size_t stmSize);
+/**
+ * @brief Parses the given stream using the given options.
+ * @param sharedStm Buffer with same content as @a stm that the texts shared with the AST should refer to.
+ * It is used when @a stm is a transient copy, nullptr means the texts refer to @a stm itself.
+ * @note All lexer and parser state lives in thread local storage,
+ * so, it is safe to call it concurrently from different threads.
+ */
+std::unique_ptr<cppast::CppCompound> ParseStream(char*                           stm,
+                                                 size_t                          stmSize,
+                                                 const cppparser::ParserOptions& options,
+                                                 const char*                     sharedStm     = nullptr,
+                                                 size_t                          sharedStmSize = 0);
 
 #endif /* BD166B6E_821D_49A3_9593_70C58C59558D */
@@ -7,6 +7,7 @@
 #include "cpp_entity_builders.h"
 #include "cpptoken.h"
 #include "optional.h"
+#include "parser-options.h"
 #include "parser.tab.h"
 
 #include <functional>
@@ -68,9 +69,21 @@ struct LexerData
   int mLexLog = 0;
   int mLineNo = 1;
 
+  /**
+   * Options of the CppParser whose parsing is in progress.
+   */
+  const cppparser::ParserOptions* mOptions = nullptr;
+
   const char* mInputBuffer     = nullptr;
   size_t      mInputBufferSize = 0;
 
+  /**
+   * Buffer that texts shared with the AST refer to.
+   * It has same content as mInputBuffer but it can be different from it when the scanned buffer is a transient copy.
+   */
+  const char* mSharedBuffer     = nullptr;
+  size_t      mSharedBufferSize = 0;
+
   const char* mOldYytext = nullptr;
 
   //@{ Flags to parse enum body as a blob
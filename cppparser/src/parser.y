@@ -20,6 +20,7 @@
 #include "cppast/cppast.h"
 #include "optional.h"
 #include "parser.tab.h"
+#include "parser.h"
 #include "parser.l.h"
 #include "utils.h"
 
@@ -27,6 +28,7 @@
 
 #include <cstdio>
 #include <iostream>
+#include <stdexcept>
 #include <unordered_map>
 #include <stack>
 #include <vector>
@@ -41,14 +43,11 @@
 
 #define YYERROR_DETAILED
 
-#define YYDELETEPOSN(x, y)
-#define YYDELETEVAL(x, y)
-
 #ifndef TRUE // Need this to fix BtYacc compilation error.
 #  define TRUE true
 #endif
 
-static int gParseLog = 0;
+static thread_local int gParseLog = 0;
 
 #define ZZLOG               \
   {                         \
@@ -56,7 +55,7 @@ static int gParseLog = 0;
     printf("ZZLOG @line#%d, parsing stream line#%d\n", __LINE__, g.mLineNo); \
 }
 
-static int gDisableYyValid = 0;
+static thread_local int gDisableYyValid = 0;
 
 #define ZZVALID   {         \
   if (gParseLog)                 \
@@ -82,10 +81,12 @@ static int gDisableYyValid = 0;
 
 
 /** {Globals} */
+// All globals are thread local so that different threads can parse different streams at the same time.
+
 /**
  * A program unit is the entire parse tree of a source/header file
  */
-static cppast::CppCompound*  gProgUnit;
+static thread_local cppast::CppCompound*  gProgUnit;
 
 // FuncdeclHack:
 // Following gets parsed as variable with initialization:
@@ -100,20 +101,36 @@ static cppast::CppCompound*  gProgUnit;
 // the same operator in other expression production rule before accepting that as valid expression.
 // For us we always want to parse it as function declaration rather than call to constructor by passing an expression,
 // and so the hack is expected to serve us well.
-static const char* gParamModPos = nullptr;
+static thread_local const char* gParamModPos = nullptr;
 
 // TemplateParamHack:
 // Template parameter gets parsed as vardecl which then gets reduced as templateparam without name as used in forward declaration.
 // We don't want that, so to avoid such templateparam getting reduced as vardecl we apply some hack.
-static const char* gTemplateParamStart = nullptr;
-static bool gInTemplateSpec = false;
+static thread_local const char* gTemplateParamStart = nullptr;
+static thread_local bool gInTemplateSpec = false;
 
 /**
  * A stack to know where (i.e. how deep inside class defnition) the current parsing activity is taking place.
  */
 using CppCompoundStack = std::stack<CppToken>;
 
-static CppCompoundStack                     gCompoundStack;
+static thread_local CppCompoundStack        gCompoundStack;
+
+/**
+ * State of lexer, it is defined in parser.l.
+ */
+extern thread_local LexerData g;
+
+/**
+ * Options to lazily parse function bodies with, nullptr when bodies are not parsed lazily.
+ * They are shared by all bodies of the stream being parsed.
+ */
+static thread_local std::shared_ptr<const cppparser::ParserOptions> gFunctionBodyOptions;
+
+/**
+ * Set while a stream is being parsed, another parse on the same thread would corrupt all the above state.
+ */
+static thread_local bool gParsing = false;
 
 /** {End of Globals} */
 
@@ -129,6 +146,94 @@ extern int yylex();
 
 using namespace cppast;
 
+/**
+ * @return Text of token that is either a view into the source buffer or a copy of it depending upon configuration.
+ */
+static cppast::CppText TokenText(const CppToken& token)
+{
+  if (!g.mOptions->shareSourceBuffer)
+    return cppast::CppText(token.toString());
+
+  const auto offset = static_cast<size_t>(token.sz - g.mInputBuffer);
+  if (offset + token.len > g.mSharedBufferSize) // Token extends to the terminating chars that only the scanned buffer has.
+    return cppast::CppText(token.toString());
+  return cppast::CppText(std::string_view(g.mSharedBuffer + offset, token.len));
+}
+
+/**
+ * @brief Parses text of a function body that was recorded for lazy parsing.
+ * @return Block with parsed statements, or with a blob of the whole text if it cannot be parsed.
+ */
+static std::unique_ptr<cppast::CppCompound> ParseFunctionBody(const cppparser::ParserOptions& options,
+                                                              const cppast::CppText&          body)
+{
+  const auto text = body.str();
+  // When the body is not a view, a copy is made for the texts of parsed body to share.
+  std::shared_ptr<const std::string> sharedText;
+  if (options.shareSourceBuffer && !body.isView())
+    sharedText = std::make_shared<const std::string>(text);
+  const char* sharedStm = sharedText ? sharedText->data() : (options.shareSourceBuffer ? text.data() : nullptr);
+
+  std::unique_ptr<char[]> scanBuffer(new char[text.size() + 3]);
+  std::copy(text.begin(), text.end(), scanBuffer.get());
+  scanBuffer[text.size()]     = '\n';
+  scanBuffer[text.size() + 1] = '\0';
+  scanBuffer[text.size() + 2] = '\0';
+
+  // Body is parsed as a file whose entities are then moved to the block, so, the block owns the arena.
+  auto arena = options.allocateEntitiesFromArena
+                 ? std::make_unique<cppast::CppEntityArena>(cppparser::ParserOptions::kBodyArenaSize)
+                 : nullptr;
+  std::unique_ptr<cppast::CppCompound> ast;
+  {
+    std::optional<cppast::CppEntityArena::Scope> arenaScope;
+    if (arena)
+      arenaScope.emplace(*arena);
+    ast = ParseStream(scanBuffer.get(), text.size() + 3, options, sharedStm, text.size());
+  }
+
+  auto defn = std::make_unique<cppast::CppCompound>(CppCompoundType::BLOCK);
+  if (ast)
+    defn->adoptEntitiesOf(*ast);
+  else
+    defn->add(std::make_unique<cppast::CppBlob>(body));
+  if (sharedText)
+    defn->sourceBuffer(std::move(sharedText));
+  if (arena)
+    defn->arena(std::move(arena));
+  defn->symbolTable(options.symbolTable);
+
+  return defn;
+}
+
+/**
+ * @return Definition made of a parsed block, which is left for lazy parsing if it is just a body recorded for that.
+ */
+static cppast::CppLazyCompound Defn(cppast::CppCompound* block)
+{
+  std::unique_ptr<cppast::CppCompound> defn(block ? block : new cppast::CppCompound(CppCompoundType::BLOCK));
+  if (!gFunctionBodyOptions)
+    return defn;
+
+  const cppast::CppBlob* body     = nullptr;
+  size_t                 numItems = 0;
+  defn->visitAll([&](const cppast::CppEntity& entity) {
+    body = (entity.entityType() == cppast::CppEntityType::BLOB) ? static_cast<const cppast::CppBlob*>(&entity)
+                                                                : nullptr;
+    return ++numItems == 1;
+  });
+  if ((numItems != 1) || !body)
+    return defn;
+
+  const auto text = body->blob();
+  const auto isView = g.mOptions->shareSourceBuffer && (text.data() >= g.mSharedBuffer)
+                      && (text.data() < g.mSharedBuffer + g.mSharedBufferSize);
+  return cppast::CppLazyCompound(
+    [options = gFunctionBodyOptions, text = isView ? cppast::CppText(text) : cppast::CppText(std::string(text))]() {
+      return ParseFunctionBody(*options, text);
+    });
+}
+
 // FIXME: Improve template arg parsing.
 // Template argument needs more robust support.
 // As of now we are treating them just as string.
@@ -148,7 +253,7 @@ class CppTemplateArg;
   cppast::CppVar*                                  cppVarObj;
   cppast::CppEnum*                                 cppEnum;
   cppast::CppEnumItem*                             enumItem;
-  std::list<cppast::CppEnumItem>*                  enumItemList;
+  cppast::CppEnumItemList*                         enumItemList;
   cppast::CppTypedefName*                          typedefName;
   cppast::CppTypedefList*                          typedefList;
   cppast::CppUsingDecl*                            usingDecl;
@@ -172,7 +277,7 @@ class CppTemplateArg;
   cppast::CppDestructor*                           cppDtorObj;
   cppast::CppTypeConverter*                        cppTypeConverter;
   cppast::CppMemberInits*                          memInitList;
-  std::list<cppast::CppInheritanceInfo>*           inheritList;
+  cppast::CppInheritanceList*                      inheritList;
   bool                                             inheritType;
   std::vector<std::string>*                        identifierList;
   std::vector<std::string>*                        funcThrowSpec;
@@ -332,6 +437,25 @@ class CppTemplateArg;
 
 %type  <label>              label
 
+/*
+Values that are discarded by the parser, when it pops the stack to recover from error or when it aborts, are deleted
+by these destructors. They are not called for values of trial parse because those are not real values.
+Positions are not needed to delete values, the first destructor refers to pos only to keep yydestruct() free of
+unused parameter warning.
+*/
+%destructor { (void) pos; delete $$; } <memInit>
+%destructor { delete $$; } <cppEntity> <accessSpecifier> <cppVarType> <cppVarObj> <cppEnum> <enumItem>
+%destructor { delete $$; } <enumItemList> <typedefName> <typedefList> <usingDecl> <usingNamespaceDecl>
+%destructor { delete $$; } <namespaceAlias> <cppCompundObj> <templateParam> <templateParamList> <docCommentObj>
+%destructor { delete $$; } <fwdDeclObj> <cppVarObjList> <unRecogPreProObj> <cppExprObj> <exprList> <cppLambda>
+%destructor { delete $$; } <cppFuncObj> <cppFuncPointerObj> <varOrFuncPtr> <paramList> <cppCtorObj> <cppDtorObj>
+%destructor { delete $$; } <cppTypeConverter> <memInitList> <inheritList> <identifierList> <funcThrowSpec>
+%destructor { delete $$; } <asmBlock> <attribSpecifier> <attribSpecifiers> <ifBlock> <whileBlock> <doWhileBlock>
+%destructor { delete $$; } <forBlock> <forRangeBlock> <switchBlock> <switchBody> <tryBlock> <catchBlock>
+%destructor { delete $$; } <hashDefine> <hashUndef> <hashInclude> <hashImport> <hashIf> <hashError> <hashWarning>
+%destructor { delete $$; } <hashPragma> <returnStmt> <throwStmt> <gotoStmt> <blob> <label> <cppVarInitInfo>
+%destructor { delete $$.paramList; } <funcDeclData>
+
 // precedence as mentioned at https://en.cppreference.com/w/cpp/language/operator_precedence
 %left COMMA
 // &=, ^=, |=, <<=, >>=, *=, /=, %=, +=, -=, =, throw, a?b:c
@@ -502,8 +626,7 @@ macrocall
   | macrocall '(' expr ')' [
     ZZLOG;
     $$ = MergeCppToken($1, $4);
-    delete $3;
-  ] {}
+  ] { delete $3; }
   ;
 
 switchstmt
@@ -537,6 +660,7 @@ block
       $$->compoundType(CppCompoundType::BLOCK);
   }
   | doccomment block [ZZLOG;] {
+    delete $1;
     $$ = $2;
   }
   ;
@@ -620,22 +744,22 @@ optexpr
 
 define
   : tknPreProHash tknDefine name name [ZZLOG;] {
-    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::RENAME, $3, $4);
+    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::RENAME, $3, TokenText($4));
   }
   | tknPreProHash tknDefine name [ZZLOG;] {
     $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::RENAME, $3);
   }
   | tknPreProHash tknDefine name tknNumber [ZZLOG;] {
-    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::NUMBER, $3, $4);
+    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::NUMBER, $3, TokenText($4));
   }
   | tknPreProHash tknDefine name tknStrLit [ZZLOG;] {
-    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::STRING, $3, $4);
+    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::STRING, $3, TokenText($4));
   }
   | tknPreProHash tknDefine name tknCharLit [ZZLOG;] {
-    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::CHARACTER, $3, $4);
+    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::CHARACTER, $3, TokenText($4));
   }
   | tknPreProHash tknDefine name tknPreProDef [ZZLOG;] {
-    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::COMPLEX_DEFN, $3, $4);
+    $$ = new cppast::CppPreprocessorDefine(cppast::CppPreprocessorDefineType::COMPLEX_DEFN, $3, TokenText($4));
   }
   ;
 
@@ -678,7 +802,7 @@ pragma
   ;
 
 doccomment
-  : doccommentstr                               [ZZLOG;]  { $$ = new cppast::CppDocumentationComment((std::string) $1); }
+  : doccommentstr                               [ZZLOG;]  { $$ = new cppast::CppDocumentationComment(TokenText($1)); }
   ;
 
 optdoccommentstr
@@ -739,11 +863,11 @@ templidentifier
   : identifier tknLT templatearglist tknGT    [ZZLOG; $$ = MergeCppToken($1, $4); ] {}
 // The following rule is needed to parse an ambiguous input as template identifier,
 // see the test "vardecl-or-expr-ambiguity".
-  | identifier tknLT expr tknNotEq expr tknGT [ZZLOG; $$ = MergeCppToken($1, $6); ] {}
+  | identifier tknLT expr tknNotEq expr tknGT [ZZLOG; $$ = MergeCppToken($1, $6); ] { delete $3; delete $5; }
 // The following rule is needed to parse a template identifier which otherwise fails to parse
 // because of higher precedence of tknLT and tknGT,
 // see the test "C<Class, v != 0> x;".
-  | identifier tknLT templatearglist ',' expr tknNotEq expr tknGT [ZZLOG; $$ = MergeCppToken($1, $8); ] {}
+  | identifier tknLT templatearglist ',' expr tknNotEq expr tknGT [ZZLOG; $$ = MergeCppToken($1, $8); ] { delete $5; delete $7; }
   ;
 
 templqualifiedid
@@ -781,17 +905,17 @@ enumitem
   ;
 
 blob
-  : tknBlob      [ZZLOG;]   { $$ = new cppast::CppBlob($1); }
+  : tknBlob      [ZZLOG;]   { $$ = new cppast::CppBlob(TokenText($1)); }
   ;
 
 enumitemlist
   :                           [ZZLOG;] { $$ = 0; }
   | enumitemlist enumitem [ZZLOG;] {
-    $$ = $1 ? $1 : new std::list<cppast::CppEnumItem>;
+    $$ = $1 ? $1 : new cppast::CppEnumItemList;
     $$->push_back(Obj($2));
   }
   | enumitemlist ',' enumitem [ZZLOG;] {
-    $$ = $1 ? $1 : new std::list<cppast::CppEnumItem>;
+    $$ = $1 ? $1 : new cppast::CppEnumItemList;
     $$->push_back(Obj($3));
   }
   | enumitemlist ',' [ZZLOG;] {
@@ -932,6 +1056,7 @@ vardecllist
   | optfunctype vardecl ',' opttypemodifier name ':' expr [ZZLOG;] {
     $2->addAttr($1);
     $$ = new cppast::CppVarList($2, CppVarDeclInList($4, CppVarDecl{$5}));
+    delete $7;
     /* TODO: Use optvarassign as well */
   }
   | vardecllist ',' opttypemodifier name optvarassign [ZZLOG;] {
@@ -941,6 +1066,7 @@ vardecllist
   | vardecllist ',' opttypemodifier name optvarassign ':' expr [ZZLOG;] {
     $$ = $1;
     $$->addVarDecl(CppVarDeclInList($3, VarDecl($4, $5)));
+    delete $7;
     /* TODO: Use optvarassign as well */
   }
   ;
@@ -1079,7 +1205,7 @@ varidentifier
 opttypemodifier
   : [ZZLOG;] { $$ = CppTypeModifier(); }
   | typemodifier { $$ = $1; }
-  | doccomment opttypemodifier { $$ = $2; }
+  | doccomment opttypemodifier { delete $1; $$ = $2; }
   ;
 
 typemodifier
@@ -1163,7 +1289,7 @@ typeconverterstmt
   }
   | typeconverter block [ZZVALID;] {
     $$ = $1;
-    $$->defn(Ptr($2));
+    $$->defn(Defn($2));
   }
   ;
 
@@ -1174,16 +1300,16 @@ funcdeclstmt
 funcdefn
   : funcdecl block [ZZVALID;] {
     $$ = $1;
-    $$->defn(Ptr($2 ? $2 : new cppast::CppCompound(CppCompoundType::BLOCK)));
+    $$->defn(Defn($2));
   }
   ;
 
 lambda
   : '[' lambdacapture ']' lambdaparams block {
-    $$ = new cppast::CppLambda(Ptr($2), Obj($4), Ptr($5));
+    $$ = new cppast::CppLambda(Ptr($2), Obj($4), Defn($5));
   }
   | '[' lambdacapture ']' lambdaparams tknArrow vartype block {
-    $$ = new cppast::CppLambda(Ptr($2), Obj($4), Ptr($7), Ptr($6));
+    $$ = new cppast::CppLambda(Ptr($2), Obj($4), Defn($7), Ptr($6));
   }
   ;
 
@@ -1230,6 +1356,7 @@ functionpointer
       ZZERROR;
     }
   ]
+  { $$ = $1; }
   ;
 
 functionptrtype
@@ -1239,6 +1366,7 @@ functionptrtype
       ZZERROR;
     }
   ]
+  { $$ = $1; }
   ;
 
 funcobj
@@ -1414,7 +1542,7 @@ param
     $$ = var;
   }
   | funcptrortype                   [ZZLOG;] { $$ = $1; $1->addAttr(FUNC_PARAM); }
-  | doccomment param                [ZZLOG;] { $$ = $2; }
+  | doccomment param                [ZZLOG;] { delete $1; $$ = $2; }
   | vartype '[' expr ']' [ZZLOG;] {
     auto var = new cppast::CppVar($1, std::string());
     var->addAttr(FUNC_PARAM);
@@ -1431,15 +1559,15 @@ param
 
 templatearg
   :                 [ZZLOG; $$ = nullptr;] { /*$$ = MakeCppToken(nullptr, nullptr);*/ }
-  | vartype         [ZZLOG; $$ = nullptr;] { /*$$ = MergeCppToken($1, $2);*/ }
+  | vartype         [ZZLOG; $$ = nullptr;] { delete $1; /*$$ = MergeCppToken($1, $2);*/ }
   | funcobjstr      [ZZLOG; $$ = nullptr;] { /*$$ = $1;*/ }
-  | expr            [ZZLOG; $$ = nullptr;] {}
+  | expr            [ZZLOG; $$ = nullptr;] { delete $1; }
   ;
 
 templatearglist
   : templatearg                      [ZZLOG; $$ = $1; ] {}
   | templatearglist ',' templatearg   [ZZLOG; $$ = $1;] { /*$$ = MergeCppToken($1, $3);*/ }
-  | templatearglist ',' doccomment templatearg   [ZZLOG; $$ = $1;] { /*$$ = MergeCppToken($1, $3);*/ }
+  | templatearglist ',' doccomment templatearg   [ZZLOG; $$ = $1;] { delete $3; /*$$ = MergeCppToken($1, $3);*/ }
   ;
 
 functype
@@ -1507,27 +1635,27 @@ ctordefn
   {
     $$ = $1;
     $$->memberInits(Obj($2));
-    $$->defn(Ptr($3));
+    $$->defn(Defn($3));
   }
   | name tknScopeResOp name [if($1 != $3) ZZERROR; else ZZVALID;]
                     '(' paramlist ')' optfuncthrowspec meminitlist block [ZZVALID;]
   {
     $$ = new cppast::CppConstructor(MergeCppToken($1, $3), Obj($6), Obj($9), 0);
-    $$->defn(Ptr($10));
+    $$->defn(Defn($10));
     $$->throwSpec(Obj($8));
   }
   | identifier tknScopeResOp name tknScopeResOp name [if($3 != $5) ZZERROR; else ZZVALID;]
                     '(' paramlist ')' optfuncthrowspec meminitlist block [ZZVALID;]
   {
     $$ = new cppast::CppConstructor(MergeCppToken($1, $5), Obj($8), Obj($11), 0);
-    $$->defn(Ptr($12));
+    $$->defn(Defn($12));
     $$->throwSpec(Obj($10));
   }
   | name tknLT templatearglist tknGT tknScopeResOp name [if($1 != $6) ZZERROR; else ZZVALID;]
                     '(' paramlist ')' optfuncthrowspec meminitlist block [ZZVALID;]
   {
     $$ = new cppast::CppConstructor(MergeCppToken($1, $6), Obj($9), Obj($12), 0);
-    $$->defn(Ptr($13));
+    $$->defn(Defn($13));
     $$->throwSpec(Obj($11));
   }
   | functype ctordefn [ZZLOG;] {
@@ -1613,22 +1741,22 @@ dtordefn
   : dtordecl block  [ZZVALID;]
   {
     $$ = $1;
-    $$->defn(Ptr($2 ? $2 : new cppast::CppCompound(CppCompoundType::BLOCK)));
+    $$->defn(Defn($2));
   }
   | name tknScopeResOp '~' name [if($1 != $4) ZZERROR; else ZZVALID;] '(' ')' block
   {
     $$ = new cppast::CppDestructor(MergeCppToken($1, $4), 0);
-    $$->defn(Ptr($8 ? $8 : new cppast::CppCompound(CppCompoundType::BLOCK)));
+    $$->defn(Defn($8));
   }
   | identifier tknScopeResOp name tknScopeResOp '~' name [if($3 != $6) ZZERROR; else ZZVALID;] '(' ')' block
   {
     $$ = new cppast::CppDestructor(MergeCppToken($1, $6), 0);
-    $$->defn(Ptr($10 ? $10 : new cppast::CppCompound(CppCompoundType::BLOCK)));
+    $$->defn(Defn($10));
   }
   | name tknLT templatearglist tknGT tknScopeResOp '~' name [if($1 != $7) ZZERROR; else ZZVALID;] '(' ')' block
   {
     $$ = new cppast::CppDestructor(MergeCppToken($1, $7), 0);
-    $$->defn(Ptr($11 ? $11 : new cppast::CppCompound(CppCompoundType::BLOCK)));
+    $$->defn(Defn($11));
   }
   | templatespecifier dtordefn [ZZLOG;] {
     $$ = $2;
@@ -1696,6 +1824,7 @@ optcomment
   :            [ZZLOG;]{
   }
   | doccomment [ZZVALID;] {
+    delete $1;
   }
   ;
 
@@ -1789,16 +1918,16 @@ optfinal
 
 optinheritlist
   : [ZZLOG;] {
-    $$ = new std::list<CppInheritanceInfo>;
+    $$ = new cppast::CppInheritanceList;
   }
   | ':' protlevel optinherittype typeidentifier [ZZVALID;] {
-    $$ = new std::list<CppInheritanceInfo>; $$->push_back({(std::string) $4, $2, $3});
+    $$ = new cppast::CppInheritanceList; $$->push_back({(std::string) $4, $2, $3});
   }
   | optinheritlist ',' protlevel optinherittype typeidentifier [ZZVALID;] {
     $$ = $1; $$->push_back({(std::string) $5, $3, $4});
   }
   | ':' optinherittype protlevel typeidentifier [ZZVALID;] {
-    $$ = new std::list<CppInheritanceInfo>; $$->push_back({(std::string) $4, $3, $2});
+    $$ = new cppast::CppInheritanceList; $$->push_back({(std::string) $4, $3, $2});
   }
   | optinheritlist ',' optinherittype protlevel typeidentifier [ZZVALID;] {
     $$ = $1; $$->push_back({(std::string) $5, $4, $3});
@@ -2065,8 +2194,8 @@ expr
   | tknNumber name                                        [ZZLOG;] { $$ = BinomialExpr(cppast::CppBinaryOperator::USER_LITERAL, NumberLiteralExpr($1), NameExpr($2)); }
   /* Objective C expressions */
   /* This will need improvements, as of now the aim is just to mainly parse C++ content. */
-  | '[' expr expr ']'                                     [ZZLOG;] { $$ = $2; }
-  | '[' expr objcarglist ']'                              [ZZLOG;] { $$ = $2; }
+  | '[' expr expr ']'                                     [ZZLOG;] { delete $3; $$ = $2; }
+  | '[' expr objcarglist ']'                              [ZZLOG;] { delete $3; $$ = $2; }
   ;
 
 objcarg
@@ -2075,7 +2204,7 @@ objcarg
 
 objcarglist
   : objcarg { $$ = $1; }
-  | objcarglist objcarg { $$ = $1; }
+  | objcarglist objcarg { delete $2; $$ = $1; }
   ;
 
 exprlist
@@ -2123,9 +2252,9 @@ captureallbyval
   ;
 
 lambdacapture
-  : optexprlist        [ZZLOG;] { $$ = nullptr; }
-  | captureallbyref    [ZZLOG;] { $$ = nullptr; }
-  | captureallbyval    [ZZLOG;] { $$ = nullptr; }
+  : optexprlist        [ZZLOG;] { delete $1; $$ = nullptr; }
+  | captureallbyref    [ZZLOG;] { delete $1; $$ = nullptr; }
+  | captureallbyval    [ZZLOG;] { delete $1; $$ = nullptr; }
   ;
 
 exprstmt
@@ -2152,10 +2281,6 @@ gotostmt
 
 // clang-format on
 
-#include "parser.h"
-
-  extern LexerData g;
-
 extern const char* contextNameFromState(int ctx);
 
 enum class ParseStatus
@@ -2165,7 +2290,7 @@ enum class ParseStatus
   Failure
 };
 
-ParseStatus gParseStatus = ParseStatus::NotAvailable;
+static thread_local ParseStatus gParseStatus = ParseStatus::NotAvailable;
 
 void defaultErrorHandler(const char* errLineText, size_t lineNum, size_t errorStartPos, int lexerContext)
 {
@@ -2195,8 +2320,6 @@ void defaultErrorHandler(const char* errLineText, size_t lineNum, size_t errorSt
   printf("%s", errmsg);
 }
 
-ErrorHandler gErrorHandler = defaultErrorHandler;
-
 /**
  * yyparser() invokes this function when it encounters unexpected token.
  */
@@ -2226,8 +2349,9 @@ void yyerror_detailed(char* text, int errt, YYSTYPE& errt_value, YYPOSN& errt_po
       ++lineEnd;
     }
   }
-  gParseStatus = ParseStatus::Failure;
-  gErrorHandler(lineStart, g.mLineNo, errt_posn - lineStart, getLexerContext());
+  gParseStatus             = ParseStatus::Failure;
+  const auto& errorHandler = g.mOptions->errorHandler ? g.mOptions->errorHandler : defaultErrorHandler;
+  errorHandler(lineStart, g.mLineNo, errt_posn - lineStart, getLexerContext());
   // Replace back the end char
   if (endReplaceChar)
     *lineEnd = endReplaceChar;
@@ -2256,16 +2380,6 @@ static void setupEnv()
 #endif
 }
 
-void SetErrorHandler(ErrorHandler errorHandler)
-{
-  gErrorHandler = errorHandler;
-}
-
-void ResetErrorHandler()
-{
-  gErrorHandler = defaultErrorHandler;
-}
-
 int GetKeywordId(const std::string& keyword)
 {
   static const std::unordered_map<std::string, int> keywordToIdMap = {{"virtual", tknVirtual},
@@ -2299,26 +2413,82 @@ int GetKeywordId(const std::string& keyword)
   return (itr != keywordToIdMap.end()) ? itr->second : -1;
 }
 
-std::unique_ptr<CppCompound> ParseStream(char* stm, size_t stmSize)
+std::unique_ptr<CppCompound> ParseStream(char*                           stm,
+                                         size_t                          stmSize,
+                                         const cppparser::ParserOptions& options,
+                                         const char*                     sharedStm,
+                                         size_t                          sharedStmSize)
 {
+  // E.g. an error handler that accesses the definition of a lazily parsed function.
+  if (gParsing)
+    throw std::logic_error("A stream cannot be parsed while another one is being parsed on the same thread");
+  gParsing = true;
+  struct ParsingReset
+  {
+    ~ParsingReset()
+    {
+      gParsing = false;
+    }
+  } parsingReset;
+
   gProgUnit = nullptr;
 
-  void setupScanBuffer(char* buf, size_t bufsize);
+  void setupScanBuffer(char* buf, size_t bufsize, const cppparser::ParserOptions& options);
   void cleanupScanBuffer();
-  setupScanBuffer(stm, stmSize);
+  setupScanBuffer(stm, stmSize, options);
+  if (sharedStm)
+  {
+    g.mSharedBuffer     = sharedStm;
+    g.mSharedBufferSize = sharedStmSize;
+  }
   setupEnv();
   gTemplateParamStart = nullptr;
   gParamModPos        = nullptr;
   gInTemplateSpec     = false;
   gDisableYyValid     = 0;
   gParseStatus        = ParseStatus::NotAvailable;
-  yyparse();
+
+  // Without a table of the caller, names of a file are interned in a table that only its AST keeps alive.
+  auto symbolTable = options.symbolTable ? options.symbolTable : std::make_shared<CppSymbolTable>();
+
+  gFunctionBodyOptions = nullptr;
+  if (options.parseFunctionBodyLazily && !options.parseFunctionBodyAsBlob)
+  {
+    auto bodyOptions                     = std::make_shared<cppparser::ParserOptions>(options);
+    bodyOptions->parseFunctionBodyLazily = false;
+    bodyOptions->symbolTable             = symbolTable;
+    gFunctionBodyOptions                 = std::move(bodyOptions);
+  }
+
+  // Arena is not needed when the caller already has one, e.g. for a lazily parsed body, whose block owns it.
+  auto arena = (options.allocateEntitiesFromArena && !CppEntityArena::current()) ? std::make_unique<CppEntityArena>()
+                                                                                  : nullptr;
+  {
+    std::optional<CppEntityArena::Scope> arenaScope;
+    if (arena)
+      arenaScope.emplace(*arena);
+    CppSymbolTable::Scope symbolTableScope(*symbolTable);
+    yyparse();
+  }
   cleanupScanBuffer();
+  gFunctionBodyOptions = nullptr;
   CppCompoundStack tmpStack;
   gCompoundStack.swap(tmpStack);
 
   std::unique_ptr<CppCompound> ret(gProgUnit);
   gProgUnit = nullptr;
 
+  if (ret && arena)
+  {
+    // File level compound owns the arena and so it cannot itself live in the arena.
+    auto fileAst = std::make_unique<CppCompound>(CppCompoundType::FILE);
+    fileAst->adoptEntitiesOf(*ret);
+    ret.reset();
+    fileAst->arena(std::move(arena));
+    ret = std::move(fileAst);
+  }
+  if (ret)
+    ret->symbolTable(std::move(symbolTable));
+
   return ret;
 }
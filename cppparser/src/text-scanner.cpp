@@ -0,0 +1,262 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "text-scanner.h"
+
+#include <bitset>
+#include <cassert>
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#  define TEXT_SCANNER_X86 1
+#  include <immintrin.h>
+#  if defined(_MSC_VER)
+#    include <intrin.h>
+#  endif
+#else
+#  define TEXT_SCANNER_X86 0
+#endif
+
+#if defined(__GNUC__)
+#  define TEXT_SCANNER_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#  define TEXT_SCANNER_TARGET_AVX2
+#endif
+
+namespace {
+
+constexpr size_t kMaxStopChars = 4;
+
+/**
+ * Stop characters including '\0' that terminates the buffer.
+ */
+struct StopChars
+{
+  char   chars[kMaxStopChars + 1];
+  size_t count;
+};
+
+StopChars MakeStopChars(std::string_view stopChars)
+{
+  assert(stopChars.size() <= kMaxStopChars);
+
+  StopChars ret {{'\0'}, 1};
+  for (const auto c : stopChars)
+    ret.chars[ret.count++] = c;
+
+  return ret;
+}
+
+inline size_t CountBits(std::uint32_t mask)
+{
+  return std::bitset<32>(mask).count();
+}
+
+inline unsigned LowestBitIndex(std::uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanForward(&idx, mask);
+  return idx;
+#else
+  return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+inline unsigned HighestBitIndex(std::uint32_t mask)
+{
+#if defined(_MSC_VER)
+  unsigned long idx;
+  _BitScanReverse(&idx, mask);
+  return idx;
+#else
+  return 31U - static_cast<unsigned>(__builtin_clz(mask));
+#endif
+}
+
+ScanResult ScanTillScalar(const char* p, const char* lastLineFeed, size_t numNewLines, const StopChars& stopChars)
+{
+  for (;; ++p)
+  {
+    const auto c = *p;
+    for (size_t i = 0; i < stopChars.count; ++i)
+    {
+      if (c == stopChars.chars[i])
+        return ScanResult {p, lastLineFeed, numNewLines};
+    }
+    if (c == '\n')
+    {
+      lastLineFeed = p;
+      ++numNewLines;
+    }
+    else if ((c == '\r') && (p[1] != '\n'))
+    {
+      ++numNewLines;
+    }
+  }
+}
+
+/**
+ * Accounts new lines of a block before its first stop character.
+ * @return true if the block has a stop character.
+ */
+inline bool ScanBlock(const char*   block,
+                      std::uint32_t stops,
+                      std::uint32_t lineFeeds,
+                      std::uint32_t loneCarriageReturns,
+                      ScanResult&   result)
+{
+  if (stops)
+  {
+    const auto stopIdx = LowestBitIndex(stops);
+    const auto before  = (std::uint32_t(1) << stopIdx) - 1;
+    lineFeeds &= before;
+    loneCarriageReturns &= before;
+    result.stop = block + stopIdx;
+  }
+  result.numNewLines += CountBits(lineFeeds) + CountBits(loneCarriageReturns);
+  if (lineFeeds)
+    result.lastLineFeed = block + HighestBitIndex(lineFeeds);
+
+  return stops != 0;
+}
+
+#if TEXT_SCANNER_X86
+
+ScanResult ScanTillSse2(const char* begin, const char* end, const StopChars& stopChars)
+{
+  constexpr std::ptrdiff_t kBlockSize = 16;
+
+  __m128i stopVecs[kMaxStopChars + 1];
+  for (size_t i = 0; i < stopChars.count; ++i)
+    stopVecs[i] = _mm_set1_epi8(stopChars.chars[i]);
+  const auto lineFeed       = _mm_set1_epi8('\n');
+  const auto carriageReturn = _mm_set1_epi8('\r');
+
+  ScanResult result {nullptr, nullptr, 0};
+  auto       p = begin;
+  // A block is compared along with the one starting at next character to find lone '\r'.
+  for (; end - p > kBlockSize; p += kBlockSize)
+  {
+    const auto block     = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    const auto nextBlock = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + 1));
+
+    auto stopMask = _mm_cmpeq_epi8(block, stopVecs[0]);
+    for (size_t i = 1; i < stopChars.count; ++i)
+      stopMask = _mm_or_si128(stopMask, _mm_cmpeq_epi8(block, stopVecs[i]));
+    const auto loneCarriageReturnMask =
+      _mm_andnot_si128(_mm_cmpeq_epi8(nextBlock, lineFeed), _mm_cmpeq_epi8(block, carriageReturn));
+
+    if (ScanBlock(p,
+                  static_cast<std::uint32_t>(_mm_movemask_epi8(stopMask)),
+                  static_cast<std::uint32_t>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, lineFeed))),
+                  static_cast<std::uint32_t>(_mm_movemask_epi8(loneCarriageReturnMask)),
+                  result))
+    {
+      return result;
+    }
+  }
+
+  return ScanTillScalar(p, result.lastLineFeed, result.numNewLines, stopChars);
+}
+
+TEXT_SCANNER_TARGET_AVX2 ScanResult ScanTillAvx2(const char* begin, const char* end, const StopChars& stopChars)
+{
+  constexpr std::ptrdiff_t kBlockSize = 32;
+
+  __m256i stopVecs[kMaxStopChars + 1];
+  for (size_t i = 0; i < stopChars.count; ++i)
+    stopVecs[i] = _mm256_set1_epi8(stopChars.chars[i]);
+  const auto lineFeed       = _mm256_set1_epi8('\n');
+  const auto carriageReturn = _mm256_set1_epi8('\r');
+
+  ScanResult result {nullptr, nullptr, 0};
+  auto       p = begin;
+  // A block is compared along with the one starting at next character to find lone '\r'.
+  for (; end - p > kBlockSize; p += kBlockSize)
+  {
+    const auto block     = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+    const auto nextBlock = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + 1));
+
+    auto stopMask = _mm256_cmpeq_epi8(block, stopVecs[0]);
+    for (size_t i = 1; i < stopChars.count; ++i)
+      stopMask = _mm256_or_si256(stopMask, _mm256_cmpeq_epi8(block, stopVecs[i]));
+    const auto loneCarriageReturnMask =
+      _mm256_andnot_si256(_mm256_cmpeq_epi8(nextBlock, lineFeed), _mm256_cmpeq_epi8(block, carriageReturn));
+
+    if (ScanBlock(p,
+                  static_cast<std::uint32_t>(_mm256_movemask_epi8(stopMask)),
+                  static_cast<std::uint32_t>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, lineFeed))),
+                  static_cast<std::uint32_t>(_mm256_movemask_epi8(loneCarriageReturnMask)),
+                  result))
+    {
+      return result;
+    }
+  }
+
+  return ScanTillScalar(p, result.lastLineFeed, result.numNewLines, stopChars);
+}
+
+bool CpuSupportsAvx2()
+{
+#  if defined(_MSC_VER)
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] < 7)
+    return false;
+  __cpuid(info, 1);
+  const bool osSavesAvxState = (info[2] & (1 << 27)) && (info[2] & (1 << 28)) && ((_xgetbv(0) & 6) == 6);
+  if (!osSavesAvxState)
+    return false;
+  __cpuidex(info, 7, 0);
+  return (info[1] & (1 << 5)) != 0;
+#  else
+  return __builtin_cpu_supports("avx2");
+#  endif
+}
+
+#endif // TEXT_SCANNER_X86
+
+} // namespace
+
+ScannerIsa BestScannerIsa()
+{
+#if TEXT_SCANNER_X86
+  return CpuSupportsAvx2() ? ScannerIsa::Avx2 : ScannerIsa::Sse2;
+#else
+  return ScannerIsa::Scalar;
+#endif
+}
+
+ScanResult ScanTill(const char* begin, const char* end, std::string_view stopChars, ScannerIsa isa)
+{
+  const auto allStopChars = MakeStopChars(stopChars);
+  switch (isa)
+  {
+#if TEXT_SCANNER_X86
+    case ScannerIsa::Avx2:
+      return ScanTillAvx2(begin, end, allStopChars);
+    case ScannerIsa::Sse2:
+      return ScanTillSse2(begin, end, allStopChars);
+#endif
+    default:
+      return ScanTillScalar(begin, nullptr, 0, allStopChars);
+  }
+}
+
+const char* FindMatchedClosingBracket(const char* begin, const char* end, char openingBracket, char closingBracket)
+{
+  const char brackets[] = {openingBracket, closingBracket};
+
+  int numOpenBrackets = 1;
+  for (auto p = begin;; ++p)
+  {
+    p = ScanTill(p, end, std::string_view(brackets, 2)).stop;
+    if (*p == '\0')
+      return p;
+    if (*p == openingBracket)
+      ++numOpenBrackets;
+    else if (--numOpenBrackets == 0)
+      return p;
+  }
+}
@@ -0,0 +1,67 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Vectorized scanning of input buffer that lets lexer skip text which it would otherwise consume character by
+ * character.
+ */
+
+#ifndef C30D91AE_50F7_4BC9_9FAD_52835B2E6009
+#define C30D91AE_50F7_4BC9_9FAD_52835B2E6009
+
+#include <cstddef>
+#include <string_view>
+
+/**
+ * @brief Instruction set used for scanning.
+ */
+enum class ScannerIsa
+{
+  Scalar,
+  Sse2,
+  Avx2
+};
+
+/**
+ * @return The best instruction set that the running CPU supports.
+ */
+ScannerIsa BestScannerIsa();
+
+struct ScanResult
+{
+  /**
+   * The first stop character, or the null character that terminates the buffer.
+   */
+  const char* stop;
+  /**
+   * The last '\n' before stop, nullptr if there is none.
+   */
+  const char* lastLineFeed;
+  /**
+   * Number of new lines before stop, where "\r\n" is one new line and so is a lone '\r'.
+   */
+  size_t numNewLines;
+};
+
+/**
+ * @brief Scans from @a begin till the first character that is either one of @a stopChars or '\0'.
+ * @param end End of the buffer, there must be a '\0' between @a begin and @a end.
+ * @param stopChars At most 4 characters to stop at.
+ */
+ScanResult ScanTill(const char* begin, const char* end, std::string_view stopChars, ScannerIsa isa);
+
+inline ScanResult ScanTill(const char* begin, const char* end, std::string_view stopChars)
+{
+  static const auto isa = BestScannerIsa();
+  return ScanTill(begin, end, stopChars, isa);
+}
+
+/**
+ * @brief Finds the bracket that closes an already opened bracket.
+ * @param begin Start of the text right after the opening bracket.
+ * @param end End of the buffer, there must be a '\0' between @a begin and @a end.
+ * @return The closing bracket, or the null character that terminates the buffer if there is none.
+ */
+const char* FindMatchedClosingBracket(const char* begin, const char* end, char openingBracket, char closingBracket);
+
+#endif /* C30D91AE_50F7_4BC9_9FAD_52835B2E6009 */
@@ -0,0 +1,121 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Compares heap and arena allocation of AST entities while parsing e2e test corpus.
+ *
+ * Usage: cppparserarenabench [input-folder [repetitions]]
+ */
+
+#include "../app/test-parser-config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static size_t gNumAllocations = 0;
+
+void* operator new(std::size_t size)
+{
+  ++gNumAllocations;
+  if (auto* mem = std::malloc(size ? size : 1))
+    return mem;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+static std::vector<std::string> collectFiles(const fs::path& inputFolder)
+{
+  std::vector<std::string> files;
+  for (fs::recursive_directory_iterator dirItr(inputFolder); dirItr != fs::recursive_directory_iterator(); ++dirItr)
+  {
+    if (fs::is_regular_file(*dirItr))
+      files.push_back(dirItr->path().string());
+  }
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+struct BenchResult
+{
+  size_t numAllocations {0};
+  double parseSeconds {0};
+  double freeSeconds {0};
+};
+
+static BenchResult parseAndFree(const cppparser::CppParser& parser, const std::vector<std::string>& files)
+{
+  using Clock = std::chrono::steady_clock;
+
+  std::vector<std::unique_ptr<cppast::CppCompound>> asts;
+  asts.reserve(files.size());
+
+  BenchResult result;
+
+  const auto numAllocationsBefore = gNumAllocations;
+  const auto parseStart           = Clock::now();
+  for (const auto& file : files)
+    asts.push_back(parser.parseFile(file));
+  const auto parseEnd   = Clock::now();
+  result.numAllocations = gNumAllocations - numAllocationsBefore;
+
+  asts.clear();
+  const auto freeEnd = Clock::now();
+
+  result.parseSeconds = std::chrono::duration<double>(parseEnd - parseStart).count();
+  result.freeSeconds  = std::chrono::duration<double>(freeEnd - parseEnd).count();
+
+  return result;
+}
+
+int main(int argc, char** argv)
+{
+  const auto inputFolder =
+    (argc > 1) ? fs::path(argv[1]) : fs::path(__FILE__).parent_path().parent_path() / "e2e" / "test_input";
+  const auto repetitions = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+
+  auto parser = constructCppParserForTest();
+  parser.parseEnumBodyAsBlob();
+  parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+  const auto files = collectFiles(inputFolder);
+  std::printf("Parsing %zu files from %s, best of %d runs\n", files.size(), inputFolder.string().c_str(), repetitions);
+
+  // Warm up file system cache.
+  parseAndFree(parser, files);
+
+  std::printf("%8s %14s %12s %12s\n", "mode", "allocations", "parse(s)", "free(s)");
+  for (const auto fromArena : {false, true})
+  {
+    parser.allocateEntitiesFromArena(fromArena);
+
+    BenchResult best = parseAndFree(parser, files);
+    for (int i = 1; i < repetitions; ++i)
+    {
+      const auto result = parseAndFree(parser, files);
+      best.parseSeconds = std::min(best.parseSeconds, result.parseSeconds);
+      best.freeSeconds  = std::min(best.freeSeconds, result.freeSeconds);
+    }
+    std::printf(
+      "%8s %14zu %12.3f %12.3f\n", fromArena ? "arena" : "heap", best.numAllocations, best.parseSeconds, best.freeSeconds);
+  }
+
+  return 0;
+}
@@ -0,0 +1,85 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Compares parsing of e2e test corpus with loading its ASTs from a warm AST cache.
+ *
+ * Usage: cppparsercachebench [input-folder [repetitions]]
+ */
+
+#include "../app/test-parser-config.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> collectFiles(const fs::path& inputFolder)
+{
+  std::vector<std::string> files;
+  for (fs::recursive_directory_iterator dirItr(inputFolder); dirItr != fs::recursive_directory_iterator(); ++dirItr)
+  {
+    if (fs::is_regular_file(*dirItr))
+      files.push_back(dirItr->path().string());
+  }
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+static double parseAll(const cppparser::CppParser& parser, const std::vector<std::string>& files, size_t& numParsed)
+{
+  using Clock = std::chrono::steady_clock;
+
+  numParsed        = 0;
+  const auto start = Clock::now();
+  for (const auto& file : files)
+  {
+    if (parser.parseFile(file))
+      ++numParsed;
+  }
+
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+  const auto inputFolder =
+    (argc > 1) ? fs::path(argv[1]) : fs::path(__FILE__).parent_path().parent_path() / "e2e" / "test_input";
+  const auto repetitions = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+  const auto cacheDir    = fs::temp_directory_path() / "cppparser-ast-cache-bench";
+
+  auto parser = constructCppParserForTest();
+  parser.parseEnumBodyAsBlob();
+  parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+  const auto files = collectFiles(inputFolder);
+  std::printf("Parsing %zu files from %s, best of %d runs\n", files.size(), inputFolder.string().c_str(), repetitions);
+
+  auto cachedParser = parser;
+  fs::remove_all(cacheDir);
+  cachedParser.cacheParsedFiles(cacheDir.string());
+
+  // Warms up file system cache and fills AST cache.
+  size_t numParsed = 0;
+  parseAll(parser, files, numParsed);
+  parseAll(cachedParser, files, numParsed);
+
+  std::printf("%8s %10s %12s\n", "mode", "files", "time(s)");
+  for (const auto* p : {&parser, &cachedParser})
+  {
+    auto best = parseAll(*p, files, numParsed);
+    for (int i = 1; i < repetitions; ++i)
+      best = std::min(best, parseAll(*p, files, numParsed));
+    std::printf("%8s %10zu %12.3f\n", (p == &parser) ? "parse" : "cache", numParsed, best);
+  }
+
+  fs::remove_all(cacheDir);
+
+  return 0;
+}
@@ -0,0 +1,250 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Measures how fast CppWriter emits ASTs of e2e test corpus to different kinds of streams.
+ *
+ * Usage: cppwriteremitbench [input-folder|--synthetic [repetitions]]
+ *
+ * With --synthetic, ASTs of classes with functions, members, and enums are built in memory instead of parsing files.
+ */
+
+#include "../app/test-parser-config.h"
+
+#include "cppwriter/cppcodestream.h"
+#include "cppwriter/cppwriter.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#  include <fcntl.h>
+#  include <io.h>
+#else
+#  include <fcntl.h>
+#  include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+#if defined(_WIN32)
+static const char* const kNullDevice = "NUL";
+
+static int openNullDevice()
+{
+  return _open(kNullDevice, _O_WRONLY | _O_BINARY);
+}
+
+static void closeFd(int fd)
+{
+  _close(fd);
+}
+#else
+static const char* const kNullDevice = "/dev/null";
+
+static int openNullDevice()
+{
+  return open(kNullDevice, O_WRONLY | O_CLOEXEC);
+}
+
+static void closeFd(int fd)
+{
+  close(fd);
+}
+#endif
+
+static std::vector<std::string> collectFiles(const fs::path& inputFolder)
+{
+  std::vector<std::string> files;
+  for (fs::recursive_directory_iterator dirItr(inputFolder); dirItr != fs::recursive_directory_iterator(); ++dirItr)
+  {
+    if (fs::is_regular_file(*dirItr))
+      files.push_back(dirItr->path().string());
+  }
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+using Asts = std::vector<std::unique_ptr<cppast::CppCompound>>;
+
+constexpr int kNumSyntheticFiles   = 200;
+constexpr int kNumClassesPerFile   = 50;
+constexpr int kNumMethodsPerClass  = 4;
+constexpr int kNumMembersPerClass  = 10;
+constexpr int kNumEnumItemsPerEnum = 5;
+
+static std::unique_ptr<cppast::CppVar> buildVar(const char* typeName, std::string name, std::uint8_t ptrLevel = 0)
+{
+  cppast::CppTypeModifier typeModifier {};
+  typeModifier.ptrLevel_ = ptrLevel;
+  return std::make_unique<cppast::CppVar>(std::make_unique<cppast::CppVarType>(typeName, typeModifier),
+                                          cppast::CppVarDecl(std::move(name)));
+}
+
+static std::unique_ptr<cppast::CppCompound> buildSyntheticAst(int fileIdx)
+{
+  auto fileAst = std::make_unique<cppast::CppCompound>("synthetic" + std::to_string(fileIdx) + ".h",
+                                                       cppast::CppCompoundType::FILE);
+  fileAst->add(std::make_unique<cppast::CppPreprocessorInclude>("<string>"));
+  auto ns = std::make_unique<cppast::CppCompound>("synthetic", cppast::CppCompoundType::NAMESPACE);
+  for (int c = 0; c < kNumClassesPerFile; ++c)
+  {
+    ns->add(std::make_unique<cppast::CppDocumentationComment>(cppast::CppText(std::string("/// Synthetic class."))));
+    auto cls = std::make_unique<cppast::CppCompound>("SyntheticClass" + std::to_string(c),
+                                                     cppast::CppCompoundType::CLASS);
+    cls->add(std::make_unique<cppast::CppEntityAccessSpecifier>(cppast::CppAccessType::PUBLIC));
+    for (int f = 0; f < kNumMethodsPerClass; ++f)
+    {
+      std::vector<std::unique_ptr<cppast::CppEntity>> params;
+      params.push_back(buildVar("int", "count"));
+      params.push_back(buildVar("const char", "name", 1));
+      cls->add(std::make_unique<cppast::CppFunction>("method" + std::to_string(f),
+                                                     std::make_unique<cppast::CppVarType>("void", cppast::CppTypeModifier()),
+                                                     std::move(params),
+                                                     0));
+    }
+    cls->add(std::make_unique<cppast::CppEntityAccessSpecifier>(cppast::CppAccessType::PRIVATE));
+    for (int m = 0; m < kNumMembersPerClass; ++m)
+      cls->add(buildVar((m % 2) ? "std::string" : "int", "member" + std::to_string(m), (m % 3) ? 0 : 1));
+    cppast::CppEnumItemList enumItems;
+    for (int e = 0; e < kNumEnumItemsPerEnum; ++e)
+      enumItems.emplace_back("kItem" + std::to_string(e));
+    cls->add(std::make_unique<cppast::CppEnum>("Kind", std::move(enumItems)));
+    ns->add(std::move(cls));
+  }
+  fileAst->add(std::move(ns));
+
+  return fileAst;
+}
+
+static Asts parseFiles(const fs::path& inputFolder)
+{
+  auto parser = constructCppParserForTest();
+  parser.parseEnumBodyAsBlob();
+  parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+  const auto files = collectFiles(inputFolder);
+  Asts       asts;
+  for (const auto& file : files)
+  {
+    if (auto ast = parser.parseFile(file))
+      asts.push_back(std::move(ast));
+  }
+  std::printf("Emitting %zu of %zu files from %s", asts.size(), files.size(), inputFolder.string().c_str());
+
+  return asts;
+}
+
+using EmitFunc = std::function<void(const cppcodegen::CppWriter&, const Asts&)>;
+
+static void emitToStringStream(const cppcodegen::CppWriter& writer, const Asts& asts)
+{
+  for (const auto& ast : asts)
+  {
+    std::ostringstream stm;
+    writer.emit(*ast, stm);
+  }
+}
+
+static void emitToFileStream(const cppcodegen::CppWriter& writer, const Asts& asts)
+{
+  std::ofstream stm(kNullDevice, std::ios::binary);
+  for (const auto& ast : asts)
+    writer.emit(*ast, stm);
+}
+
+static void emitToCodeBuffer(const cppcodegen::CppWriter& writer, const Asts& asts)
+{
+  cppcodegen::CppCodeStream stm;
+  for (const auto& ast : asts)
+  {
+    stm.reset();
+    writer.emit(*ast, stm);
+  }
+}
+
+static void emitToFd(const cppcodegen::CppWriter& writer, const Asts& asts)
+{
+  const auto fd = openNullDevice();
+  if (fd < 0)
+    return;
+  {
+    cppcodegen::CppCodeStream stm(fd);
+    for (const auto& ast : asts)
+      writer.emit(*ast, stm);
+  }
+  closeFd(fd);
+}
+
+static size_t emittedSize(const cppcodegen::CppWriter& writer, const Asts& asts)
+{
+  cppcodegen::CppCodeStream stm;
+  for (const auto& ast : asts)
+    writer.emit(*ast, stm);
+  return stm.size();
+}
+
+int main(int argc, char** argv)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const auto synthetic   = (argc > 1) && (std::strcmp(argv[1], "--synthetic") == 0);
+  const auto repetitions = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+
+  Asts asts;
+  if (synthetic)
+  {
+    for (int i = 0; i < kNumSyntheticFiles; ++i)
+      asts.push_back(buildSyntheticAst(i));
+    std::printf("Emitting %zu synthetic files", asts.size());
+  }
+  else
+  {
+    asts = parseFiles((argc > 1) ? fs::path(argv[1])
+                                 : fs::path(__FILE__).parent_path().parent_path() / "e2e" / "test_input");
+  }
+  std::printf(", best of %d runs\n", repetitions);
+
+  const cppcodegen::CppWriter writer;
+  const auto                  numBytes = emittedSize(writer, asts);
+  std::printf("%zu bytes are emitted per run\n", numBytes);
+
+  struct Mode
+  {
+    const char* name;
+    EmitFunc    emit;
+  };
+  const Mode modes[] = {
+    {"ostringstream", emitToStringStream},
+    {"ofstream", emitToFileStream},
+    {"code buffer", emitToCodeBuffer},
+    {"code fd", emitToFd},
+  };
+
+  std::printf("%14s %10s %10s\n", "mode", "emit(s)", "MB/s");
+  for (const auto& mode : modes)
+  {
+    double best = 0;
+    for (int i = 0; i < repetitions; ++i)
+    {
+      const auto start = Clock::now();
+      mode.emit(writer, asts);
+      const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+      best               = (i == 0) ? seconds : std::min(best, seconds);
+    }
+    std::printf("%14s %10.3f %10.1f\n", mode.name, best, numBytes / best / (1024.0 * 1024.0));
+  }
+
+  return 0;
+}
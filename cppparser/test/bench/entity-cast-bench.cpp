@@ -0,0 +1,163 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Compares casting entities of a synthetic AST by dynamic_cast and by CppEntityPtr that checks type tags.
+ *
+ * Usage: cppparserentitycastbench [num-entities]
+ */
+
+#include "cppast/cppast.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <memory>
+#include <string>
+#include <vector>
+
+constexpr size_t kNumMembersPerClass = 64;
+
+/**
+ * Builds classes having a mix of functions, variables, expressions, and preprocessors as members.
+ */
+static std::unique_ptr<cppast::CppCompound> BuildFileAst(size_t numEntities)
+{
+  auto fileAst = std::make_unique<cppast::CppCompound>("synthetic.h", cppast::CppCompoundType::FILE);
+  for (size_t c = 0; c * kNumMembersPerClass < numEntities; ++c)
+  {
+    auto cls = std::make_unique<cppast::CppCompound>("SyntheticClass" + std::to_string(c),
+                                                     cppast::CppCompoundType::CLASS);
+    for (size_t m = 0; m < kNumMembersPerClass; ++m)
+    {
+      const auto name = "member" + std::to_string(m);
+      switch (m % 6)
+      {
+        case 0:
+          cls->add(std::make_unique<cppast::CppFunction>(
+            name,
+            std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()),
+            std::vector<std::unique_ptr<cppast::CppEntity>>(),
+            0));
+          break;
+        case 1:
+          cls->add(std::make_unique<cppast::CppVar>(
+            std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()), cppast::CppVarDecl(name)));
+          break;
+        case 2:
+          cls->add(std::make_unique<cppast::CppNameExpr>(name));
+          break;
+        case 3:
+          cls->add(std::make_unique<cppast::CppBinomialExpr>(cppast::CppBinaryOperator::PLUS,
+                                                             std::make_unique<cppast::CppNameExpr>(name),
+                                                             std::make_unique<cppast::CppNumberLiteralExpr>("1")));
+          break;
+        case 4:
+          cls->add(std::make_unique<cppast::CppStaticCastExpr>(
+            std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier()),
+            std::make_unique<cppast::CppNameExpr>(name)));
+          break;
+        default:
+          cls->add(std::make_unique<cppast::CppPreprocessorDefine>(cppast::CppPreprocessorDefineType::RENAME, name));
+          break;
+      }
+    }
+    fileAst->add(std::move(cls));
+  }
+
+  return fileAst;
+}
+
+struct CastCounts
+{
+  size_t numFunctions   = 0;
+  size_t numVars        = 0;
+  size_t numNames       = 0;
+  size_t numStaticCasts = 0;
+  size_t numDefines     = 0;
+};
+
+template <template <typename> class Cast>
+static CastCounts CastAll(const std::vector<const cppast::CppEntity*>& entities)
+{
+  CastCounts counts;
+  for (const auto* entity : entities)
+  {
+    if (Cast<cppast::CppFunction>()(entity))
+      ++counts.numFunctions;
+    else if (Cast<cppast::CppVar>()(entity))
+      ++counts.numVars;
+    else if (Cast<cppast::CppNameExpr>()(entity))
+      ++counts.numNames;
+    else if (Cast<cppast::CppStaticCastExpr>()(entity))
+      ++counts.numStaticCasts;
+    else if (Cast<cppast::CppPreprocessorDefine>()(entity))
+      ++counts.numDefines;
+  }
+
+  return counts;
+}
+
+template <typename T>
+struct DynamicCast
+{
+  const T* operator()(const cppast::CppEntity* entity) const
+  {
+    return dynamic_cast<const T*>(entity);
+  }
+};
+
+template <typename T>
+struct TagCast
+{
+  const T* operator()(const cppast::CppEntity* entity) const
+  {
+    return cppast::helper::CppEntityPtr<const T>(entity);
+  }
+};
+
+template <template <typename> class Cast>
+static void Measure(const char* label, const std::vector<const cppast::CppEntity*>& entities)
+{
+  using Clock = std::chrono::steady_clock;
+
+  constexpr int kNumRounds = 10;
+
+  CastCounts counts;
+  const auto start = Clock::now();
+  for (int i = 0; i < kNumRounds; ++i)
+    counts = CastAll<Cast>(entities);
+  const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+  std::printf("%-12s %.3f s, %.2f ns per entity, %zu functions, %zu vars, %zu names, %zu static casts, %zu defines\n",
+              label,
+              seconds,
+              seconds * 1e9 / (entities.size() * kNumRounds),
+              counts.numFunctions,
+              counts.numVars,
+              counts.numNames,
+              counts.numStaticCasts,
+              counts.numDefines);
+}
+
+int main(int argc, char** argv)
+{
+  const auto numEntities = (argc > 1) ? static_cast<size_t>(std::max(1L, std::atol(argv[1]))) : size_t(1000000);
+
+  const auto                            fileAst = BuildFileAst(numEntities);
+  const cppast::CppCompound&            file    = *fileAst;
+  std::vector<const cppast::CppEntity*> entities;
+  file.visitAll([&entities](const cppast::CppEntity& cls) {
+    static_cast<const cppast::CppCompound&>(cls).visitAll([&entities](const cppast::CppEntity& member) {
+      entities.push_back(&member);
+      return true;
+    });
+    return true;
+  });
+
+  std::printf("%zu entities\n", entities.size());
+  Measure<DynamicCast>("dynamic_cast", entities);
+  Measure<TagCast>("type tags", entities);
+
+  return 0;
+}
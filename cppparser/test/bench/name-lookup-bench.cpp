@@ -0,0 +1,113 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Measures qualified name lookups in a CppProgram of a synthetic wide and deep type tree.
+ *
+ * Usage: cppparsernamelookupbench [num-lookups]
+ */
+
+#include "cppparser/cpp_program.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+static size_t gNumAllocations = 0;
+
+void* operator new(std::size_t size)
+{
+  ++gNumAllocations;
+  if (auto* mem = std::malloc(size ? size : 1))
+    return mem;
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  std::free(ptr);
+}
+
+constexpr int kNumNamespaces        = 64;
+constexpr int kNumClassesPerScope   = 32;
+constexpr int kNumNestedPerClass    = 4;
+constexpr int kNumQualifiedNamesMax = 1 << 16;
+
+/**
+ * Builds namespaces containing classes that have nested classes, and records qualified names of all of them.
+ */
+static std::unique_ptr<cppast::CppCompound> BuildFileAst(std::vector<std::string>& qualifiedNames)
+{
+  auto fileAst = std::make_unique<cppast::CppCompound>("synthetic.h", cppast::CppCompoundType::FILE);
+  for (int n = 0; n < kNumNamespaces; ++n)
+  {
+    const auto nsName = "synthetic_namespace" + std::to_string(n);
+    auto       ns     = std::make_unique<cppast::CppCompound>(nsName, cppast::CppCompoundType::NAMESPACE);
+    for (int c = 0; c < kNumClassesPerScope; ++c)
+    {
+      const auto clsName = "wxSyntheticClass" + std::to_string(c);
+      auto       cls     = std::make_unique<cppast::CppCompound>(clsName, cppast::CppCompoundType::CLASS);
+      for (int i = 0; i < kNumNestedPerClass; ++i)
+      {
+        const auto nestedName = "wxSyntheticNested" + std::to_string(i);
+        cls->add(std::make_unique<cppast::CppCompound>(nestedName, cppast::CppCompoundType::STRUCT));
+        qualifiedNames.push_back(nsName + "::" + clsName + "::" + nestedName);
+      }
+      ns->add(std::move(cls));
+      qualifiedNames.push_back(nsName + "::" + clsName);
+    }
+    fileAst->add(std::move(ns));
+    qualifiedNames.push_back(nsName);
+  }
+
+  return fileAst;
+}
+
+int main(int argc, char** argv)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const auto numLookups = (argc > 1) ? static_cast<size_t>(std::max(1L, std::atol(argv[1]))) : size_t(1000000);
+
+  std::vector<std::string> qualifiedNames;
+  cppparser::CppProgram    program({});
+  program.addCppFile(BuildFileAst(qualifiedNames));
+  qualifiedNames.resize(std::min<size_t>(qualifiedNames.size(), kNumQualifiedNamesMax));
+
+  // A fraction of names do not exist, so, that failing lookups are measured too.
+  std::mt19937                       rng(42);
+  std::vector<std::string>           names;
+  std::uniform_int_distribution<int> pick(0, static_cast<int>(qualifiedNames.size()) - 1);
+  for (size_t i = 0; i < kNumQualifiedNamesMax; ++i)
+  {
+    auto name = qualifiedNames[pick(rng)];
+    if (i % 8 == 0)
+      name += "::Missing";
+    names.push_back(std::move(name));
+  }
+
+  size_t     numFound             = 0;
+  const auto numAllocationsBefore = gNumAllocations;
+  const auto start                = Clock::now();
+  for (size_t i = 0; i < numLookups; ++i)
+  {
+    if (program.nameLookup(names[i % names.size()]))
+      ++numFound;
+  }
+  const auto seconds        = std::chrono::duration<double>(Clock::now() - start).count();
+  const auto numAllocations = gNumAllocations - numAllocationsBefore;
+
+  std::printf("%zu lookups of %zu names, %zu found\n", numLookups, names.size(), numFound);
+  std::printf("%.3f s, %.1f ns per lookup, %zu allocations\n", seconds, seconds * 1e9 / numLookups, numAllocations);
+
+  return 0;
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Measures how parsing of e2e test corpus scales with number of threads.
+ *
+ * Usage: cppparserscalingbench [input-folder [max-threads]]
+ */
+
+#include "../app/test-parser-config.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+static std::vector<std::string> collectFiles(const fs::path& inputFolder)
+{
+  std::vector<std::string> files;
+  for (fs::recursive_directory_iterator dirItr(inputFolder); dirItr != fs::recursive_directory_iterator(); ++dirItr)
+  {
+    if (fs::is_regular_file(*dirItr))
+      files.push_back(dirItr->path().string());
+  }
+  std::sort(files.begin(), files.end());
+
+  return files;
+}
+
+/**
+ * Parses all files using given number of threads, each thread having its own parser.
+ * @return Time taken in seconds.
+ */
+static double parseAll(const cppparser::CppParser& parser, const std::vector<std::string>& files, unsigned numThreads)
+{
+  std::atomic<size_t> nextFile {0};
+  const auto          start = std::chrono::steady_clock::now();
+
+  std::vector<std::thread> threads;
+  for (unsigned i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&, threadParser = parser]() {
+      for (auto idx = nextFile++; idx < files.size(); idx = nextFile++)
+        threadParser.parseFile(files[idx]);
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char** argv)
+{
+  const auto inputFolder =
+    (argc > 1) ? fs::path(argv[1]) : fs::path(__FILE__).parent_path().parent_path() / "e2e" / "test_input";
+  const auto maxThreads =
+    (argc > 2) ? static_cast<unsigned>(std::atoi(argv[2])) : std::max(1U, std::thread::hardware_concurrency());
+
+  auto parser = constructCppParserForTest();
+  parser.parseEnumBodyAsBlob();
+  parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+  const auto files = collectFiles(inputFolder);
+  std::printf("Parsing %zu files from %s\n", files.size(), inputFolder.string().c_str());
+
+  // Warm up file system cache.
+  parseAll(parser, files, maxThreads);
+
+  const auto serialTime = parseAll(parser, files, 1);
+  std::printf("%8s %12s %10s %12s\n", "threads", "seconds", "speedup", "efficiency");
+  for (unsigned numThreads = 1; numThreads <= maxThreads; numThreads *= 2)
+  {
+    const auto time    = (numThreads == 1) ? serialTime : parseAll(parser, files, numThreads);
+    const auto speedup = serialTime / time;
+    std::printf("%8u %12.3f %10.2f %11.0f%%\n", numThreads, time, speedup, 100.0 * speedup / numThreads);
+    if ((numThreads < maxThreads) && (numThreads * 2 > maxThreads))
+      numThreads = maxThreads / 2;
+  }
+
+  return 0;
+}
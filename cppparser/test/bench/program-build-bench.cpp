@@ -0,0 +1,98 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Measures building the type tree of a CppProgram from many synthetic files using different number of threads.
+ *
+ * Files reopen the same namespaces and forward declare classes defined in other files, so merging is exercised too.
+ *
+ * Usage: cppparserprogrambuildbench [num-files]
+ */
+
+#include "cppparser/cpp_program.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+constexpr int kNumNamespaces      = 8;
+constexpr int kNumClassesPerScope = 64;
+constexpr int kNumMembersPerClass = 16;
+
+static std::unique_ptr<cppast::CppCompound> BuildFileAst(int fileIdx)
+{
+  auto fileAst = std::make_unique<cppast::CppCompound>("synthetic" + std::to_string(fileIdx) + ".h",
+                                                       cppast::CppCompoundType::FILE);
+  for (int n = 0; n < kNumNamespaces; ++n)
+  {
+    auto ns = std::make_unique<cppast::CppCompound>("synthetic_namespace" + std::to_string(n),
+                                                    cppast::CppCompoundType::NAMESPACE);
+    // Class defined by the previous file is forward declared by this one.
+    ns->add(std::make_unique<cppast::CppForwardClassDecl>("wxSyntheticClass" + std::to_string(fileIdx - 1) + "_0",
+                                                          cppast::CppCompoundType::CLASS));
+    for (int c = 0; c < kNumClassesPerScope; ++c)
+    {
+      auto cls = std::make_unique<cppast::CppCompound>(
+        "wxSyntheticClass" + std::to_string(fileIdx) + "_" + std::to_string(c), cppast::CppCompoundType::CLASS);
+      for (int m = 0; m < kNumMembersPerClass; ++m)
+      {
+        auto varType = std::make_unique<cppast::CppVarType>("int", cppast::CppTypeModifier());
+        auto varDecl = cppast::CppVarDecl("member" + std::to_string(m));
+        cls->add(std::make_unique<cppast::CppVar>(std::move(varType), std::move(varDecl)));
+      }
+      cls->add(std::make_unique<cppast::CppEnum>("Kind", cppast::CppEnumItemList()));
+      ns->add(std::move(cls));
+    }
+    fileAst->add(std::move(ns));
+  }
+
+  return fileAst;
+}
+
+int main(int argc, char** argv)
+{
+  using Clock = std::chrono::steady_clock;
+
+  const auto numFiles   = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 256;
+  const auto maxThreads = std::max(1U, std::thread::hardware_concurrency());
+
+  const auto buildFileAsts = [numFiles]() {
+    std::vector<std::unique_ptr<cppast::CppCompound>> cppAsts;
+    for (int i = 0; i < numFiles; ++i)
+      cppAsts.push_back(BuildFileAst(i));
+    return cppAsts;
+  };
+
+  std::printf("%d files\n", numFiles);
+  {
+    auto                  cppAsts = buildFileAsts();
+    cppparser::CppProgram program({});
+    const auto            start = Clock::now();
+    for (auto& cppAst : cppAsts)
+      program.addCppFile(std::move(cppAst));
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("addCppFile: %.3f s, %zu nodes named Kind\n", seconds, program.searchTypeNodes("Kind").size());
+  }
+  for (unsigned numThreads = 1;; numThreads = std::min(numThreads * 2, maxThreads))
+  {
+    auto                  cppAsts = buildFileAsts();
+    cppparser::CppProgram program({});
+    const auto            start = Clock::now();
+    program.addCppFiles(std::move(cppAsts), numThreads);
+    const auto seconds = std::chrono::duration<double>(Clock::now() - start).count();
+
+    std::printf("addCppFiles with %u threads: %.3f s, %zu nodes named Kind\n",
+                numThreads,
+                seconds,
+                program.searchTypeNodes("Kind").size());
+    if (numThreads == maxThreads)
+      break;
+  }
+
+  return 0;
+}
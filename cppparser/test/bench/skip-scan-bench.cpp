@@ -0,0 +1,105 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file Measures how fast lexer skips disabled code, block comments, and function bodies parsed as blob.
+ *
+ * Usage: cppparserskipscanbench [size-in-mb [repetitions]]
+ */
+
+#include "cppparser/cppparser.h"
+#include "text-scanner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <string>
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * @return Text of about given size made of lines that are typical of a C++ header.
+ */
+static std::string makeLines(size_t size)
+{
+  static const char* const lines[] = {
+    "  glBegin(GL_TRIANGLES);\n",
+    "  for (int i = 0; i < numVertices; ++i)\n",
+    "    vertices[i] = transform * vertices[i] + offset;\n",
+    "\n",
+    "  return static_cast<GLenum>(value & 0xFFFF);\n",
+  };
+
+  std::string text;
+  text.reserve(size + 128);
+  for (size_t i = 0; text.size() < size; ++i)
+    text += lines[i % (sizeof(lines) / sizeof(lines[0]))];
+
+  return text;
+}
+
+/**
+ * @return Best time in seconds of given repetitions.
+ */
+static double bestTime(int repetitions, const std::function<void()>& run)
+{
+  double best = 0;
+  for (int i = 0; i < repetitions; ++i)
+  {
+    const auto start = Clock::now();
+    run();
+    const auto time = std::chrono::duration<double>(Clock::now() - start).count();
+    best            = (i == 0) ? time : std::min(best, time);
+  }
+
+  return best;
+}
+
+static void printThroughput(const char* name, size_t numBytes, double seconds)
+{
+  std::printf("%-28s %12.1f MB/s\n", name, numBytes / seconds / (1024 * 1024));
+}
+
+int main(int argc, char** argv)
+{
+  const auto sizeInMb    = (argc > 1) ? std::max(1, std::atoi(argv[1])) : 64;
+  const auto repetitions = (argc > 2) ? std::max(1, std::atoi(argv[2])) : 5;
+  const auto lines       = makeLines(static_cast<size_t>(sizeInMb) * 1024 * 1024);
+
+  std::printf("Skipping %d MB, best of %d runs\n", sizeInMb, repetitions);
+
+  std::string scanBuffer = lines + '#' + '\0';
+  for (const auto isa : {ScannerIsa::Scalar, ScannerIsa::Sse2, ScannerIsa::Avx2})
+  {
+    if (isa > BestScannerIsa())
+      continue;
+    const char* const isaNames[] = {"scan (scalar)", "scan (sse2)", "scan (avx2)"};
+    const auto        seconds    = bestTime(repetitions, [&]() {
+      const auto scan = ScanTill(scanBuffer.data(), scanBuffer.data() + scanBuffer.size(), "/#", isa);
+      if (*scan.stop != '#')
+        std::abort();
+    });
+    printThroughput(isaNames[static_cast<int>(isa)], lines.size(), seconds);
+  }
+
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyAsBlob(true);
+  parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+  const auto lexerThroughput = [&](const char* name, const std::string& prefix, const std::string& suffix) {
+    const auto stm     = prefix + lines + suffix;
+    const auto seconds = bestTime(repetitions, [&]() {
+      if (!parser.parseStream(stm.data(), stm.size()))
+        std::abort();
+    });
+    printThroughput(name, lines.size(), seconds);
+  };
+
+  lexerThroughput("lexer: #if 0", "#if 0\n", "#endif\n");
+  lexerThroughput("lexer: block comment", "/*\n", "*/\n");
+  lexerThroughput("lexer: function body as blob", "void f()\n{\n", "}\n");
+
+  return 0;
+}
@@ -0,0 +1,107 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+class ArenaAllocationTest : public EmbeddedSnippetTestBase
+{
+protected:
+  ArenaAllocationTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+};
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+namespace ns {
+class ArenaTestClass
+{
+public:
+  int Method(int x) const
+  {
+    return x * 2;
+  }
+
+private:
+  int member_;
+};
+} // namespace ns
+#endif
+static const int kSnippetLastLine = __LINE__ - 2;
+
+TEST_CASE_METHOD(ArenaAllocationTest, "AST allocated from arena")
+{
+  auto testSnippet = getTestSnippetParseStream(kSnippetLastLine);
+
+  cppparser::CppParser parser;
+  parser.allocateEntitiesFromArena(true);
+  auto ast = parser.parseStream(testSnippet.data(), testSnippet.size());
+  REQUIRE(ast != nullptr);
+  CHECK(ast->compoundType() == cppast::CppCompoundType::FILE);
+
+  // At least namespace, class, method, its body, and data member.
+  REQUIRE(ast->arena() != nullptr);
+  CHECK(ast->arena()->numAllocations() >= 5);
+  CHECK(ast->arena()->bytesAllocated() >= ast->arena()->numAllocations() * sizeof(cppast::CppEntity));
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 1);
+
+  cppast::CppConstCompoundEPtr ns = members[0];
+  REQUIRE(ns);
+  CHECK(ns->name() == "ns");
+  CHECK(ns->owner() == ast.get());
+
+  const auto nsMembers = GetAllOwnedEntities(*ns);
+  REQUIRE(nsMembers.size() == 1);
+  cppast::CppConstCompoundEPtr classDefn = nsMembers[0];
+  REQUIRE(classDefn);
+  CHECK(classDefn->name() == "ArenaTestClass");
+
+  // Releasing the AST must release entities as well as the arena without touching freed memory.
+  ast.reset();
+}
+
+TEST_CASE_METHOD(ArenaAllocationTest, "Lazily parsed body allocated from arena")
+{
+  const auto testSnippet = getTestSnippetParseStream(kSnippetLastLine);
+
+  // Entities of a lazily parsed body are allocated from an arena owned by the body.
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyLazily(true);
+  parser.allocateEntitiesFromArena(true);
+  auto       stm = testSnippet;
+  const auto ast = parser.parseStream(stm.data(), stm.size());
+  REQUIRE(ast != nullptr);
+  REQUIRE(ast->arena() != nullptr);
+  const auto numFileAllocations = ast->arena()->numAllocations();
+
+  cppast::CppConstCompoundEPtr ns = GetAllOwnedEntities(*ast)[0];
+  REQUIRE(ns);
+  cppast::CppConstCompoundEPtr classDefn = GetAllOwnedEntities(*ns)[0];
+  REQUIRE(classDefn);
+  const cppast::CppFunction* method = nullptr;
+  for (const auto& member : GetAllOwnedEntities(*classDefn))
+  {
+    cppast::CppConstFunctionEPtr func = member;
+    if (func)
+      method = func.get();
+  }
+  REQUIRE(method);
+  REQUIRE(method->defn() != nullptr);
+  REQUIRE(method->defn()->arena() != nullptr);
+  CHECK(method->defn()->arena()->numAllocations() > 0);
+  CHECK(ast->arena()->numAllocations() == numFileAllocations);
+
+  // It is off by default.
+  cppparser::CppParser heapParser;
+  heapParser.parseFunctionBodyLazily(true);
+  auto       heapStm = testSnippet;
+  const auto heapAst = heapParser.parseStream(heapStm.data(), heapStm.size());
+  REQUIRE(heapAst != nullptr);
+  CHECK(heapAst->arena() == nullptr);
+}
@@ -0,0 +1,180 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+class AstCacheTest : public EmbeddedSnippetTestBase
+{
+protected:
+  AstCacheTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+
+  static std::vector<fs::path> cacheEntries(const fs::path& cacheDir)
+  {
+    std::vector<fs::path> entries;
+    for (const auto& entry : fs::directory_iterator(cacheDir))
+    {
+      if (entry.path().extension() == ".ast")
+        entries.push_back(entry.path());
+    }
+    return entries;
+  }
+};
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+class CachedClass
+{
+public:
+  int CachedMethod(int x) const
+  {
+    return x * 2;
+  }
+
+#  if CPPPARSER_TEST_DEFINED_MACRO
+  int configDependentMember_;
+#  endif
+};
+
+enum CachedEnum
+{
+  kCachedValue = 1
+};
+#endif
+static const int kSnippetLastLine = __LINE__ - 2;
+
+TEST_CASE_METHOD(AstCacheTest, "Unchanged file is loaded from cache")
+{
+  const auto testDir  = fs::temp_directory_path() / "cppparser-ast-cache-test";
+  const auto cacheDir = testDir / "cache";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir);
+
+  const auto testFile = (testDir / "cached.h").string();
+  {
+    const auto    snippet = getTestSnippet(kSnippetLastLine);
+    std::ofstream stm(testFile, std::ios::binary);
+    stm << snippet;
+  }
+
+  cppparser::CppParser parser;
+  parser.cacheParsedFiles(cacheDir.string());
+  const auto parsedAst = parser.parseFile(testFile);
+  REQUIRE(parsedAst != nullptr);
+  REQUIRE(cacheEntries(cacheDir).size() == 1);
+
+  const auto cachedAst = parser.parseFile(testFile);
+  REQUIRE(cachedAst != nullptr);
+  CHECK(cachedAst->name() == testFile);
+  const auto parsedMembers = GetAllOwnedEntities(*parsedAst);
+  const auto cachedMembers = GetAllOwnedEntities(*cachedAst);
+  REQUIRE(cachedMembers.size() == 2);
+  REQUIRE(cachedMembers.size() == parsedMembers.size());
+  cppast::CppConstCompoundEPtr cls       = cachedMembers[0];
+  cppast::CppConstCompoundEPtr parsedCls = parsedMembers[0];
+  REQUIRE(cls);
+  REQUIRE(parsedCls);
+  CHECK(cls->name() == "CachedClass");
+  CHECK(GetAllOwnedEntities(*cls).size() == GetAllOwnedEntities(*parsedCls).size());
+  CHECK(cachedMembers[1]->entityType() == cppast::CppEntityType::ENUM);
+
+  // Different configuration must not reuse AST parsed with another one.
+  cppparser::CppParser otherParser;
+  otherParser.addDefinedName("CPPPARSER_TEST_DEFINED_MACRO", 1);
+  otherParser.cacheParsedFiles(cacheDir.string());
+  const auto otherAst = otherParser.parseFile(testFile);
+  REQUIRE(otherAst != nullptr);
+  CHECK(cacheEntries(cacheDir).size() == 2);
+  cppast::CppConstCompoundEPtr otherCls = GetAllOwnedEntities(*otherAst)[0];
+  REQUIRE(otherCls);
+  CHECK(GetAllOwnedEntities(*otherCls).size() == GetAllOwnedEntities(*cls).size() + 1);
+
+  // Corrupt entry is ignored and the file is parsed again.
+  for (const auto& entry : cacheEntries(cacheDir))
+    std::ofstream(entry, std::ios::binary | std::ios::trunc) << "corrupt";
+  const auto reparsedAst = parser.parseFile(testFile);
+  REQUIRE(reparsedAst != nullptr);
+  CHECK(GetAllOwnedEntities(*reparsedAst).size() == 2);
+
+  fs::remove_all(testDir);
+}
+
+TEST_CASE_METHOD(AstCacheTest, "AST is loaded from the cache entry instead of being parsed")
+{
+  const auto testDir  = fs::temp_directory_path() / "cppparser-ast-cache-hit-test";
+  const auto cacheDir = testDir / "cache";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir);
+
+  const auto testFile  = (testDir / "cached.h").string();
+  const auto otherFile = (testDir / "other.h").string();
+  std::ofstream(testFile, std::ios::binary) << getTestSnippet(kSnippetLastLine);
+  std::ofstream(otherFile, std::ios::binary) << "int otherVar;\n";
+
+  cppparser::CppParser parser;
+  parser.cacheParsedFiles(cacheDir.string());
+  REQUIRE(parser.parseFile(testFile) != nullptr);
+  const auto entries = cacheEntries(cacheDir);
+  REQUIRE(entries.size() == 1);
+  const auto testEntry = entries[0];
+  REQUIRE(parser.parseFile(otherFile) != nullptr);
+  REQUIRE(cacheEntries(cacheDir).size() == 2);
+
+  // Parsing the file again would give its own entities, so, getting those of the other file proves a cache hit.
+  for (const auto& entry : cacheEntries(cacheDir))
+  {
+    if (entry != testEntry)
+      fs::copy_file(entry, testEntry, fs::copy_options::overwrite_existing);
+  }
+  const auto cachedAst = parser.parseFile(testFile);
+  REQUIRE(cachedAst != nullptr);
+  CHECK(cachedAst->name() == testFile);
+  const auto members = GetAllOwnedEntities(*cachedAst);
+  REQUIRE(members.size() == 1);
+  cppast::CppConstVarEPtr var = members[0];
+  REQUIRE(var);
+  CHECK(var->name() == "otherVar");
+
+  // Temporary files of stores are never left behind.
+  for (const auto& entry : fs::directory_iterator(cacheDir))
+    CHECK(entry.path().extension() == ".ast");
+
+  fs::remove_all(testDir);
+}
+
+TEST_CASE_METHOD(AstCacheTest, "Cache is trimmed to its size limit")
+{
+  const auto testDir  = fs::temp_directory_path() / "cppparser-ast-cache-limit-test";
+  const auto cacheDir = testDir / "cache";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir);
+
+  const auto           snippet = getTestSnippet(kSnippetLastLine);
+  cppparser::CppParser parser;
+  // Limit is so small that only the most recently stored entry survives.
+  parser.cacheParsedFiles(cacheDir.string(), 1);
+  for (int i = 0; i < 4; ++i)
+  {
+    const auto testFile = (testDir / ("cached-" + std::to_string(i) + ".h")).string();
+    {
+      std::ofstream stm(testFile, std::ios::binary);
+      stm << snippet << "int cachedVar" << i << ";\n";
+    }
+    REQUIRE(parser.parseFile(testFile) != nullptr);
+  }
+  CHECK(cacheEntries(cacheDir).size() <= 1);
+
+  fs::remove_all(testDir);
+}
@@ -0,0 +1,102 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+class ConcurrentParsingTest : public EmbeddedSnippetTestBase
+{
+protected:
+  ConcurrentParsingTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+};
+
+TEST_CASE_METHOD(ConcurrentParsingTest, "Differently configured parsers on different threads")
+{
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+  void FunctionWithConfigDependentParams(int normalParam
+#  if CPPPARSER_TEST_DEFINED_MACRO
+                                         ,
+                                         int enabledParam
+#  endif // CPPPARSER_TEST_DEFINED_MACRO
+  );
+#endif
+  const auto testSnippet = getTestSnippetParseStream(__LINE__ - 2);
+
+  constexpr size_t numThreads    = 8;
+  constexpr size_t numIterations = 64;
+
+  // Catch assertions are not thread safe, so, threads only record what they found.
+  std::vector<size_t>      numExpectedResults(numThreads, 0);
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numThreads; ++i)
+  {
+    threads.emplace_back([&, i]() {
+      const int            macroValue = static_cast<int>(i % 2);
+      cppparser::CppParser parser;
+      parser.addDefinedName("CPPPARSER_TEST_DEFINED_MACRO", macroValue);
+      for (size_t n = 0; n < numIterations; ++n)
+      {
+        auto       stm = testSnippet;
+        const auto ast = parser.parseStream(stm.data(), stm.size());
+        if (!ast)
+          continue;
+        const auto members = GetAllOwnedEntities(*ast);
+        if (members.size() != 1)
+          continue;
+        cppast::CppConstFunctionEPtr func = members[0];
+        if (func && (GetAllParams(*func).size() == static_cast<size_t>(1 + macroValue)))
+          ++numExpectedResults[i];
+      }
+    });
+  }
+  for (auto& t : threads)
+    t.join();
+
+  for (const auto numExpected : numExpectedResults)
+    CHECK(numExpected == numIterations);
+}
+
+TEST_CASE("Batch parsing returns ASTs in input order")
+{
+  namespace fs = std::filesystem;
+
+  const auto testDir = fs::temp_directory_path() / "cppparser-batch-parsing-test";
+  fs::create_directories(testDir);
+
+  // Files are of increasing sizes so that largest first scheduling parses them in reverse of input order.
+  constexpr size_t         numFiles = 12;
+  std::vector<std::string> files;
+  for (size_t i = 0; i < numFiles; ++i)
+  {
+    const auto    path = (testDir / ("file" + std::to_string(i) + ".h")).string();
+    std::ofstream stm(path);
+    for (size_t n = 0; n <= i; ++n)
+      stm << "int f" << i << "_" << n << "();\n";
+    files.push_back(path);
+  }
+
+  cppparser::CppParser parser;
+  const auto           asts = parser.parseFiles(files, 4);
+
+  REQUIRE(asts.size() == numFiles);
+  for (size_t i = 0; i < numFiles; ++i)
+  {
+    REQUIRE(asts[i] != nullptr);
+    CHECK(asts[i]->name() == files[i]);
+    CHECK(GetAllOwnedEntities(*asts[i]).size() == i + 1);
+  }
+
+  fs::remove_all(testDir);
+}
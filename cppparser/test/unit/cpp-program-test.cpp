@@ -0,0 +1,312 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cpp_program.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::unique_ptr<cppast::CppCompound> MakeCompound(std::string name, cppast::CppCompoundType compoundType)
+{
+  return std::make_unique<cppast::CppCompound>(std::move(name), compoundType);
+}
+
+/**
+ * Builds:
+ *   namespace Outer { class Widget { struct Item; }; namespace Inner { class Item; } }
+ *   namespace Other { class Item; }
+ */
+std::unique_ptr<cppast::CppCompound> MakeFileAst()
+{
+  auto fileAst = std::make_unique<cppast::CppCompound>("test.h", cppast::CppCompoundType::FILE);
+
+  auto outer  = MakeCompound("Outer", cppast::CppCompoundType::NAMESPACE);
+  auto widget = MakeCompound("Widget", cppast::CppCompoundType::CLASS);
+  widget->add(MakeCompound("Item", cppast::CppCompoundType::STRUCT));
+  outer->add(std::move(widget));
+  auto inner = MakeCompound("Inner", cppast::CppCompoundType::NAMESPACE);
+  inner->add(MakeCompound("Item", cppast::CppCompoundType::CLASS));
+  outer->add(std::move(inner));
+  fileAst->add(std::move(outer));
+
+  auto other = MakeCompound("Other", cppast::CppCompoundType::NAMESPACE);
+  other->add(MakeCompound("Item", cppast::CppCompoundType::CLASS));
+  fileAst->add(std::move(other));
+
+  return fileAst;
+}
+
+/**
+ * @return Text that describes the type tree in the order of children as they are stored, and the order in which
+ * nodes of a name are searched.
+ */
+std::string DumpTypeTree(const cppparser::CppProgram& program, const cppparser::CppTypeTreeNode& node, int indent = 0)
+{
+  std::string dump;
+  for (const auto& child : node.children)
+  {
+    dump.append(indent, ' ').append(child.first);
+    dump += " depth:" + std::to_string(child.second->depth);
+    dump += " entities:" + std::to_string(child.second->cppEntitySet.size());
+    const auto sameNamedNodes = program.searchTypeNodes(child.first);
+    const auto rank = std::find(sameNamedNodes.begin(), sameNamedNodes.end(), child.second) - sameNamedNodes.begin();
+    dump += " rank:" + std::to_string(rank) + '\n';
+    dump += DumpTypeTree(program, *child.second, indent + 2);
+  }
+  return dump;
+}
+
+std::vector<std::unique_ptr<cppast::CppCompound>> MakeFileAsts()
+{
+  std::vector<std::unique_ptr<cppast::CppCompound>> fileAsts;
+  for (int i = 0; i < 8; ++i)
+  {
+    auto fileAst = MakeFileAst();
+    auto outer   = MakeCompound("Outer", cppast::CppCompoundType::NAMESPACE);
+    outer->add(std::make_unique<cppast::CppForwardClassDecl>("Widget", cppast::CppCompoundType::CLASS));
+    outer->add(MakeCompound("Item" + std::to_string(i), cppast::CppCompoundType::CLASS));
+    fileAst->add(std::move(outer));
+    fileAsts.push_back(std::move(fileAst));
+  }
+  fileAsts.push_back(nullptr);
+  fileAsts.push_back(MakeCompound("NotAFile", cppast::CppCompoundType::NAMESPACE));
+
+  return fileAsts;
+}
+
+} // namespace
+
+TEST_CASE("Qualified name lookup in CppProgram")
+{
+  cppparser::CppProgram program({});
+  program.addCppFile(MakeFileAst());
+
+  const auto* widget = program.nameLookup("Outer::Widget");
+  REQUIRE(widget != nullptr);
+  CHECK(program.nameLookup("::Outer::Widget") == widget);
+  CHECK(program.nameLookup("Outer::Widget::Missing") == nullptr);
+  CHECK(program.nameLookup("Outer::Widget::") == nullptr);
+
+  const auto* widgetItem = program.nameLookup("Outer::Widget::Item");
+  REQUIRE(widgetItem != nullptr);
+  CHECK(widgetItem->parent == widget);
+
+  // Unqualified name is searched upward from the given scope.
+  const auto* innerItem = program.nameLookup("Outer::Inner::Item");
+  REQUIRE(innerItem != nullptr);
+  CHECK(program.nameLookup("Item", innerItem->parent) == innerItem);
+  CHECK(program.nameLookup("Widget", innerItem->parent) == widget);
+  CHECK(program.nameLookup("Item") == nullptr);
+}
+
+TEST_CASE("Searching type nodes down the type tree")
+{
+  cppparser::CppProgram program({});
+  program.addCppFile(MakeFileAst());
+
+  const auto* outer      = program.nameLookup("Outer");
+  const auto* widgetItem = program.nameLookup("Outer::Widget::Item");
+  const auto* innerItem  = program.nameLookup("Outer::Inner::Item");
+  const auto* otherItem  = program.nameLookup("Other::Item");
+  REQUIRE(outer != nullptr);
+
+  CHECK(program.searchTypeNode("Widget") == program.nameLookup("Outer::Widget"));
+  CHECK(program.searchTypeNode("Missing") == nullptr);
+  CHECK(program.searchTypeNode("Outer", outer) == nullptr);
+
+  // Shallower nodes come first and nodes of same depth are in the order of names of their scopes.
+  const auto allItems = program.searchTypeNodes("Item");
+  REQUIRE(allItems.size() == 3);
+  CHECK(allItems[0] == otherItem);
+  CHECK(allItems[1] == innerItem);
+  CHECK(allItems[2] == widgetItem);
+  CHECK(program.searchTypeNode("Item") == otherItem);
+
+  const auto outerItems = program.searchTypeNodes("Item", outer);
+  REQUIRE(outerItems.size() == 2);
+  CHECK(outerItems[0] == innerItem);
+  CHECK(program.searchTypeNode("Item", outer) == innerItem);
+}
+
+TEST_CASE("Order of type nodes of same depth does not depend on the order they were added")
+{
+  const auto makeFileAst = [](const char* fileName, const char* scopeName, const char* innerScopeName) {
+    auto scope      = MakeCompound(scopeName, cppast::CppCompoundType::NAMESPACE);
+    auto innerScope = MakeCompound(innerScopeName, cppast::CppCompoundType::CLASS);
+    innerScope->add(MakeCompound("X", cppast::CppCompoundType::CLASS));
+    scope->add(std::move(innerScope));
+    scope->add(MakeCompound("X", cppast::CppCompoundType::CLASS));
+    auto fileAst = std::make_unique<cppast::CppCompound>(fileName, cppast::CppCompoundType::FILE);
+    fileAst->add(std::move(scope));
+    return fileAst;
+  };
+
+  cppparser::CppProgram program({});
+  program.addCppFile(makeFileAst("b.h", "B", "A"));
+  program.addCppFile(makeFileAst("a.h", "A", "Z"));
+
+  const auto* aX  = program.nameLookup("A::X");
+  const auto* bX  = program.nameLookup("B::X");
+  const auto* aZX = program.nameLookup("A::Z::X");
+  const auto* bAX = program.nameLookup("B::A::X");
+  REQUIRE(aX != nullptr);
+  REQUIRE(bX != nullptr);
+
+  CHECK(program.searchTypeNode("X") == aX);
+  CHECK(program.searchTypeNodes("X") == std::vector<const cppparser::CppTypeTreeNode*> {aX, bX, aZX, bAX});
+}
+
+TEST_CASE("Containment check of entities in type tree")
+{
+  cppparser::CppProgram program({});
+  auto                  fileAst = MakeFileAst();
+  const auto*           fileEnt = fileAst.get();
+  program.addCppFile(std::move(fileAst));
+
+  const auto* outer      = program.nameLookup("Outer");
+  const auto* widget     = program.nameLookup("Outer::Widget");
+  const auto* widgetItem = program.nameLookup("Outer::Widget::Item");
+  const auto* otherItem  = program.nameLookup("Other::Item");
+  REQUIRE(outer != nullptr);
+
+  const auto* widgetItemEnt = *widgetItem->cppEntitySet.begin();
+  CHECK(program.has(*outer, widgetItemEnt));
+  CHECK(program.has(*widget, widgetItemEnt));
+  CHECK(program.has(*widgetItem, widgetItemEnt));
+  CHECK_FALSE(program.has(*otherItem, widgetItemEnt));
+  CHECK_FALSE(program.has(*widget, *outer->cppEntitySet.begin()));
+  CHECK(program.has(*program.nameLookup(""), fileEnt));
+  CHECK(outer->has(widgetItemEnt));
+
+  // Checks stay valid as the tree grows.
+  auto other = std::make_unique<cppast::CppCompound>("Outer", cppast::CppCompoundType::NAMESPACE);
+  other->add(MakeCompound("Gadget", cppast::CppCompoundType::CLASS));
+  auto nextFileAst = std::make_unique<cppast::CppCompound>("next.h", cppast::CppCompoundType::FILE);
+  nextFileAst->add(std::move(other));
+  program.addCppFile(std::move(nextFileAst));
+
+  const auto* gadget = program.nameLookup("Outer::Gadget");
+  REQUIRE(gadget != nullptr);
+  CHECK(program.has(*outer, *gadget->cppEntitySet.begin()));
+  CHECK_FALSE(program.has(*widget, *gadget->cppEntitySet.begin()));
+  CHECK(program.searchTypeNode("Gadget", outer) == gadget);
+}
+
+TEST_CASE("Type tree built in parallel is same as one built serially")
+{
+  cppparser::CppProgram serialProgram({});
+  for (auto& fileAst : MakeFileAsts())
+  {
+    if (fileAst)
+      serialProgram.addCppFile(std::move(fileAst));
+  }
+
+  cppparser::CppProgram parallelProgram({});
+  parallelProgram.addCppFiles(MakeFileAsts(), 4);
+
+  CHECK(parallelProgram.getFileAsts().size() == serialProgram.getFileAsts().size());
+  CHECK(parallelProgram.searchTypeNodes("Item").size() == 3);
+  CHECK(parallelProgram.nameLookup("Outer::Widget")->cppEntitySet.size() == 16);
+  // Entities merged on different threads are indexed too.
+  const auto* widget = parallelProgram.nameLookup("Outer::Widget");
+  for (const auto* widgetEnt : widget->cppEntitySet)
+    CHECK(parallelProgram.typeTreeNodeFromCppEntity(widgetEnt) == widget);
+  CHECK(parallelProgram.searchTypeNode("Item7", parallelProgram.nameLookup("Outer")) != nullptr);
+  CHECK(DumpTypeTree(parallelProgram, *parallelProgram.nameLookup(""))
+        == DumpTypeTree(serialProgram, *serialProgram.nameLookup("")));
+
+  cppparser::CppProgram singleThreadProgram({});
+  singleThreadProgram.addCppFiles(MakeFileAsts(), 1);
+  CHECK(DumpTypeTree(singleThreadProgram, *singleThreadProgram.nameLookup(""))
+        == DumpTypeTree(serialProgram, *serialProgram.nameLookup("")));
+}
+
+TEST_CASE("Included files are parsed once and shared by all includers")
+{
+  namespace fs = std::filesystem;
+
+  const auto testDir = fs::temp_directory_path() / "cppparser-include-graph-test";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir / "src");
+  fs::create_directories(testDir / "include" / "lib");
+  fs::create_directories(testDir / "include" / "copy");
+
+  const auto writeFile = [](const fs::path& path, const char* content) { std::ofstream(path) << content; };
+  writeFile(testDir / "src" / "main.cpp",
+            "#include \"local.h\"\n#include <lib/common.h>\n#include <not_found.h>\nclass Main {};\n");
+  writeFile(testDir / "src" / "local.h",
+            "#pragma once\n#include <lib/common.h>\n#include <copy/common.h>\nclass Local {};\n");
+  writeFile(testDir / "include" / "lib" / "common.h",
+            "#ifndef COMMON_H\n#define COMMON_H\nnamespace lib { class Common {}; }\n#endif\n");
+  writeFile(testDir / "include" / "copy" / "common.h",
+            "#ifndef COMMON_H\n#define COMMON_H\nnamespace lib { class CommonCopy {}; }\n#endif\n");
+
+  const auto mainFile       = fs::weakly_canonical(testDir / "src" / "main.cpp").string();
+  const auto localFile      = fs::weakly_canonical(testDir / "src" / "local.h").string();
+  const auto commonFile     = fs::weakly_canonical(testDir / "include" / "lib" / "common.h").string();
+  const auto commonCopyFile = fs::weakly_canonical(testDir / "include" / "copy" / "common.h").string();
+
+  cppparser::CppProgram program({});
+  program.addSourceFiles(
+    {(testDir / "src" / "main.cpp").string()}, {(testDir / "include").string()}, cppparser::CppParser(), 2);
+
+  REQUIRE(program.getFileAsts().size() == 4);
+  CHECK(program.getFileAsts()[0]->name() == mainFile);
+  CHECK(program.includedFiles(mainFile) == std::vector<std::string> {localFile, commonFile});
+  CHECK(program.includedFiles(localFile) == std::vector<std::string> {commonFile, commonCopyFile});
+  CHECK(program.includedFiles(commonFile).empty());
+
+  CHECK(program.fileAst(localFile) != nullptr);
+  CHECK(program.fileAst(commonFile) != nullptr);
+  // Unrelated files using same guard macro are both part of the program.
+  CHECK(program.fileAst(commonCopyFile) != nullptr);
+  CHECK(program.nameLookup("lib::CommonCopy") != nullptr);
+
+  const auto* common = program.nameLookup("lib::Common");
+  REQUIRE(common != nullptr);
+  CHECK(common->cppEntitySet.size() == 1);
+  CHECK(program.nameLookup("Local") != nullptr);
+
+  fs::remove_all(testDir);
+}
+
+TEST_CASE("Names of all files of a program are interned in one symbol table")
+{
+  namespace fs = std::filesystem;
+
+  const auto testDir = fs::temp_directory_path() / "cppparser-symbol-table-test";
+  fs::remove_all(testDir);
+  fs::create_directories(testDir);
+  std::ofstream(testDir / "a.h") << "namespace A { class Point { int x; }; }\n";
+  std::ofstream(testDir / "b.h") << "namespace B { class Point { int y; }; }\n";
+
+  cppparser::CppProgram program({});
+  // Files parsed with different parsers still share the table of the program.
+  program.addSourceFiles({(testDir / "a.h").string()}, {}, cppparser::CppParser());
+  program.addSourceFiles({(testDir / "b.h").string()}, {}, cppparser::CppParser());
+
+  const auto* pointA = program.nameLookup("A::Point");
+  const auto* pointB = program.nameLookup("B::Point");
+  REQUIRE(pointA != nullptr);
+  REQUIRE(pointB != nullptr);
+  REQUIRE(pointA->cppEntitySet.size() == 1);
+  REQUIRE(pointB->cppEntitySet.size() == 1);
+  const auto& classA = static_cast<const cppast::CppCompound&>(**pointA->cppEntitySet.begin());
+  const auto& classB = static_cast<const cppast::CppCompound&>(**pointB->cppEntitySet.begin());
+  CHECK(classA.nameSymbol() == classB.nameSymbol());
+  CHECK(&classA.name() == &classB.name());
+
+  REQUIRE(program.symbolTable() != nullptr);
+  const auto stats = program.symbolTable()->stats();
+  CHECK(stats.numSymbols < stats.numInterned);
+
+  fs::remove_all(testDir);
+}
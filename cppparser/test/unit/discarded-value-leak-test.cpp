@@ -0,0 +1,221 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+#include <string>
+#include <vector>
+
+namespace {
+
+std::atomic<long> gNumLiveAllocations {0};
+
+} // namespace
+
+// Counting allocations of the whole test program is the portable way to cap the memory used by repeated parsing.
+// It is a program of its own, so, nothing but this test is counted.
+void* operator new(std::size_t size)
+{
+  if (auto* mem = std::malloc(size ? size : 1))
+  {
+    ++gNumLiveAllocations;
+    return mem;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept
+{
+  if (ptr)
+    --gNumLiveAllocations;
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+  operator delete(ptr);
+}
+
+// Entities are allocated with alignment, so, those allocations must be counted too.
+void* operator new(std::size_t size, std::align_val_t alignment)
+{
+  const auto align = static_cast<std::size_t>(alignment);
+  if (auto* mem = std::malloc(size + align + sizeof(void*)))
+  {
+    // Pointer to the allocated block is kept just before the aligned memory.
+    const auto addr = (reinterpret_cast<std::uintptr_t>(mem) + sizeof(void*) + align - 1) & ~(align - 1);
+    reinterpret_cast<void**>(addr)[-1] = mem;
+    ++gNumLiveAllocations;
+    return reinterpret_cast<void*>(addr);
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr, std::align_val_t) noexcept
+{
+  if (ptr)
+  {
+    --gNumLiveAllocations;
+    std::free(static_cast<void**>(ptr)[-1]);
+  }
+}
+
+void operator delete(void* ptr, std::size_t, std::align_val_t alignment) noexcept
+{
+  operator delete(ptr, alignment);
+}
+
+class DiscardedValueLeakTest : public EmbeddedSnippetTestBase
+{
+protected:
+  DiscardedValueLeakTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+
+  /**
+   * @return Growth in number of live allocations after parsing given erroneous streams many times.
+   * @note Whatever a parser keeps for reuse, e.g. interned names, is allocated while warming up.
+   */
+  static long allocationGrowthAfterRepeatedParsing(const std::vector<std::string>& testSnippets)
+  {
+    constexpr int numWarmUpIterations = 8;
+    constexpr int numIterations       = 2000;
+
+    cppparser::CppParser parser;
+    parser.setErrorHandler([](const char*, size_t, size_t, int) {});
+
+    const auto parseAll = [&]() {
+      for (auto testSnippet : testSnippets)
+        parser.parseStream(testSnippet.data(), testSnippet.size());
+    };
+
+    for (int i = 0; i < numWarmUpIterations; ++i)
+      parseAll();
+    const auto numLiveAllocationsBefore = gNumLiveAllocations.load();
+    for (int i = 0; i < numIterations; ++i)
+      parseAll();
+
+    return gNumLiveAllocations.load() - numLiveAllocationsBefore;
+  }
+};
+
+TEST_CASE_METHOD(DiscardedValueLeakTest, "No leak when parsing fails")
+{
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  callFunc(x, y, ); // Error should be reported for the position of ')'
+#  endif
+#endif
+  const auto errorInExpr = getTestSnippetParseStream(__LINE__ - 2);
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  namespace ns {
+  template <typename T>
+  class LeakTestClass : public Base<T>
+  {
+  public:
+    LeakTestClass(int x)
+      : x_(x)
+    {
+    }
+    int Method(const std::vector<int>& v) const
+    {
+      for (auto i : v)
+      {
+        if (i > x_)
+          return i * (x_ + 1);
+      }
+      return Other(v, [](int a) { return a + 2; }, );
+    }
+
+  private:
+    int x_;
+  };
+  } // namespace ns
+#  endif
+#endif
+  const auto errorInNestedScope = getTestSnippetParseStream(__LINE__ - 2);
+
+  CHECK(allocationGrowthAfterRepeatedParsing({errorInExpr, errorInNestedScope}) == 0);
+}
+
+TEST_CASE_METHOD(DiscardedValueLeakTest, "No leak when parser backtracks or abandons values of other kinds")
+{
+  // Ambiguous inputs from expr-test and template-test that make the parser backtrack before it succeeds.
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  C<v != 0> x;
+  C<Class, v != 0> y;
+  b = x > y;
+#  endif
+#endif
+  const auto ambiguousInput = getTestSnippetParseStream(__LINE__ - 2);
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  enum class Color : int
+  {
+    RED = 1,
+    GREEN = ,
+    BLUE
+  };
+#  endif
+#endif
+  const auto errorInEnum = getTestSnippetParseStream(__LINE__ - 2);
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  template <typename T, int N = >
+  class Array;
+#  endif
+#endif
+  const auto errorInTemplateParams = getTestSnippetParseStream(__LINE__ - 2);
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  /// Documented point.
+  struct Point
+  {
+    int x;
+    int y;
+  };
+  Point p = {.x = 4, .y = };
+#  endif
+#endif
+  const auto errorInInitializerList = getTestSnippetParseStream(__LINE__ - 2);
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  if EVADE_COMPILER
+  void Func(int i) try
+  {
+    switch (i)
+    {
+    case 1:
+      while (i--)
+        do_something(i);
+      break;
+    default:
+      throw std::runtime_error("failed" ) );
+    }
+  }
+  catch (...)
+  {
+  }
+#  endif
+#endif
+  const auto errorInStatements = getTestSnippetParseStream(__LINE__ - 2);
+
+  CHECK(allocationGrowthAfterRepeatedParsing(
+          {ambiguousInput, errorInEnum, errorInTemplateParams, errorInInitializerList, errorInStatements})
+        == 0);
+}
@@ -0,0 +1,64 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "identifier-table.h"
+
+#include <string>
+#include <string_view>
+
+using cppparser::IdentifierKind;
+
+TEST_CASE("Identifier table classifies identifiers")
+{
+  cppparser::IdentifierTable identifiers;
+  CHECK(identifiers.classify("anything").kind == IdentifierKind::Name);
+
+  identifiers.add("DECLARE_CLASS", IdentifierKind::Macro);
+  identifiers.add("DLL_EXPORT", IdentifierKind::ApiDecor);
+  identifiers.add("IGNORE_ME", IdentifierKind::IgnorableMacro);
+  identifiers.add("SEALED_VIRTUAL", IdentifierKind::RenamedKeyword, 42);
+
+  CHECK(identifiers.classify("DECLARE_CLASS").kind == IdentifierKind::Macro);
+  CHECK(identifiers.classify("DLL_EXPORT").kind == IdentifierKind::ApiDecor);
+  CHECK(identifiers.classify("IGNORE_ME").kind == IdentifierKind::IgnorableMacro);
+  CHECK(identifiers.classify("SEALED_VIRTUAL").kind == IdentifierKind::RenamedKeyword);
+  CHECK(identifiers.classify("SEALED_VIRTUAL").keywordId == 42);
+  CHECK(identifiers.classify("DECLARE").kind == IdentifierKind::Name);
+
+  // Lexer classifies the token right inside the input buffer.
+  const std::string_view buffer = "DLL_EXPORT int";
+  CHECK(identifiers.classify(buffer.substr(0, 10)).kind == IdentifierKind::ApiDecor);
+  CHECK(identifiers.classify(buffer.substr(0, 9)).kind == IdentifierKind::Name);
+}
+
+TEST_CASE("Identifier table keeps identifier kind of highest precedence")
+{
+  cppparser::IdentifierTable identifiers;
+
+  identifiers.add("BOTH_MACRO_AND_DECOR", IdentifierKind::ApiDecor);
+  identifiers.add("BOTH_MACRO_AND_DECOR", IdentifierKind::Macro);
+  CHECK(identifiers.classify("BOTH_MACRO_AND_DECOR").kind == IdentifierKind::Macro);
+
+  identifiers.add("IGNORABLE", IdentifierKind::IgnorableMacro);
+  identifiers.add("IGNORABLE", IdentifierKind::Macro);
+  CHECK(identifiers.classify("IGNORABLE").kind == IdentifierKind::IgnorableMacro);
+
+  identifiers.add("OVERRIDE", IdentifierKind::RenamedKeyword, 1);
+  identifiers.add("OVERRIDE", IdentifierKind::RenamedKeyword, 2);
+  CHECK(identifiers.classify("OVERRIDE").keywordId == 1);
+}
+
+TEST_CASE("Identifier table grows")
+{
+  cppparser::IdentifierTable identifiers;
+
+  constexpr int numIdentifiers = 1000;
+  for (int i = 0; i < numIdentifiers; ++i)
+    identifiers.add("API_DECOR_" + std::to_string(i), IdentifierKind::ApiDecor);
+
+  for (int i = 0; i < numIdentifiers; ++i)
+    CHECK(identifiers.classify("API_DECOR_" + std::to_string(i)).kind == IdentifierKind::ApiDecor);
+  CHECK(identifiers.classify("API_DECOR_" + std::to_string(numIdentifiers)).kind == IdentifierKind::Name);
+}
@@ -0,0 +1,176 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "file-buffer.h"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+
+TEST_CASE("CRLF line endings are handled by lexer")
+{
+  const std::string lfContent = "#define LINE_ENDING_MACRO 10\n"
+                                "#if LINE_ENDING_MACRO > 5\n"
+                                "// Line comment\n"
+                                "int x;\n"
+                                "#endif\n"
+                                "#pragma once\n";
+  std::string crlfContent;
+  for (const auto c : lfContent)
+  {
+    if (c == '\n')
+      crlfContent += '\r';
+    crlfContent += c;
+  }
+
+  cppparser::CppParser parser;
+  const auto           lfAst   = parser.parseStream(lfContent.data(), lfContent.size());
+  const auto           crlfAst = parser.parseStream(crlfContent.data(), crlfContent.size());
+  REQUIRE(lfAst != nullptr);
+  REQUIRE(crlfAst != nullptr);
+
+  const auto lfMembers   = GetAllOwnedEntities(*lfAst);
+  const auto crlfMembers = GetAllOwnedEntities(*crlfAst);
+  REQUIRE(crlfMembers.size() == lfMembers.size());
+
+  for (size_t i = 0; i < lfMembers.size(); ++i)
+  {
+    CHECK(crlfMembers[i]->entityType() == lfMembers[i]->entityType());
+    if (cppast::CppConstPreprocessorDefineEPtr lfDefine = lfMembers[i])
+    {
+      cppast::CppConstPreprocessorDefineEPtr crlfDefine = crlfMembers[i];
+      REQUIRE(crlfDefine);
+      CHECK(crlfDefine->definition() == lfDefine->definition());
+    }
+    else if (cppast::CppConstPreprocessorConditionalEPtr lfConditional = lfMembers[i])
+    {
+      cppast::CppConstPreprocessorConditionalEPtr crlfConditional = crlfMembers[i];
+      REQUIRE(crlfConditional);
+      CHECK(crlfConditional->condition() == lfConditional->condition());
+    }
+    else if (cppast::CppConstPreprocessorPragmaEPtr lfPragma = lfMembers[i])
+    {
+      cppast::CppConstPreprocessorPragmaEPtr crlfPragma = crlfMembers[i];
+      REQUIRE(crlfPragma);
+      CHECK(crlfPragma->definition() == lfPragma->definition());
+    }
+    else if (cppast::CppConstDocumentationCommentEPtr lfComment = lfMembers[i])
+    {
+      cppast::CppConstDocumentationCommentEPtr crlfComment = crlfMembers[i];
+      REQUIRE(crlfComment);
+      CHECK(crlfComment->str() == lfComment->str());
+    }
+  }
+}
+
+TEST_CASE("Read only stream need not be null terminated")
+{
+  const std::string content = "#define READ_ONLY_STREAM_MACRO (1 + 2)\n"
+                              "int f();";
+
+  cppparser::CppParser parser;
+  parser.shareSourceBuffer(true);
+  const auto ast = parser.parseStream(static_cast<const char*>(content.data()), content.size());
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 2);
+
+  cppast::CppConstPreprocessorDefineEPtr define = members[0];
+  REQUIRE(define);
+  CHECK(define->definition() == "(1 + 2)");
+  // Scanning happens on a copy but the shared text is a view into the caller's stream.
+  CHECK(define->definitionView().data() >= content.data());
+  CHECK(define->definitionView().data() + define->definitionView().size() <= content.data() + content.size());
+
+  CHECK(cppast::CppConstFunctionEPtr(members[1]));
+}
+
+TEST_CASE("File ending at page boundary")
+{
+  namespace fs = std::filesystem;
+
+  // Multiple of all common page sizes, so, there is no slack after the mapped file for the terminating characters.
+  constexpr size_t  fileSize = 64 * 1024;
+  const std::string lastLine = "#define PAGE_BOUNDARY_MACRO 1";
+
+  const auto path = (fs::temp_directory_path() / "cppparser-page-boundary-test.h").string();
+  {
+    std::ofstream stm(path, std::ios::out | std::ios::binary);
+    stm << "int x;" << std::string(fileSize - lastLine.size() - 6, '\n') << lastLine;
+  }
+  REQUIRE(fs::file_size(path) == fileSize);
+
+  cppparser::CppParser parser;
+  const auto           ast = parser.parseFile(path);
+  fs::remove(path);
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 2);
+
+  cppast::CppConstPreprocessorDefineEPtr define = members[1];
+  REQUIRE(define);
+  CHECK(define->definition() == "1");
+}
+
+TEST_CASE("Carriage returns of a file are stripped unless the AST shares the file")
+{
+  namespace fs = std::filesystem;
+
+  const std::string content = "void FunctionWithBlobBody(int a)\r\n{\r\n  a = 0;\r\n}\r\n";
+  const auto        path    = (fs::temp_directory_path() / "cppparser-crlf-file-test.h").string();
+  std::ofstream(path, std::ios::out | std::ios::binary) << content;
+
+  const auto hasCarriageReturn = [](std::string_view text) { return text.find('\r') != std::string_view::npos; };
+
+  FileBuffer copiedBuffer(path, false);
+  CHECK(std::string_view(copiedBuffer.data(), copiedBuffer.size())
+        == "void FunctionWithBlobBody(int a)\n{\n  a = 0;\n}\n\n" + std::string(2, '\0'));
+
+  FileBuffer sharedBuffer(path, true);
+  CHECK(std::string_view(sharedBuffer.data(), sharedBuffer.size()) == content + "\n" + std::string(2, '\0'));
+
+  const auto parseBlob = [&path](bool shareSourceBuffer) {
+    cppparser::CppParser parser;
+    parser.parseFunctionBodyAsBlob(true);
+    parser.shareSourceBuffer(shareSourceBuffer);
+    auto ast = parser.parseFile(path);
+    REQUIRE(ast != nullptr);
+
+    const auto members = GetAllOwnedEntities(*ast);
+    REQUIRE(members.size() == 1);
+    cppast::CppConstFunctionEPtr func = members[0];
+    REQUIRE(func);
+    REQUIRE(func->defn() != nullptr);
+    const auto bodyMembers = GetAllOwnedEntities(*func->defn());
+    REQUIRE(bodyMembers.size() == 1);
+    cppast::CppConstBlobEPtr blob = bodyMembers[0];
+    REQUIRE(blob);
+
+    return std::make_pair(std::move(ast), blob->blobView());
+  };
+
+  const auto copied = parseBlob(false);
+  CHECK(copied.second.find("a = 0;") != std::string_view::npos);
+  CHECK_FALSE(hasCarriageReturn(copied.second));
+
+  // Shared texts are views into the file as it is.
+  const auto shared = parseBlob(true);
+  CHECK(hasCarriageReturn(shared.second));
+
+  fs::remove(path);
+}
+
+TEST_CASE("Missing file gives an empty buffer")
+{
+  FileBuffer buffer("cppparser-missing-file-test.h", false);
+  CHECK(buffer.data() == nullptr);
+  CHECK(buffer.size() == 0);
+}
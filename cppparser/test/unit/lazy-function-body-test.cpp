@@ -0,0 +1,177 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+class LazyFunctionBodyTest : public EmbeddedSnippetTestBase
+{
+protected:
+  LazyFunctionBodyTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+};
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+int LazilyParsedFunction(int x)
+{
+  if (x > 0)
+    x = -x;
+  return x + 1;
+}
+
+class LazilyParsedClass
+{
+public:
+  LazilyParsedClass()
+    : member_(0)
+  {
+    member_ = 1;
+  }
+
+  void DeclaredOnly();
+
+private:
+  int member_;
+};
+#endif
+static const int kSnippetLastLine = __LINE__ - 2;
+
+TEST_CASE_METHOD(LazyFunctionBodyTest, "Function bodies are parsed on first access")
+{
+  const auto testSnippet = getTestSnippetParseStream(kSnippetLastLine);
+
+  cppparser::CppParser eagerParser;
+  auto                 eagerStm = testSnippet;
+  const auto           eagerAst = eagerParser.parseStream(eagerStm.data(), eagerStm.size());
+  REQUIRE(eagerAst != nullptr);
+
+  cppparser::CppParser lazyParser;
+  lazyParser.parseFunctionBodyLazily(true);
+  auto       lazyStm = testSnippet;
+  const auto lazyAst = lazyParser.parseStream(lazyStm.data(), lazyStm.size());
+  REQUIRE(lazyAst != nullptr);
+
+  const auto eagerMembers = GetAllOwnedEntities(*eagerAst);
+  const auto lazyMembers  = GetAllOwnedEntities(*lazyAst);
+  REQUIRE(lazyMembers.size() == 2);
+  REQUIRE(eagerMembers.size() == lazyMembers.size());
+
+  cppast::CppConstFunctionEPtr eagerFunc = eagerMembers[0];
+  cppast::CppConstFunctionEPtr lazyFunc  = lazyMembers[0];
+  REQUIRE(eagerFunc);
+  REQUIRE(lazyFunc);
+  REQUIRE(lazyFunc->hasDefn());
+  REQUIRE(lazyFunc->defn() != nullptr);
+  CHECK(lazyFunc->defn()->compoundType() == cppast::CppCompoundType::BLOCK);
+
+  const auto eagerBody = GetAllOwnedEntities(*eagerFunc->defn());
+  const auto lazyBody  = GetAllOwnedEntities(*lazyFunc->defn());
+  REQUIRE(lazyBody.size() == 2);
+  REQUIRE(eagerBody.size() == lazyBody.size());
+  for (size_t i = 0; i < lazyBody.size(); ++i)
+    CHECK(lazyBody[i]->entityType() == eagerBody[i]->entityType());
+  CHECK(lazyBody[0]->entityType() == cppast::CppEntityType::IF_BLOCK);
+  cppast::CppConstReturnStatementEPtr ret = lazyBody[1];
+  CHECK(ret);
+
+  cppast::CppConstCompoundEPtr cls = lazyMembers[1];
+  REQUIRE(cls);
+  size_t numCtors = 0;
+  for (const auto& member : GetAllOwnedEntities(*cls))
+  {
+    cppast::CppConstConstructorEPtr ctor = member;
+    cppast::CppConstFunctionEPtr    func = member;
+    if (ctor)
+    {
+      ++numCtors;
+      CHECK(ctor->hasMemberInitList());
+      REQUIRE(ctor->hasDefn());
+      const auto ctorBody = GetAllOwnedEntities(*ctor->defn());
+      REQUIRE(ctorBody.size() == 1);
+      cppast::CppConstExpressionEPtr assignment = ctorBody[0];
+      CHECK(assignment);
+    }
+    else if (func)
+    {
+      CHECK(func->name() == "DeclaredOnly");
+      CHECK(!func->hasDefn());
+      CHECK(func->defn() == nullptr);
+    }
+  }
+  CHECK(numCtors == 1);
+}
+
+TEST_CASE_METHOD(LazyFunctionBodyTest, "Function body is parsed once when accessed from many threads")
+{
+  const auto testSnippet = getTestSnippetParseStream(kSnippetLastLine);
+
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyLazily(true);
+  parser.allocateEntitiesFromArena(true);
+  parser.shareSourceBuffer(true);
+  const auto ast = parser.parseStream(static_cast<const char*>(testSnippet.data()), testSnippet.size());
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 2);
+  cppast::CppConstFunctionEPtr func = members[0];
+  REQUIRE(func);
+
+  constexpr size_t                        numThreads = 8;
+  std::vector<const cppast::CppCompound*> defns(numThreads, nullptr);
+  std::vector<std::thread>                threads;
+  for (size_t i = 0; i < numThreads; ++i)
+    threads.emplace_back([&, i]() { defns[i] = func->defn(); });
+  for (auto& t : threads)
+    t.join();
+
+  REQUIRE(defns[0] != nullptr);
+  for (const auto* defn : defns)
+    CHECK(defn == defns[0]);
+  CHECK(GetAllOwnedEntities(*defns[0]).size() == 2);
+}
+
+TEST_CASE_METHOD(LazyFunctionBodyTest, "Function body is not parsed while another stream is being parsed")
+{
+  const auto testSnippet = getTestSnippetParseStream(kSnippetLastLine);
+
+  cppparser::CppParser lazyParser;
+  lazyParser.parseFunctionBodyLazily(true);
+  const auto ast = lazyParser.parseStream(static_cast<const char*>(testSnippet.data()), testSnippet.size());
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 2);
+  cppast::CppConstFunctionEPtr func = members[0];
+  REQUIRE(func);
+
+  bool                 errorHandlerCalled = false;
+  cppparser::CppParser parser;
+  parser.setErrorHandler([&](const char*, size_t, size_t, int) {
+    errorHandlerCalled = true;
+    CHECK_THROWS_AS(func->defn(), std::logic_error);
+  });
+  const std::string faultyStm = "callFunc(x, y, );";
+  try
+  {
+    parser.parseStream(faultyStm.data(), faultyStm.size());
+  }
+  catch (const std::exception&)
+  {
+  }
+  CHECK(errorHandlerCalled);
+
+  // Failed access does not spoil the definition.
+  REQUIRE(func->defn() != nullptr);
+  CHECK(GetAllOwnedEntities(*func->defn()).size() == 2);
+}
@@ -0,0 +1,116 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+// Lexer skips disabled code, block comments, and function bodies with text scanner and counts lines itself.
+// So, those paths are tested with every line ending a file can have.
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include <exception>
+#include <initializer_list>
+#include <string>
+
+namespace {
+
+std::string JoinLines(std::initializer_list<const char*> lines, const char* lineEnding)
+{
+  std::string source;
+  for (const auto* line : lines)
+    source.append(line).append(lineEnding);
+  return source;
+}
+
+// Lines that make the lexer skip text: disabled code, block comments, and function body skipped till '}'.
+std::string SkippedTextSource(const char* lineEnding)
+{
+  return JoinLines(
+    {
+      "#if 0",
+      "int disabledVar; /* comment in disabled code */",
+      "#endif",
+      "/* Block comment",
+      "   spread over lines */",
+      "void FunctionWithBlobBody(int a)",
+      "{",
+      "  if (a) { a = 0; }",
+      "}",
+      "int lastVar;",
+    },
+    lineEnding);
+}
+
+// Same as above but without preprocessor directives, which must be at beginning of a line that ends with '\n'.
+std::string SkippedBodySource(const char* lineEnding)
+{
+  return JoinLines(
+    {
+      "void FunctionWithBlobBody(int a)",
+      "{",
+      "  if (a) { a = 0; }",
+      "",
+      "  return;",
+      "}",
+      "int lastVar;",
+    },
+    lineEnding);
+}
+
+size_t ErrorLineNum(const std::string& source)
+{
+  size_t               errorLineNum = 0;
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyAsBlob(true);
+  parser.setErrorHandler([&errorLineNum](const char*, size_t lineNum, size_t, int) { errorLineNum = lineNum; });
+  try
+  {
+    parser.parseStream(source.data(), source.size());
+  }
+  catch (const std::exception&)
+  {
+  }
+
+  return errorLineNum;
+}
+
+void CheckParsedSource(const std::string& source)
+{
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyAsBlob(true);
+  const auto ast = parser.parseStream(source.data(), source.size());
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(!members.empty());
+
+  cppast::CppConstVarEPtr lastVar = members.back();
+  REQUIRE(lastVar);
+  CHECK(lastVar->name() == "lastVar");
+
+  cppast::CppConstFunctionEPtr func = members[members.size() - 2];
+  REQUIRE(func);
+  CHECK(func->defn() != nullptr);
+}
+
+} // namespace
+
+TEST_CASE("Skipped text with CRLF line endings", "[skip-scan]")
+{
+  for (const auto* lineEnding : {"\n", "\r\n"})
+  {
+    INFO("Line ending of length " << std::string(lineEnding).size());
+    CheckParsedSource(SkippedTextSource(lineEnding));
+    CHECK(ErrorLineNum(SkippedTextSource(lineEnding) + "callFunc(x, y, );") == 11);
+  }
+}
+
+TEST_CASE("Skipped function body with lone CR line endings", "[skip-scan]")
+{
+  for (const auto* lineEnding : {"\n", "\r\n", "\r"})
+  {
+    INFO("Line ending of length " << std::string(lineEnding).size() << " starting with " << int(lineEnding[0]));
+    CheckParsedSource(SkippedBodySource(lineEnding));
+    CHECK(ErrorLineNum(SkippedBodySource(lineEnding) + "callFunc(x, y, );") == 8);
+  }
+}
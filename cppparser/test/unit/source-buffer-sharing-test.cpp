@@ -0,0 +1,64 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "cppparser/cppparser.h"
+
+#include "embedded-snippet-test-base.h"
+
+#include <string>
+#include <string_view>
+
+class SourceBufferSharingTest : public EmbeddedSnippetTestBase
+{
+protected:
+  SourceBufferSharingTest()
+    : EmbeddedSnippetTestBase(__FILE__)
+  {
+  }
+};
+
+#if TEST_CASE_SNIPPET_STARTS_FROM_NEXT_LINE
+#  define SHARED_SOURCE_MACRO(a, b) ((a) + (b))
+int FunctionWithBlobBody(int x)
+{
+  if (x > 0)
+    x = -x;
+  return SHARED_SOURCE_MACRO(x, 1);
+}
+#endif
+
+TEST_CASE_METHOD(SourceBufferSharingTest, "Texts are views into source buffer")
+{
+  auto testSnippet = getTestSnippetParseStream(__LINE__ - 5);
+
+  const auto isInsideSnippet = [&testSnippet](std::string_view text) {
+    return (text.data() >= testSnippet.data()) && (text.data() + text.size() <= testSnippet.data() + testSnippet.size());
+  };
+
+  cppparser::CppParser parser;
+  parser.parseFunctionBodyAsBlob(true);
+  parser.shareSourceBuffer(true);
+  const auto ast = parser.parseStream(testSnippet.data(), testSnippet.size());
+  REQUIRE(ast != nullptr);
+
+  const auto members = GetAllOwnedEntities(*ast);
+  REQUIRE(members.size() == 2);
+
+  cppast::CppConstPreprocessorDefineEPtr define = members[0];
+  REQUIRE(define);
+  CHECK(define->definition().find("((a) + (b))") != std::string_view::npos);
+  CHECK(isInsideSnippet(define->definitionView()));
+
+  cppast::CppConstFunctionEPtr func = members[1];
+  REQUIRE(func);
+  REQUIRE(func->defn() != nullptr);
+  const auto bodyMembers = GetAllOwnedEntities(*func->defn());
+  REQUIRE(bodyMembers.size() == 1);
+
+  cppast::CppConstBlobEPtr blob = bodyMembers[0];
+  REQUIRE(blob);
+  CHECK(blob->blob().find("x = -x;") != std::string_view::npos);
+  CHECK(isInsideSnippet(blob->blobView()));
+}
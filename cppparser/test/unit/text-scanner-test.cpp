@@ -0,0 +1,80 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include <catch/catch.hpp>
+
+#include "text-scanner.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+static std::vector<ScannerIsa> SupportedScannerIsas()
+{
+  std::vector<ScannerIsa> isas;
+  for (const auto isa : {ScannerIsa::Scalar, ScannerIsa::Sse2, ScannerIsa::Avx2})
+  {
+    if (isa <= BestScannerIsa())
+      isas.push_back(isa);
+  }
+
+  return isas;
+}
+
+TEST_CASE("Scanning stops at stop char and counts new lines before it")
+{
+  const std::string text = std::string("int x;\r\n  // comment\r  int y;\n#endif\n") + '\0';
+
+  for (const auto isa : SupportedScannerIsas())
+  {
+    const auto scan = ScanTill(text.data(), text.data() + text.size(), "#/", isa);
+    REQUIRE(scan.stop == text.data() + text.find('/'));
+    CHECK(scan.numNewLines == 1);
+    CHECK(scan.lastLineFeed == text.data() + text.find('\n'));
+
+    const auto nextScan = ScanTill(scan.stop + 2, text.data() + text.size(), "#", isa);
+    REQUIRE(nextScan.stop == text.data() + text.find('#'));
+    CHECK(nextScan.numNewLines == 2);
+    CHECK(nextScan.lastLineFeed == text.data() + text.find('\n', text.find("int y")));
+
+    const auto endScan = ScanTill(nextScan.stop + 1, text.data() + text.size(), "", isa);
+    CHECK(endScan.stop == text.data() + text.size() - 1);
+    CHECK(endScan.numNewLines == 1);
+  }
+}
+
+TEST_CASE("Vectorized scanning agrees with scalar one")
+{
+  std::mt19937 rng(20221108);
+  const char   alphabet[] = "ab \t\r\n{}/*#";
+
+  const auto isas = SupportedScannerIsas();
+  for (int i = 0; i < 200; ++i)
+  {
+    std::string text(std::uniform_int_distribution<size_t>(0, 300)(rng), ' ');
+    for (auto& c : text)
+      c = alphabet[std::uniform_int_distribution<size_t>(0, sizeof(alphabet) - 2)(rng)];
+    text.append(2, '\0');
+
+    for (const char* stopChars : {"#", "/#", "*#", "{}/#"})
+    {
+      const auto expected = ScanTill(text.data(), text.data() + text.size(), stopChars, ScannerIsa::Scalar);
+      for (const auto isa : isas)
+      {
+        const auto scan = ScanTill(text.data(), text.data() + text.size(), stopChars, isa);
+        CHECK(scan.stop == expected.stop);
+        CHECK(scan.lastLineFeed == expected.lastLineFeed);
+        CHECK(scan.numNewLines == expected.numNewLines);
+      }
+    }
+  }
+}
+
+TEST_CASE("Matched closing bracket")
+{
+  const std::string text = std::string("a, (b), ((c)))d") + '\0';
+  const auto        end  = text.data() + text.size();
+
+  CHECK(FindMatchedClosingBracket(text.data(), end, '(', ')') == text.data() + text.size() - 3);
+  CHECK(*FindMatchedClosingBracket(text.data() + text.size() - 2, end, '(', ')') == '\0');
+}
@@ -157,6 +157,10 @@ void gen_yydestruct()
 				       "YYPOSN *pos) {\n"
 		       "    switch(sym) {\n");
     for (bp = first_symbol; bp; bp = bp->next) {
+	/* Value of a mid-rule action is whatever was on the top of stack
+	 * unless the action sets it, so, it gets destructor only if asked for. */
+	if (bp->class == ACTION && !bp->dtor)
+	    continue;
 	dtor = bp->dtor;
 	if (!dtor && bp->tag)
 	    dtor = bp->tag->dtor;
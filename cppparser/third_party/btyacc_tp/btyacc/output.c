@@ -898,12 +898,18 @@ void output_defines()
 	  putc(c, defines_file);
 	}
 	if (unionized)
-	    fprintf(defines_file, "extern YYSTYPE %slval;\n", symbol_prefix);
+	    fprintf(defines_file, "#ifndef YYTHREADLOCAL\n"
+				  "#define YYTHREADLOCAL\n"
+				  "#endif\n"
+				  "extern YYTHREADLOCAL YYSTYPE %slval;\n", symbol_prefix);
     }
 
     if(dflag) {
-	fprintf(defines_file, "#if defined(YYPOSN)\n"
-			      "extern YYPOSN yyposn;\n"
+	fprintf(defines_file, "#ifndef YYTHREADLOCAL\n"
+			      "#define YYTHREADLOCAL\n"
+			      "#endif\n"
+			      "#if defined(YYPOSN)\n"
+			      "extern YYTHREADLOCAL YYPOSN yyposn;\n"
 			      "#endif\n");
 	fprintf(defines_file, "\n#endif\n");
     }
@@ -111,24 +111,30 @@ static char *header[] =
     "#define YYDEFSTACKSIZE 12",
     "#endif",
     "",
+    "/* Storage class of the parser globals, e.g. define it as thread_local to */",
+    "/* allow independent parses to run concurrently on different threads.   */",
+    "#ifndef YYTHREADLOCAL",
+    "#define YYTHREADLOCAL",
+    "#endif",
+    "",
     "#ifdef YYDEBUG",
-    "int yydebug;",
+    "YYTHREADLOCAL int yydebug;",
     "#endif",
     "",
     "extern void yyerror(const char *, ...);",
     "",
-    "int yynerrs;",
+    "YYTHREADLOCAL int yynerrs;",
     "",
     "/* These value/posn are taken from the lexer */",
-    "YYSTYPE yylval;",
+    "YYTHREADLOCAL YYSTYPE yylval;",
     "#ifdef YYPOSN",
-    "YYPOSN  yyposn;",
+    "YYTHREADLOCAL YYPOSN  yyposn;",
     "#endif /* YYPOSN */",
     "",
     "/* These value/posn of the root non-terminal are returned to the caller */",
-    "YYSTYPE yyretlval;",
+    "YYTHREADLOCAL YYSTYPE yyretlval;",
     "#ifdef YYPOSN",
-    "YYPOSN  yyretposn;",
+    "YYTHREADLOCAL YYPOSN  yyretposn;",
     "#endif /* YYPOSN */",
     "",
     "#define YYABORT  goto yyabort",
@@ -159,41 +165,41 @@ static char *header[] =
     "};",
     "",
     "/* Current parser state */",
-    "static struct yyparsestate *yyps=0;",
+    "static YYTHREADLOCAL struct yyparsestate *yyps=0;",
     "",
     "/* yypath!=NULL: do the full parse, starting at *yypath parser state. */",
-    "static struct yyparsestate *yypath=0;",
+    "static YYTHREADLOCAL struct yyparsestate *yypath=0;",
     "",
     "/* Base of the lexical value queue */",
-    "static YYSTYPE *yylvals=0;",
+    "static YYTHREADLOCAL YYSTYPE *yylvals=0;",
     "",
     "/* Current posistion at lexical value queue */",
-    "static YYSTYPE *yylvp=0;",
+    "static YYTHREADLOCAL YYSTYPE *yylvp=0;",
     "",
     "/* End position of lexical value queue */",
-    "static YYSTYPE *yylve=0;",
+    "static YYTHREADLOCAL YYSTYPE *yylve=0;",
     "",
     "/* The last allocated position at the lexical value queue */",
-    "static YYSTYPE *yylvlim=0;",
+    "static YYTHREADLOCAL YYSTYPE *yylvlim=0;",
     "",
     "#ifdef YYPOSN",
     "/* Base of the lexical position queue */",
-    "static YYPOSN *yylpsns=0;",
+    "static YYTHREADLOCAL YYPOSN *yylpsns=0;",
     "",
     "/* Current posistion at lexical position queue */",
-    "static YYPOSN *yylpp=0;",
+    "static YYTHREADLOCAL YYPOSN *yylpp=0;",
     "",
     "/* End position of lexical position queue */",
-    "static YYPOSN *yylpe=0;",
+    "static YYTHREADLOCAL YYPOSN *yylpe=0;",
     "",
     "/* The last allocated position at the lexical position queue */",
-    "static YYPOSN *yylplim=0;",
+    "static YYTHREADLOCAL YYPOSN *yylplim=0;",
     "#endif /* YYPOSN */",
     "",
     "/* Current position at lexical token queue */",
-    "static Yshort *yylexp=0;",
+    "static YYTHREADLOCAL Yshort *yylexp=0;",
     "",
-    "static Yshort *yylexemes=0;",
+    "static YYTHREADLOCAL Yshort *yylexemes=0;",
     "",
     "/*",
     "** For use in generated program",
@@ -372,7 +378,7 @@ static char *header[] =
 
 static char *body[] =
 {
-    "#line 354 \"btyaccpa.ske\"",
+    "#line 360 \"btyaccpa.ske\"",
     "",
     "/*",
     "** Parser function",
@@ -380,6 +386,9 @@ static char *body[] =
     "int yyparse() {",
     "  int yym, yyn, yystate, yychar, yynewerrflag;",
     "  struct yyparsestate *yyerrctx = NULL;",
+    "  /* Values at and above this depth of the value stack were produced by a */",
+    "  /* failed trial parse and so they are not real, -1 when all values are. */",
+    "  int yyjunkdepth = -1;",
     "#ifdef YYREDUCEPOSNFUNC",
     "  int reduce_posn;",
     "#endif /* YYREDUCEPOSNFUNC */",
@@ -686,6 +695,8 @@ static char *body[] =
     "\t       yytrial!=0);",
     "      }",
     "#endif",
+    "      /* Only values below the outermost trial are real */",
+    "      yyjunkdepth = (int)(yyps->vsp - yyps->vs) + 1;",
     "      /* Restore state as it was in the most forward-advanced error */",
     "      yylexp = yylexemes + yyerrctx->lexeme;",
     "      yychar = yylexp[-1];",
@@ -739,12 +750,15 @@ static char *body[] =
     "        if (yyps->ssp <= yyps->ss) {",
     "\t  goto yyabort;",
     "\t}",
-    "\tif(!yytrial) {",
+    "\tif (yyjunkdepth >= 0 && yyps->vsp - yyps->vs < yyjunkdepth) {",
+    "\t  yyjunkdepth = -1;",
+    "\t}",
+    "\tif(!yytrial && yyjunkdepth < 0) {",
     "\t  YYDELETEVAL(yyps->vsp[0],1);",
     "\t  YYDELETEPOSN(yyps->psp[0],1);",
     "\t}",
     "#ifdef YYDESTRUCT",
-    "\tYYDESTRUCT(yytrial!=0, yyastable[yyps->ssp[0]], yyps->vsp, yyps->psp);",
+    "\tYYDESTRUCT(yytrial!=0 || yyjunkdepth >= 0, yyastable[yyps->ssp[0]], yyps->vsp, yyps->psp);",
     "#endif /* YYDESTRUCT */",
     "        --(yyps->ssp);",
     "        --(yyps->vsp);",
@@ -770,7 +784,7 @@ static char *body[] =
     "    }",
     "#ifdef YYDESTRUCT",
     "    if (yychar > 0)",
-    "      YYDESTRUCT(yytrial!=0, yyastable[yyttable[yychar]], &yylval, &yyposn);",
+    "      YYDESTRUCT(yytrial!=0, yyttable[yychar], &yylval, &yyposn);",
     "#endif /* YYDESTRUCT */",
     "    yychar = (-1);",
     "    goto yyloop;",
@@ -825,7 +839,7 @@ static char *body[] =
 
 static char *trailer[] =
 {
-    "#line 802 \"btyaccpa.ske\"",
+    "#line 816 \"btyaccpa.ske\"",
     "",
     "  default:",
     "    break;",
@@ -962,15 +976,20 @@ static char *trailer[] =
     "#ifdef YYDESTRUCT",
     "    Yshort *ps = yyps->ss;",
     "#endif",
-    "    for(pv=yyps->vs; pv<yyps->vsp; pv++) {",
-    "      YYDELETEVAL(*pv,2);",
+    "    for(pv=yyps->vs; pv<=yyps->vsp; pv++) {",
+    "      int yyjunk = yyjunkdepth >= 0 && pv - yyps->vs >= yyjunkdepth;",
+    "      if (!yyjunk) {",
+    "        YYDELETEVAL(*pv,2);",
+    "      }",
     "#if defined(YYDESTRUCT)",
-    "      YYDESTRUCT(yytrial!=0, yyastable[*ps++], pv, pp++);",
+    "      YYDESTRUCT(yytrial!=0 || yyjunk, yyastable[*ps++], pv, pp++);",
     "#endif /* YYDESTRUCT */",
     "    }",
     "#ifdef YYPOSN",
-    "    for(pp=yyps->ps; pp<yyps->psp; pp++) {",
-    "      YYDELETEPOSN(*pp,2);",
+    "    for(pp=yyps->ps; pp<=yyps->psp; pp++) {",
+    "      if (yyjunkdepth < 0 || pp - yyps->ps < yyjunkdepth) {",
+    "        YYDELETEPOSN(*pp,2);",
+    "      }",
     "    }",
     "#endif /* YYPOSN */",
     "  }",
@@ -0,0 +1,118 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#ifndef EF0424BF_E970_4561_AF38_1A7118C74F93
+#define EF0424BF_E970_4561_AF38_1A7118C74F93
+
+#include <cstddef>
+#include <ostream>
+#include <streambuf>
+#include <string>
+#include <string_view>
+
+namespace cppcodegen {
+
+/**
+ * @brief Stream buffer that collects emitted code in a growable buffer, or writes it to a file descriptor in large
+ * chunks.
+ *
+ * Every write is just a copy into the buffer, there is no conversion and no synchronization.
+ */
+class CppCodeBuffer : public std::streambuf
+{
+public:
+  /**
+   * @brief Collects code in memory, see view().
+   */
+  CppCodeBuffer();
+  /**
+   * @brief Writes code to @a fd, which is not closed by the buffer.
+   */
+  explicit CppCodeBuffer(int fd);
+  ~CppCodeBuffer() override;
+
+  CppCodeBuffer(const CppCodeBuffer&)            = delete;
+  CppCodeBuffer& operator=(const CppCodeBuffer&) = delete;
+
+public:
+  /**
+   * @return Code collected so far, it is always empty when code is written to a file descriptor.
+   */
+  std::string_view view() const;
+  /**
+   * @return Number of bytes written so far, including the ones already written to file descriptor.
+   */
+  std::size_t size() const;
+  /**
+   * @brief Discards code collected in memory so far but keeps the memory for reuse.
+   */
+  void reset();
+
+protected:
+  int_type        overflow(int_type ch) override;
+  std::streamsize xsputn(const char* str, std::streamsize len) override;
+  int             sync() override;
+
+private:
+  std::size_t pending() const
+  {
+    return static_cast<std::size_t>(pptr() - pbase());
+  }
+
+  void advance(std::size_t len);
+  bool makeRoom(std::size_t len);
+  bool flush();
+
+private:
+  std::string buffer_;
+  std::size_t flushedSize_ {0};
+  int         fd_ {-1};
+};
+
+/**
+ * @brief Output stream that CppWriter emits code to much faster than to std::ostringstream or std::ofstream.
+ *
+ * Emitted code is same as that emitted to any other std::ostream.
+ * It is never tied to another stream and uses classic locale, so, writes do not pay for either.
+ */
+class CppCodeStream : public std::ostream
+{
+public:
+  /**
+   * @brief Collects emitted code in memory, see view().
+   */
+  CppCodeStream();
+  /**
+   * @brief Writes emitted code to @a fd, which is not closed by the stream.
+   * @note Code is written in large chunks, use flush() to write the rest before using @a fd otherwise.
+   */
+  explicit CppCodeStream(int fd);
+
+public:
+  std::string_view view() const
+  {
+    return buffer_.view();
+  }
+
+  std::string str() const
+  {
+    return std::string(view());
+  }
+
+  std::size_t size() const
+  {
+    return buffer_.size();
+  }
+
+  void reset()
+  {
+    buffer_.reset();
+  }
+
+private:
+  CppCodeBuffer buffer_;
+};
+
+} // namespace cppcodegen
+
+#endif /* EF0424BF_E970_4561_AF38_1A7118C74F93 */
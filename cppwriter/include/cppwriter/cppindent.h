@@ -4,8 +4,11 @@
 #ifndef B9B4B822_F222_4FB9_98EC_C3C7C3B922EA
 #define B9B4B822_F222_4FB9_98EC_C3C7C3B922EA
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <ostream>
+#include <string>
 
 namespace cppcodegen {
 
@@ -73,19 +76,14 @@ public:
   std::string toString() const
   {
     std::string ret;
-    for (std::uint16_t i = 0; i < initialLevel_ + indentLevel_; ++i)
-    {
-      ret += indentStr();
-    }
+    ret.reserve(std::size_t(depth()) * unitSize());
+    forEachChunk([&ret](const char* chunk, std::size_t len) { ret.append(chunk, len); });
 
     return ret;
   }
   void emit(std::ostream& stm) const
   {
-    for (std::uint16_t i = 0; i < initialLevel_ + indentLevel_; ++i)
-    {
-      stm << indentStr();
-    }
+    forEachChunk([&stm](const char* chunk, std::size_t len) { stm.write(chunk, static_cast<std::streamsize>(len)); });
   }
 
   CppIndent resetted() const
@@ -94,6 +92,28 @@ public:
 
     return newIndent;
   }
+
+private:
+  std::size_t unitSize() const
+  {
+    return (type_ == kTab) ? 1 : static_cast<std::size_t>(type_);
+  }
+
+  // Whole indentation is written using as few chunks of precomputed indentation as possible, mostly just one.
+  template <typename WriteChunk>
+  void forEachChunk(WriteChunk writeChunk) const
+  {
+    static const std::string tabs(64, '\t');
+    static const std::string spaces(256, ' ');
+
+    const auto& units = (type_ == kTab) ? tabs : spaces;
+    for (auto remaining = std::size_t(depth()) * unitSize(); remaining > 0;)
+    {
+      const auto len = std::min(remaining, units.size());
+      writeChunk(units.data(), len);
+      remaining -= len;
+    }
+  }
 };
 
 } // namespace cppcodegen
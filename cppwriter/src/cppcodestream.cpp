@@ -0,0 +1,175 @@
+// Copyright (C) 2022 Satya Das and CppParser contributors
+// SPDX-License-Identifier: MIT
+
+#include "cppwriter/cppcodestream.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <locale>
+
+#if defined(_WIN32)
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
+namespace cppcodegen {
+
+namespace {
+
+// Most of the emitted files are smaller than this, so, collecting one rarely needs to grow the buffer.
+constexpr std::size_t kInitialBufferSize = 64 * 1024;
+// Code written to a file descriptor is written in chunks of this size.
+constexpr std::size_t kFileChunkSize = 64 * 1024;
+
+bool WriteAll(int fd, const char* data, std::size_t len)
+{
+  while (len > 0)
+  {
+#if defined(_WIN32)
+    const auto written = _write(fd, data, static_cast<unsigned int>(std::min<std::size_t>(len, INT_MAX)));
+#else
+    const auto written = ::write(fd, data, len);
+#endif
+    if (written < 0)
+    {
+      if (errno == EINTR)
+        continue;
+      return false;
+    }
+    data += written;
+    len -= static_cast<std::size_t>(written);
+  }
+  return true;
+}
+
+} // namespace
+
+CppCodeBuffer::CppCodeBuffer()
+{
+  setp(nullptr, nullptr);
+}
+
+CppCodeBuffer::CppCodeBuffer(int fd)
+  : buffer_(kFileChunkSize, '\0')
+  , fd_(fd)
+{
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+}
+
+CppCodeBuffer::~CppCodeBuffer()
+{
+  flush();
+}
+
+std::string_view CppCodeBuffer::view() const
+{
+  if (fd_ >= 0)
+    return std::string_view();
+  return std::string_view(buffer_.data(), pending());
+}
+
+std::size_t CppCodeBuffer::size() const
+{
+  return flushedSize_ + pending();
+}
+
+void CppCodeBuffer::reset()
+{
+  // Code written to a file descriptor cannot be taken back.
+  if (fd_ >= 0)
+    return;
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+}
+
+CppCodeBuffer::int_type CppCodeBuffer::overflow(int_type ch)
+{
+  if (traits_type::eq_int_type(ch, traits_type::eof()))
+    return traits_type::not_eof(ch);
+  if (!makeRoom(1))
+    return traits_type::eof();
+  *pptr() = traits_type::to_char_type(ch);
+  advance(1);
+  return ch;
+}
+
+std::streamsize CppCodeBuffer::xsputn(const char* str, std::streamsize len)
+{
+  const auto size = static_cast<std::size_t>(len);
+  if (size > static_cast<std::size_t>(epptr() - pptr()))
+  {
+    if (!makeRoom(size))
+      return 0;
+    // Writing a chunk bigger than the buffer through the buffer would only add a copy.
+    if ((fd_ >= 0) && (size >= buffer_.size()))
+    {
+      if (!WriteAll(fd_, str, size))
+        return 0;
+      flushedSize_ += size;
+      return len;
+    }
+  }
+  std::memcpy(pptr(), str, size);
+  advance(size);
+  return len;
+}
+
+int CppCodeBuffer::sync()
+{
+  return flush() ? 0 : -1;
+}
+
+void CppCodeBuffer::advance(std::size_t len)
+{
+  // pbump() can only advance by an int at a time.
+  for (; len > INT_MAX; len -= INT_MAX)
+    pbump(INT_MAX);
+  pbump(static_cast<int>(len));
+}
+
+bool CppCodeBuffer::makeRoom(std::size_t len)
+{
+  if (fd_ >= 0)
+    return flush();
+
+  const auto used = pending();
+  if (len <= buffer_.size() - used)
+    return true;
+  buffer_.resize(std::max({buffer_.size() * 2, used + len, kInitialBufferSize}));
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+  advance(used);
+
+  return true;
+}
+
+bool CppCodeBuffer::flush()
+{
+  if ((fd_ < 0) || (pending() == 0))
+    return true;
+
+  const auto len = pending();
+  const auto ret = WriteAll(fd_, pbase(), len);
+  flushedSize_ += len;
+  setp(buffer_.data(), buffer_.data() + buffer_.size());
+
+  return ret;
+}
+
+CppCodeStream::CppCodeStream()
+  : std::ostream(nullptr)
+{
+  imbue(std::locale::classic());
+  rdbuf(&buffer_);
+}
+
+CppCodeStream::CppCodeStream(int fd)
+  : std::ostream(nullptr)
+  , buffer_(fd)
+{
+  imbue(std::locale::classic());
+  rdbuf(&buffer_);
+}
+
+} // namespace cppcodegen
@@ -175,15 +175,16 @@ void CppWriter::emitPreprocessor(const cppast::CppPreprocessor& preprocessorObj,
 void CppWriter::emitDefine(const cppast::CppPreprocessorDefine& defObj, std::ostream& stm) const
 {
   stm << '#' << preproIndent_ << "define " << defObj.name();
-  if (!defObj.definition().empty())
+  const auto definition = defObj.definitionView();
+  if (!definition.empty())
   {
     const auto firstNonSpaceCharPos =
-      std::find_if(defObj.definition().begin(), defObj.definition().end(), [](char c) { return !std::isspace(c); });
-    if (firstNonSpaceCharPos != defObj.definition().end())
+      std::find_if(definition.begin(), definition.end(), [](char c) { return !std::isspace(c); });
+    if (firstNonSpaceCharPos != definition.end())
     {
       if (*firstNonSpaceCharPos != '(')
         stm << '\t';
-      stm << defObj.definition();
+      stm << definition;
     }
   }
   stm << '\n';
@@ -290,7 +291,7 @@ void CppWriter::emitBlob(const cppast::CppBlob& blobObj,
   // }
   // else
   {
-    stm << blobObj.blob();
+    stm << blobObj.blobView();
   }
 }
 
@@ -736,7 +737,7 @@ void CppWriter::emitFunctionOrFuncPtrCommon(const cppast::CppFunctionOrFuncPtrCo
     stm << " . ";
     emitVarType(*funcObj.returnType(), stm);
   }
-  if (!skipParamName && funcObj.defn() && (getEmittingType() != kHeader))
+  if (!skipParamName && funcObj.hasDefn() && (getEmittingType() != kHeader))
   {
     // const auto defn = funcObj.defn();
     // if (defn->hasASingleBlobMember())
@@ -814,7 +815,7 @@ void CppWriter::emitConstructor(const cppast::CppConstructor& ctorObj,
     }
     --indentation;
   }
-  if (!skipParamName && ctorObj.defn())
+  if (!skipParamName && ctorObj.hasDefn())
   {
     stm << '\n' << indentation++ << "{\n";
     emitCompound(*ctorObj.defn(), stm, indentation);
@@ -848,7 +849,7 @@ void CppWriter::emitDestructor(const cppast::CppDestructor& dtorObj, std::ostrea
     stm << "virtual ";
   stm << dtorObj.name() << "()";
 
-  if (dtorObj.defn())
+  if (dtorObj.hasDefn())
   {
     stm << '\n' << indentation++ << "{\n";
     emitCompound(*dtorObj.defn(), stm, indentation);
@@ -873,7 +874,7 @@ void CppWriter::emitTypeConverter(const cppast::CppTypeConverter& typeConverterO
     stm << " const";
   if (typeConverterObj.attr() & cppast::CppIdentifierAttrib::CONST_EXPR)
     stm << " constexpr";
-  if (typeConverterObj.defn())
+  if (typeConverterObj.hasDefn())
   {
     stm << '\n';
     stm << indentation << "{\n";
@@ -892,7 +893,7 @@ void CppWriter::emitDocComment(const cppast::CppDocumentationComment& docComment
                                std::ostream&                          stm,
                                CppIndent                              indentation) const
 {
-  stm << docCommentObj.str() << '\n';
+  stm << docCommentObj.strView() << '\n';
 }
 
 void CppWriter::emitIfBlock(const cppast::CppIfBlock& ifBlock, std::ostream& stm, CppIndent indentation) const